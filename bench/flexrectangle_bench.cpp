@@ -0,0 +1,374 @@
+#include "flexrectangle.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <qguiapplication.h>
+#include <qsggeometry.h>
+#include <qvariant.h>
+#include <vector>
+
+// ####################### Allocation counter #######################
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+void* countedAlloc(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t /*unused*/) noexcept {
+  std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t /*unused*/) noexcept {
+  std::free(ptr);
+}
+
+namespace UI {
+
+/**
+ * @class FlexRectangleBenchmark
+ * @brief Golden-vertex checks and timing sweep for FlexRectangle.
+ *
+ * Friend of FlexRectangle so the private geometry helpers can be driven
+ * directly, without a window or a running scene graph.
+ */
+class FlexRectangleBenchmark {
+public:
+  using Point2D = QSGGeometry::Point2D;
+  using CornerRadii = FlexRectangle::CornerRadii;
+
+  struct Golden {
+    float width;
+    float height;
+    uint32_t segments;
+    CornerRadii radii;
+    std::vector<Point2D> vertices;
+  };
+
+  struct Result {
+    size_t vertices;
+    double nsPerCall;
+    double allocsPerCall;
+  };
+
+  static int runGoldens();
+  static void runSweep(uint32_t iterations);
+
+private:
+  static bool checkRadii(const char* name, const CornerRadii& actual,
+                         const CornerRadii& expected);
+  static bool checkGeometry(const Golden& golden);
+
+  static Result measureGenerateGeometry(FlexRectangle& rect,
+                                        const CornerRadii& radii,
+                                        uint32_t iterations);
+  static Result measureUpdatePaintNode(FlexRectangle& rect,
+                                       uint32_t iterations);
+  static Result measureFromQVariantList(const QVariantList& list,
+                                        uint32_t iterations);
+};
+
+namespace {
+
+constexpr float kTolerance = 1e-3F;
+
+bool nearlyEqual(float lhs, float rhs) {
+  return std::fabs(lhs - rhs) <= kTolerance;
+}
+
+template <typename Func>
+FlexRectangleBenchmark::Result measure(uint32_t iterations, Func&& func) {
+  using Clock = std::chrono::steady_clock;
+
+  size_t vertices = 0;
+  const uint64_t allocsBefore = g_allocations.load(std::memory_order_relaxed);
+  const auto start = Clock::now();
+
+  for (uint32_t i = 0; i < iterations; i++) {
+    vertices = func();
+  }
+
+  const auto elapsed = Clock::now() - start;
+  const uint64_t allocsAfter = g_allocations.load(std::memory_order_relaxed);
+
+  const auto nanoseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+  return {
+      .vertices = vertices,
+      .nsPerCall = static_cast<double>(nanoseconds) / iterations,
+      .allocsPerCall =
+          static_cast<double>(allocsAfter - allocsBefore) / iterations,
+  };
+}
+
+void printResult(const char* path, float width, float height, float radius,
+                 uint32_t segments,
+                 const FlexRectangleBenchmark::Result& result) {
+  std::printf("%-22s %7.0fx%-5.0f %6.1f %4u | %6zu %12.1f %8.2f\n", path,
+              width, height, radius, segments, result.vertices,
+              result.nsPerCall, result.allocsPerCall);
+}
+
+} // namespace
+
+bool FlexRectangleBenchmark::checkRadii(const char* name,
+                                        const CornerRadii& actual,
+                                        const CornerRadii& expected) {
+  const bool ok = nearlyEqual(actual.topLeft, expected.topLeft) &&
+                  nearlyEqual(actual.topRight, expected.topRight) &&
+                  nearlyEqual(actual.bottomRight, expected.bottomRight) &&
+                  nearlyEqual(actual.bottomLeft, expected.bottomLeft);
+  if (!ok) {
+    std::printf("FAIL %s: got [%g, %g, %g, %g] expected [%g, %g, %g, %g]\n",
+                name, actual.topLeft, actual.topRight, actual.bottomRight,
+                actual.bottomLeft, expected.topLeft, expected.topRight,
+                expected.bottomRight, expected.bottomLeft);
+  }
+  return ok;
+}
+
+bool FlexRectangleBenchmark::checkGeometry(const Golden& golden) {
+  FlexRectangle rect;
+  rect.setSize(QSizeF(golden.width, golden.height));
+  rect.setSegments(golden.segments);
+
+  CornerRadii radii = golden.radii;
+  radii.clampRadius(golden.width, golden.height);
+
+  QSGGeometry* geometry = rect.generateGeometry(radii);
+  const auto count = static_cast<size_t>(geometry->vertexCount());
+  const Point2D* vertices = geometry->vertexDataAsPoint2D();
+
+  bool ok = count == golden.vertices.size();
+  for (size_t i = 0; ok && i < count; i++) {
+    ok = nearlyEqual(vertices[i].x, golden.vertices[i].x) &&
+         nearlyEqual(vertices[i].y, golden.vertices[i].y);
+    if (!ok) {
+      std::printf("FAIL geometry %gx%g: vertex %zu is (%g, %g), expected "
+                  "(%g, %g)\n",
+                  golden.width, golden.height, i, vertices[i].x, vertices[i].y,
+                  golden.vertices[i].x, golden.vertices[i].y);
+    }
+  }
+
+  if (count != golden.vertices.size()) {
+    std::printf("FAIL geometry %gx%g: %zu vertices, expected %zu\n",
+                golden.width, golden.height, count, golden.vertices.size());
+  }
+
+  if (geometry->drawingMode() != QSGGeometry::DrawTriangleStrip) {
+    std::printf("FAIL geometry %gx%g: drawing mode is not a triangle strip\n",
+                golden.width, golden.height);
+    ok = false;
+  }
+
+  delete geometry;
+  return ok;
+}
+
+/**
+ * @brief Checks the geometry helpers against hand-verified output.
+ *
+ * The expected vertices were produced from the triangle-strip construction
+ * documented on FlexRectangle::generateGeometry. Any optimization of the
+ * geometry path must keep these passing.
+ *
+ * @return The number of failed checks.
+ */
+int FlexRectangleBenchmark::runGoldens() {
+  int failures = 0;
+
+  CornerRadii radii{};
+
+  radii.fromQVariantList({});
+  failures += checkRadii("fromQVariantList([])", radii, {0, 0, 0, 0}) ? 0 : 1;
+
+  radii.fromQVariantList({4});
+  failures += checkRadii("fromQVariantList([4])", radii, {4, 0, 0, 0}) ? 0 : 1;
+
+  radii.fromQVariantList({"x", 2});
+  failures +=
+      checkRadii("fromQVariantList([x, 2])", radii, {0, 2, 0, 0}) ? 0 : 1;
+
+  radii.fromQVariantList({1, 2, 3});
+  failures +=
+      checkRadii("fromQVariantList([1, 2, 3])", radii, {1, 2, 3, 0}) ? 0 : 1;
+
+  radii.fromQVariantList({1, 2, 3, 4, 5});
+  failures += checkRadii("fromQVariantList([1, 2, 3, 4, 5])", radii,
+                         {1, 2, 3, 4})
+                  ? 0
+                  : 1;
+
+  radii = {10, -1, 1, 2};
+  radii.clampRadius(10, 4);
+  failures += checkRadii("clampRadius(10, 4)", radii, {2, 0, 1, 2}) ? 0 : 1;
+
+  const std::array<Golden, 2> goldens = {{
+      {10,
+       6,
+       2,
+       {2, 0, 3, 1},
+       {{5.0000F, 3.0000F},  {0.0000F, 2.0000F},  {5.0000F, 3.0000F},
+        {0.5858F, 0.5858F},  {5.0000F, 3.0000F},  {2.0000F, 0.0000F},
+        {5.0000F, 3.0000F},  {10.0000F, 0.0000F}, {5.0000F, 3.0000F},
+        {10.0000F, 0.0000F}, {5.0000F, 3.0000F},  {10.0000F, 3.0000F},
+        {5.0000F, 3.0000F},  {9.1213F, 5.1213F},  {5.0000F, 3.0000F},
+        {7.0000F, 6.0000F},  {5.0000F, 3.0000F},  {1.0000F, 6.0000F},
+        {5.0000F, 3.0000F},  {0.2929F, 5.7071F},  {5.0000F, 3.0000F},
+        {0.0000F, 5.0000F},  {0.0000F, 2.0000F}}},
+      {35,
+       35,
+       1,
+       {8, 0, 0, 0},
+       {{17.5000F, 17.5000F},
+        {0.0000F, 8.0000F},
+        {17.5000F, 17.5000F},
+        {8.0000F, 0.0000F},
+        {17.5000F, 17.5000F},
+        {35.0000F, 0.0000F},
+        {17.5000F, 17.5000F},
+        {35.0000F, 0.0000F},
+        {17.5000F, 17.5000F},
+        {35.0000F, 35.0000F},
+        {17.5000F, 17.5000F},
+        {35.0000F, 35.0000F},
+        {17.5000F, 17.5000F},
+        {0.0000F, 35.0000F},
+        {17.5000F, 17.5000F},
+        {0.0000F, 35.0000F},
+        {0.0000F, 8.0000F}}},
+  }};
+
+  for (const auto& golden : goldens) {
+    failures += checkGeometry(golden) ? 0 : 1;
+  }
+
+  return failures;
+}
+
+FlexRectangleBenchmark::Result
+FlexRectangleBenchmark::measureGenerateGeometry(FlexRectangle& rect,
+                                                const CornerRadii& radii,
+                                                uint32_t iterations) {
+  return measure(iterations, [&rect, &radii]() -> size_t {
+    QSGGeometry* geometry = rect.generateGeometry(radii);
+    const auto count = static_cast<size_t>(geometry->vertexCount());
+    delete geometry;
+    return count;
+  });
+}
+
+FlexRectangleBenchmark::Result
+FlexRectangleBenchmark::measureUpdatePaintNode(FlexRectangle& rect,
+                                               uint32_t iterations) {
+  QSGNode* node = rect.updatePaintNode(nullptr, nullptr);
+
+  const auto result = measure(iterations, [&rect, &node]() -> size_t {
+    rect.m_geometryDirty = true;
+    node = rect.updatePaintNode(node, nullptr);
+    return static_cast<size_t>(
+        static_cast<QSGGeometryNode*>(node)->geometry()->vertexCount());
+  });
+
+  delete node;
+  return result;
+}
+
+FlexRectangleBenchmark::Result
+FlexRectangleBenchmark::measureFromQVariantList(const QVariantList& list,
+                                                uint32_t iterations) {
+  return measure(iterations, [&list]() -> size_t {
+    CornerRadii radii{};
+    radii.fromQVariantList(list);
+    radii.clampRadius(35, 35);
+    return radii.topLeft > 0 ? 1 : 0;
+  });
+}
+
+/**
+ * @brief Times every geometry path over a sweep of sizes, radii and segments.
+ *
+ * The sizes cover the icon box (35x35), a content box and the full bar strip.
+ */
+void FlexRectangleBenchmark::runSweep(uint32_t iterations) {
+  constexpr std::array<QSizeF, 3> sizes = {
+      {{35, 35}, {240, 35}, {3440, 45}}};
+  constexpr std::array<float, 4> radiusSweep = {0, 4, 8, 32};
+  constexpr std::array<uint32_t, 4> segmentSweep = {1, 4, 8, 32};
+
+  std::printf("%-22s %13s %6s %4s | %6s %12s %8s\n", "path", "size", "radius",
+              "seg", "verts", "ns/call", "allocs");
+
+  for (const auto& size : sizes) {
+    for (const float radius : radiusSweep) {
+      for (const uint32_t segments : segmentSweep) {
+        FlexRectangle rect;
+        rect.setSize(size);
+        rect.setSegments(segments);
+        rect.setRadius({radius, radius, radius, radius});
+
+        CornerRadii radii{};
+        radii.fromQVariantList(rect.radius());
+        radii.clampRadius(size.width(), size.height());
+
+        const auto width = static_cast<float>(size.width());
+        const auto height = static_cast<float>(size.height());
+
+        printResult("generateGeometry", width, height, radius, segments,
+                    measureGenerateGeometry(rect, radii, iterations));
+        printResult("updatePaintNode", width, height, radius, segments,
+                    measureUpdatePaintNode(rect, iterations));
+      }
+    }
+  }
+
+  const QVariantList list = {8, 0, 0, 8};
+  printResult("fromQVariantList+clamp", 35, 35, 8, 0,
+              measureFromQVariantList(list, iterations));
+}
+
+} // namespace UI
+
+int main(int argc, char* argv[]) {
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+
+  QGuiApplication app(argc, argv);
+
+  uint32_t iterations = 2000;
+  if (argc > 1) {
+    iterations = qMax(1U, static_cast<uint32_t>(std::strtoul(argv[1], nullptr,
+                                                             10)));
+  }
+
+  const int failures = UI::FlexRectangleBenchmark::runGoldens();
+  if (failures != 0) {
+    std::printf("%d golden check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  std::printf("Golden checks passed\n\n");
+
+  UI::FlexRectangleBenchmark::runSweep(iterations);
+
+  return EXIT_SUCCESS;
+}
@@ -1,33 +1,94 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <qbytearray.h>
+#include <qbytearrayview.h>
 #include <qcolor.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qpair.h>
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qqmlengine.h>
 #include <qqmlintegration.h>
+#include <qstring.h>
+#include <qstringlist.h>
 #include <qtmetamacros.h>
+#include <qvariant.h>
 
 #include "theme.h"
+#include "themes.h"
 
-#define DEFINE_CONST_PROPERTY(Type, name, value)                               \
-  Q_PROPERTY(Type name READ name CONSTANT)                                     \
+// A setting read from the config file, falling back to value. The member
+// initializer registers the setter under its key, so adding a setting is one
+// line here and nothing else.
+#define DEFINE_PROPERTY(Type, name, value)                                     \
+  Q_PROPERTY(Type name READ name NOTIFY name##Changed)                         \
 public:                                                                        \
-  [[nodiscard]] Type name() const { return value; }
+  [[nodiscard]] Type name() const { return m_##name; }                         \
+  Q_SIGNAL void name##Changed();                                               \
+                                                                               \
+private:                                                                       \
+  Type m_##name = value;                                                       \
+  const bool m_##name##Registered = registerSetting(                           \
+      #name,                                                                   \
+      [this](const std::optional<QByteArrayView>& text) {                      \
+        return assign(m_##name, text, Type(value), &Config::name##Changed);    \
+      },                                                                       \
+      [this]() { return QVariant::fromValue(m_##name); });                     \
+                                                                               \
+public:
 
+// A color of the active theme, notifying only when a theme switch changes it
 #define DEFINE_THEME(name)                                                     \
-  Q_PROPERTY(QColor theme##name READ theme##name NOTIFY themeChanged)          \
+  Q_PROPERTY(QColor theme##name READ theme##name NOTIFY theme##name##Changed)  \
+public:                                                                        \
+  [[nodiscard]] QColor theme##name() const {                                   \
+    return QColor::fromRgba(m_theme.color(ColorRole::name));                   \
+  }                                                                            \
+  Q_SIGNAL void theme##name##Changed();                                        \
+                                                                               \
 private:                                                                       \
-  QColor m_theme##name = Qt::white;                                            \
+  const bool m_theme##name##Registered =                                       \
+      registerColor(ColorRole::name, &Config::theme##name##Changed);           \
                                                                                \
-public:                                                                        \
-  [[nodiscard]] QColor theme##name() const { return m_theme##name; }
+public:
 
 class Config final : public QObject {
   Q_OBJECT
   QML_NAMED_ELEMENT(SimbarConfig)
   QML_SINGLETON
 
+  // Declared before any setting, their initializers register into it
+  using Setter = std::function<bool(const std::optional<QByteArrayView>&)>;
+  using Getter = std::function<QVariant()>;
+  QHash<QByteArray, Setter> m_settings;
+  QHash<QByteArray, Getter> m_getters;
+
+  using ColorSignal = void (Config::*)();
+  std::array<ColorSignal, COLOR_ROLE_COUNT> m_colorSignals{};
+  Theme m_theme = *BUILTIN_THEMES.at(DEFAULT_THEME_INDEX).theme;
+  int m_themeIndex = DEFAULT_THEME_INDEX;
+  QList<QPair<QString, Theme>> m_userThemes;
+
+  Q_PROPERTY(int themeIndex READ themeIndex WRITE setThemeIndex NOTIFY
+                 themeIndexChanged)
+  Q_PROPERTY(QStringList themeNames READ themeNames NOTIFY themeNamesChanged)
+  // Every color of the active theme in ColorRole order, for items that pick
+  // a role at runtime and cannot use the GPU palette
+  Q_PROPERTY(
+      QVariantList themeColors READ themeColors NOTIFY themeColorsChanged)
+
+  // Theme to start with, a built-in flavor or a user theme defined in the
+  // config file as `theme.<name>.<color> = #rrggbb` on top of mocha
+  DEFINE_PROPERTY(QString, themeName, QString("mocha"))
+  // Cross-fade of palette-colored items on theme switches, 0 to disable
+  DEFINE_PROPERTY(int32_t, themeTransition, 400)
+
   // Color config
   DEFINE_THEME(Rosewater)
   DEFINE_THEME(Flamingo)
@@ -58,33 +119,205 @@ class Config final : public QObject {
   DEFINE_THEME(Mantle)
   DEFINE_THEME(Crust)
 
+  // Render config, read once at startup
+  DEFINE_PROPERTY(QString, renderBackend, QString("auto"))
+  DEFINE_PROPERTY(bool, renderLowMemory, false)
+  DEFINE_PROPERTY(int32_t, idleTimeout, 60000)
+  DEFINE_PROPERTY(bool, splitRegions, false)
+  // Show the last frame at startup, saved on quit and every interval ms
+  DEFINE_PROPERTY(bool, snapshotEnabled, true)
+  DEFINE_PROPERTY(int32_t, snapshotInterval, 300000)
+  // Log a memory report every this many ms, 0 for only on SIGUSR1
+  DEFINE_PROPERTY(int32_t, memoryReportInterval, 0)
+
+  // IPC config, relative to $XDG_RUNTIME_DIR
+  DEFINE_PROPERTY(QString, ipcSocketName, QString("simbar.sock"))
+  // auto, i3 (sway or i3), hyprland or none
+  DEFINE_PROPERTY(QString, compositorIpc, QString("auto"))
+  // Event socket to use instead of the discovered one, e.g. a local fake
+  // server replaying recorded events. Speaks hyprland if compositorIpc says
+  // so, i3 otherwise
+  DEFINE_PROPERTY(QString, compositorSocket, QString(""))
+
+  // Power config, read once at startup. An empty uevent socket listens to
+  // the kernel, a path binds a datagram socket there to inject uevents
+  DEFINE_PROPERTY(QString, powerSysfsRoot, QString("/sys"))
+  DEFINE_PROPERTY(QString, powerUeventSocket, QString())
+  // Battery reread for drivers that skip uevents, 0 disables it
+  DEFINE_PROPERTY(int32_t, powerRefreshInterval, 60000)
+
+  // Render policy: auto saves power on battery, on and off force it. While
+  // saving, animations step at powerSaveFps, text scrambles run at
+  // powerSaveScramble percent of their duration (0 skips them) and polling
+  // intervals are multiplied by powerSavePollScale
+  DEFINE_PROPERTY(QString, powerSaveMode, QString("auto"))
+  DEFINE_PROPERTY(int32_t, powerSaveFps, 10)
+  DEFINE_PROPERTY(int32_t, powerSaveScramble, 0)
+  DEFINE_PROPERTY(int32_t, powerSavePollScale, 3)
+
+  // Notification daemon config, read once at startup
+  DEFINE_PROPERTY(bool, notifyServer, false)
+  DEFINE_PROPERTY(int32_t, notifyQueueSize, 32)
+  DEFINE_PROPERTY(int32_t, notifyMaxVisible, 3)
+  // Minimum ms between two toasts appearing
+  DEFINE_PROPERTY(int32_t, notifyMinInterval, 250)
+  DEFINE_PROPERTY(int32_t, notifyTimeout, 5000)
+
   // Size config
-  DEFINE_CONST_PROPERTY(int32_t, renderSample, 8)
+  DEFINE_PROPERTY(int32_t, renderSample, 8)
 
-  DEFINE_CONST_PROPERTY(int32_t, width, 3440)
-  DEFINE_CONST_PROPERTY(int32_t, height, 45)
+  DEFINE_PROPERTY(int32_t, width, 3440)
+  DEFINE_PROPERTY(int32_t, height, 45)
 
-  DEFINE_CONST_PROPERTY(int32_t, qmlWidth, 3440)
-  DEFINE_CONST_PROPERTY(int32_t, qmlHeight, 45)
+  DEFINE_PROPERTY(int32_t, qmlWidth, 3440)
+  DEFINE_PROPERTY(int32_t, qmlHeight, 45)
 
-  DEFINE_CONST_PROPERTY(int32_t, qmlDefaultBoxSize, 35)
-  DEFINE_CONST_PROPERTY(int32_t, qmlDefaultPadding, 8)
-  DEFINE_CONST_PROPERTY(int32_t, qmlDefaultIconSize, 28)
-  DEFINE_CONST_PROPERTY(int32_t, qmlDefaultFontSize, 16)
-  DEFINE_CONST_PROPERTY(QString, qmlDefaultFontFamily,
-                        QString("CodeNewRoman Nerd Font Mono"))
+  DEFINE_PROPERTY(int32_t, qmlDefaultBoxSize, 35)
+  DEFINE_PROPERTY(int32_t, qmlDefaultPadding, 8)
+  DEFINE_PROPERTY(int32_t, qmlDefaultIconSize, 28)
+  DEFINE_PROPERTY(int32_t, qmlDefaultFontSize, 16)
+  DEFINE_PROPERTY(int32_t, qmlTitleMaxWidth, 1200)
+  DEFINE_PROPERTY(int32_t, qmlTrayIconSize, 22)
+  DEFINE_PROPERTY(int32_t, qmlNotifyWidth, 400)
+  DEFINE_PROPERTY(int32_t, qmlNotifyHeight, 80)
+  DEFINE_PROPERTY(QString, qmlDefaultFontFamily,
+                  QString("CodeNewRoman Nerd Font Mono"))
+  // Icons rasterized into the glyph atlas at startup, others on first use
+  DEFINE_PROPERTY(QString, qmlPrebakedIcons, QString("󰂯󰂲󰖩󰖪󰤭󰸗󰍛󰂄󰂎󰁺󰁻󰁼󰁽󰁾󰁿󰂀󰂁󰂂󰁹󰃠󰏤󰐊"))
 
 public:
+  /**
+   * @struct Snapshot
+   * @brief Every setting and the active theme, frozen at one version.
+   *
+   * Immutable once published, so any thread can read it without locking
+   * and always sees the settings of one reload together.
+   */
+  struct Snapshot {
+    /// Incremented with every publish
+    uint64_t version = 0;
+    Theme theme{};
+    int themeIndex = 0;
+    QHash<QByteArray, QVariant> values;
+
+    /// The setting @p key, or @p fallback if there is none of type T
+    template <typename T>
+    [[nodiscard]] T value(const char* key, const T& fallback = T()) const {
+      const QVariant found = values.value(key);
+      return found.canConvert<T>() ? found.value<T>() : fallback;
+    }
+
+    [[nodiscard]] QColor color(ColorRole role) const {
+      return QColor::fromRgba(theme.color(role));
+    }
+  };
+  using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
   static Config& instance();
   static Config* create(QQmlEngine* /*unused*/, QJSEngine* /*unused*/);
 
+  /**
+   * @brief The latest published snapshot, from any thread.
+   *
+   * Keep the pointer for as long as one consistent view is needed, e.g. one
+   * frame, and fetch a new one afterwards. A later publish never changes a
+   * snapshot already handed out. Null until the Config is constructed, and
+   * static so that reading it never constructs one off the GUI thread.
+   */
+  [[nodiscard]] static SnapshotPtr snapshot() {
+    return std::atomic_load(&m_snapshot);
+  }
+
+  /// Switches every color, emitting only the signals of colors that differ
   void loadTheme(const Theme& theme);
 
+  [[nodiscard]] const Theme& theme() const { return m_theme; }
+
+  /// Built-in themes first, then user themes in the order of the config file
+  [[nodiscard]] int themeIndex() const { return m_themeIndex; }
+  void setThemeIndex(int index);
+  [[nodiscard]] QStringList themeNames() const;
+  [[nodiscard]] QVariantList themeColors() const;
+  /// Index of the theme called @p name, -1 if there is none
+  [[nodiscard]] int findTheme(const QString& name) const;
+
+  /**
+   * @brief Applies a `key = value` config file.
+   *
+   * The file is mapped and parsed in place. Keys missing from the file go back
+   * to their default, and only settings whose value actually changed emit
+   * their NOTIFY signal. A missing file resets everything to the defaults.
+   * A theme switched to at runtime stays active unless themeName changed.
+   *
+   * @return The number of settings that changed.
+   */
+  int loadFile(const QString& path);
+
 signals:
-  void themeChanged();
+  /// Any color of the active theme changed, for C++ consumers of theme()
+  void themeColorsChanged();
+  void themeIndexChanged();
+  void themeNamesChanged();
 
 private:
   Config();
+
+  /**
+   * Defers NOTIFY signals while alive. The outermost one publishes a single
+   * snapshot and then emits each deferred signal once, so a slot reading
+   * snapshot() already sees the values it is notified about.
+   */
+  class Batch {
+  public:
+    explicit Batch(Config& config);
+    ~Batch();
+    Q_DISABLE_COPY_MOVE(Batch)
+
+  private:
+    Config& m_config;
+  };
+
+  /// Emits @p notify after publishing, or at the end of the current Batch
+  void notifyChanged(void (Config::*notify)());
+  void publish();
+
+  bool registerSetting(const char* key, Setter setter, Getter getter);
+  bool registerColor(ColorRole role, ColorSignal notify);
+
+  /// Handles `theme.<name>.<color>`, false if @p key is not one
+  static bool parseUserTheme(QByteArrayView key, QByteArrayView value,
+                             QList<QPair<QString, Theme>>& themes);
+  static bool parseColor(QByteArrayView text, QRgb& color);
+
+  /// Parses @p text (or takes @p fallback if there is none) into @p member
+  template <typename T>
+  bool assign(T& member, const std::optional<QByteArrayView>& text,
+              const T& fallback, void (Config::*notify)()) {
+    T value = fallback;
+    if (text.has_value() && !parseValue(*text, value)) {
+      warnInvalid(*text);
+      value = fallback;
+    }
+
+    if (member == value) {
+      return false;
+    }
+
+    member = value;
+    notifyChanged(notify);
+    return true;
+  }
+
+  static bool parseValue(QByteArrayView text, int32_t& value);
+  static bool parseValue(QByteArrayView text, bool& value);
+  static bool parseValue(QByteArrayView text, QString& value);
+  static void warnInvalid(QByteArrayView text);
+
+  // Written by the GUI thread only, read from any through std::atomic_load
+  static inline SnapshotPtr m_snapshot;
+  uint64_t m_version = 0;
+  int m_batchDepth = 0;
+  QList<void (Config::*)()> m_deferred;
 };
 
 #define CONFIG Config::instance()
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "theme.h"
+
+inline constexpr Theme CATPUCCIN_FRAPPE = {
+    .rosewater = rgb(0xf2d5cf),
+    .flamingo = rgb(0xeebebe),
+    .pink = rgb(0xf4b8e4),
+    .mauve = rgb(0xca9ee6),
+    .red = rgb(0xe78284),
+    .maroon = rgb(0xea999c),
+    .peach = rgb(0xef9f76),
+    .yellow = rgb(0xe5c890),
+    .green = rgb(0xa6d189),
+    .teal = rgb(0x81c8be),
+    .sky = rgb(0x99d1db),
+    .sapphire = rgb(0x85c1dc),
+    .blue = rgb(0x8caaee),
+    .lavender = rgb(0xbabbf1),
+
+    .text = rgb(0xc6d0f5),
+    .subtext1 = rgb(0xb5bfe2),
+    .subtext0 = rgb(0xa5adce),
+    .overlay2 = rgb(0x949cbb),
+    .overlay1 = rgb(0x838ba7),
+    .overlay0 = rgb(0x737994),
+    .surface2 = rgb(0x626880),
+    .surface1 = rgb(0x51576d),
+    .surface0 = rgb(0x414559),
+
+    .base = rgb(0x303446),
+    .mantle = rgb(0x292c3c),
+    .crust = rgb(0x232634),
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "theme.h"
+
+inline constexpr Theme CATPUCCIN_LATTE = {
+    .rosewater = rgb(0xdc8a78),
+    .flamingo = rgb(0xdd7878),
+    .pink = rgb(0xea76cb),
+    .mauve = rgb(0x8839ef),
+    .red = rgb(0xd20f39),
+    .maroon = rgb(0xe64553),
+    .peach = rgb(0xfe640b),
+    .yellow = rgb(0xdf8e1d),
+    .green = rgb(0x40a02b),
+    .teal = rgb(0x179299),
+    .sky = rgb(0x04a5e5),
+    .sapphire = rgb(0x209fb5),
+    .blue = rgb(0x1e66f5),
+    .lavender = rgb(0x7287fd),
+
+    .text = rgb(0x4c4f69),
+    .subtext1 = rgb(0x5c5f77),
+    .subtext0 = rgb(0x6c6f85),
+    .overlay2 = rgb(0x7c7f93),
+    .overlay1 = rgb(0x8c8fa1),
+    .overlay0 = rgb(0x9ca0b0),
+    .surface2 = rgb(0xacb0be),
+    .surface1 = rgb(0xbcc0cc),
+    .surface0 = rgb(0xccd0da),
+
+    .base = rgb(0xeff1f5),
+    .mantle = rgb(0xe6e9ef),
+    .crust = rgb(0xdce0e8),
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "theme.h"
+
+inline constexpr Theme CATPUCCIN_MACCHIATO = {
+    .rosewater = rgb(0xf4dbd6),
+    .flamingo = rgb(0xf0c6c6),
+    .pink = rgb(0xf5bde6),
+    .mauve = rgb(0xc6a0f6),
+    .red = rgb(0xed8796),
+    .maroon = rgb(0xee99a0),
+    .peach = rgb(0xf5a97f),
+    .yellow = rgb(0xeed49f),
+    .green = rgb(0xa6da95),
+    .teal = rgb(0x8bd5ca),
+    .sky = rgb(0x91d7e3),
+    .sapphire = rgb(0x7dc4e4),
+    .blue = rgb(0x8aadf4),
+    .lavender = rgb(0xb7bdf8),
+
+    .text = rgb(0xcad3f5),
+    .subtext1 = rgb(0xb8c0e0),
+    .subtext0 = rgb(0xa5adcb),
+    .overlay2 = rgb(0x939ab7),
+    .overlay1 = rgb(0x8087a2),
+    .overlay0 = rgb(0x6e738d),
+    .surface2 = rgb(0x5b6078),
+    .surface1 = rgb(0x494d64),
+    .surface0 = rgb(0x363a4f),
+
+    .base = rgb(0x24273a),
+    .mantle = rgb(0x1e2030),
+    .crust = rgb(0x181926),
+};
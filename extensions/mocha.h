@@ -2,33 +2,33 @@
 
 #include "theme.h"
 
-inline const Theme CATPUCCIN_MOCHA = {
-    .rosewater = "#f5e0dc",
-    .flamingo = "#f2cdcd",
-    .pink = "#f5c2e7",
-    .mauve = "#cba6f7",
-    .red = "#f38ba8",
-    .maroon = "#eba0ac",
-    .peach = "#fab387",
-    .yellow = "#f9e2af",
-    .green = "#a6e3a1",
-    .teal = "#94e2d5",
-    .sky = "#89dceb",
-    .sapphire = "#74c7ec",
-    .blue = "#89b4fa",
-    .lavender = "#b4befe",
+inline constexpr Theme CATPUCCIN_MOCHA = {
+    .rosewater = rgb(0xf5e0dc),
+    .flamingo = rgb(0xf2cdcd),
+    .pink = rgb(0xf5c2e7),
+    .mauve = rgb(0xcba6f7),
+    .red = rgb(0xf38ba8),
+    .maroon = rgb(0xeba0ac),
+    .peach = rgb(0xfab387),
+    .yellow = rgb(0xf9e2af),
+    .green = rgb(0xa6e3a1),
+    .teal = rgb(0x94e2d5),
+    .sky = rgb(0x89dceb),
+    .sapphire = rgb(0x74c7ec),
+    .blue = rgb(0x89b4fa),
+    .lavender = rgb(0xb4befe),
 
-    .text = "#cdd6f4",
-    .subtext1 = "#bac2de",
-    .subtext0 = "#a6adc8",
-    .overlay2 = "#9399b2",
-    .overlay1 = "#7f849c",
-    .overlay0 = "#6c7086",
-    .surface2 = "#585b70",
-    .surface1 = "#45475a",
-    .surface0 = "#313244",
+    .text = rgb(0xcdd6f4),
+    .subtext1 = rgb(0xbac2de),
+    .subtext0 = rgb(0xa6adc8),
+    .overlay2 = rgb(0x9399b2),
+    .overlay1 = rgb(0x7f849c),
+    .overlay0 = rgb(0x6c7086),
+    .surface2 = rgb(0x585b70),
+    .surface1 = rgb(0x45475a),
+    .surface0 = rgb(0x313244),
 
-    .base = "#1e1e2e",
-    .mantle = "#181825",
-    .crust = "#11111b",
+    .base = rgb(0x1e1e2e),
+    .mantle = rgb(0x181825),
+    .crust = rgb(0x11111b),
 };
@@ -1,34 +1,133 @@
 #pragma once
 
-#include <qcolor.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <qobjectdefs.h>
+#include <qqmlintegration.h>
+#include <qrgb.h>
+
+namespace Colors {
+Q_NAMESPACE
+QML_NAMED_ELEMENT(ColorRole)
+
+/// Color roles of a theme, also the palette index used by the GPU materials
+enum class Role : uint8_t {
+  Rosewater,
+  Flamingo,
+  Pink,
+  Mauve,
+  Red,
+  Maroon,
+  Peach,
+  Yellow,
+  Green,
+  Teal,
+  Sky,
+  Sapphire,
+  Blue,
+  Lavender,
+
+  Text,
+  Subtext1,
+  Subtext0,
+  Overlay2,
+  Overlay1,
+  Overlay0,
+  Surface2,
+  Surface1,
+  Surface0,
+
+  Base,
+  Mantle,
+  Crust,
+
+  Count
+};
+Q_ENUM_NS(Role)
+
+} // namespace Colors
+
+using ColorRole = Colors::Role;
+
+inline constexpr std::size_t COLOR_ROLE_COUNT =
+    static_cast<std::size_t>(ColorRole::Count);
+
+/// Keys of user theme colors, `theme.<name>.<role name> = #rrggbb`
+inline constexpr std::array<const char*, COLOR_ROLE_COUNT> COLOR_ROLE_NAMES = {
+    "rosewater", "flamingo", "pink",     "mauve",    "red",      "maroon",
+    "peach",     "yellow",   "green",    "teal",     "sky",      "sapphire",
+    "blue",      "lavender", "text",     "subtext1", "subtext0", "overlay2",
+    "overlay1",  "overlay0", "surface2", "surface1", "surface0", "base",
+    "mantle",    "crust",
+};
+
+/// Opaque color from 0xrrggbb
+constexpr QRgb rgb(const uint32_t hex) { return 0xff000000U | hex; }
 
 struct Theme {
-  QColor rosewater;
-  QColor flamingo;
-  QColor pink;
-  QColor mauve;
-  QColor red;
-  QColor maroon;
-  QColor peach;
-  QColor yellow;
-  QColor green;
-  QColor teal;
-  QColor sky;
-  QColor sapphire;
-  QColor blue;
-  QColor lavender;
-
-  QColor text;
-  QColor subtext1;
-  QColor subtext0;
-  QColor overlay2;
-  QColor overlay1;
-  QColor overlay0;
-  QColor surface2;
-  QColor surface1;
-  QColor surface0;
-
-  QColor base;
-  QColor mantle;
-  QColor crust;
+  QRgb rosewater;
+  QRgb flamingo;
+  QRgb pink;
+  QRgb mauve;
+  QRgb red;
+  QRgb maroon;
+  QRgb peach;
+  QRgb yellow;
+  QRgb green;
+  QRgb teal;
+  QRgb sky;
+  QRgb sapphire;
+  QRgb blue;
+  QRgb lavender;
+
+  QRgb text;
+  QRgb subtext1;
+  QRgb subtext0;
+  QRgb overlay2;
+  QRgb overlay1;
+  QRgb overlay0;
+  QRgb surface2;
+  QRgb surface1;
+  QRgb surface0;
+
+  QRgb base;
+  QRgb mantle;
+  QRgb crust;
+
+  [[nodiscard]] constexpr QRgb color(ColorRole role) const;
+  constexpr void setColor(ColorRole role, QRgb value);
+
+  [[nodiscard]] constexpr bool operator==(const Theme& other) const;
+  [[nodiscard]] constexpr bool operator!=(const Theme& other) const {
+    return !(*this == other);
+  }
 };
+
+/// Members of Theme in ColorRole order
+inline constexpr std::array<QRgb Theme::*, COLOR_ROLE_COUNT> THEME_ROLES = {
+    &Theme::rosewater, &Theme::flamingo, &Theme::pink,     &Theme::mauve,
+    &Theme::red,       &Theme::maroon,   &Theme::peach,    &Theme::yellow,
+    &Theme::green,     &Theme::teal,     &Theme::sky,      &Theme::sapphire,
+    &Theme::blue,      &Theme::lavender, &Theme::text,     &Theme::subtext1,
+    &Theme::subtext0,  &Theme::overlay2, &Theme::overlay1, &Theme::overlay0,
+    &Theme::surface2,  &Theme::surface1, &Theme::surface0, &Theme::base,
+    &Theme::mantle,    &Theme::crust,
+};
+
+constexpr QRgb Theme::color(const ColorRole role) const {
+  return this->*THEME_ROLES[static_cast<std::size_t>(role)];
+}
+
+constexpr void Theme::setColor(const ColorRole role, const QRgb value) {
+  this->*THEME_ROLES[static_cast<std::size_t>(role)] = value;
+}
+
+constexpr bool Theme::operator==(const Theme& other) const {
+  for (const auto member : THEME_ROLES) {
+    if (this->*member != other.*member) {
+      return false;
+    }
+  }
+  return true;
+}
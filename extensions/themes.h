@@ -0,0 +1,24 @@
+#pragma once
+
+#include <array>
+
+#include "frappe.h"
+#include "latte.h"
+#include "macchiato.h"
+#include "mocha.h"
+#include "theme.h"
+
+struct NamedTheme {
+  const char* name;
+  const Theme* theme;
+};
+
+/// Built-in themes, user themes from the config file are indexed after these
+inline constexpr std::array<NamedTheme, 4> BUILTIN_THEMES = {{
+    {"latte", &CATPUCCIN_LATTE},
+    {"frappe", &CATPUCCIN_FRAPPE},
+    {"macchiato", &CATPUCCIN_MACCHIATO},
+    {"mocha", &CATPUCCIN_MOCHA},
+}};
+
+inline constexpr int DEFAULT_THEME_INDEX = 3;
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <chrono>
+#include <qtypes.h>
+
+namespace Clock {
+
+/// Monotonic milliseconds, the time base of deadlines and position anchors
+inline qint64 monotonicMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace Clock
@@ -0,0 +1,397 @@
+#include "client.h"
+
+#include <cstring>
+#include <qdebug.h>
+#include <qdir.h>
+#include <qfileinfo.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qlogging.h>
+#include <qstandardpaths.h>
+
+namespace Compositor {
+
+namespace {
+
+constexpr int kInitialBackoffMs = 500;
+constexpr int kMaxBackoffMs = 30 * 1000;
+
+constexpr QByteArrayView kI3Magic = "i3-ipc";
+constexpr qsizetype kI3HeaderSize = 6 + 2 * sizeof(uint32_t);
+
+constexpr uint32_t kI3GetWorkspaces = 1;
+constexpr uint32_t kI3Subscribe = 2;
+constexpr uint32_t kI3GetTree = 4;
+constexpr uint32_t kI3EventBit = 0x80000000U;
+constexpr uint32_t kI3WorkspaceEvent = kI3EventBit | 0;
+constexpr uint32_t kI3WindowEvent = kI3EventBit | 3;
+
+QJsonDocument parseJson(QByteArrayView payload) {
+  // Parse in place, no copy of the payload
+  return QJsonDocument::fromJson(
+      QByteArray::fromRawData(payload.data(), payload.size()));
+}
+
+Workspace workspaceFromJson(const QJsonObject& object) {
+  Workspace workspace;
+  workspace.number = object.value("num").toInt(object.value("id").toInt());
+  workspace.id = object.value("id").toInteger(workspace.number);
+  workspace.name = object.value("name").toString();
+  workspace.focused = object.value("focused").toBool();
+  workspace.urgent = object.value("urgent").toBool();
+  return workspace;
+}
+
+/**
+ * Looks for the focused container of an i3 layout tree. @p title is left empty
+ * if that is a workspace or output rather than a window.
+ *
+ * @return false if nothing in @p node has focus
+ */
+bool findFocusedTitle(const QJsonObject& node, QString& title) {
+  if (node.value("focused").toBool()) {
+    const QString type = node.value("type").toString();
+    if (type == "con" || type == "floating_con") {
+      title = node.value("name").toString();
+    }
+    return true;
+  }
+
+  for (const auto* key : {"nodes", "floating_nodes"}) {
+    const QJsonArray children = node.value(QLatin1StringView(key)).toArray();
+    for (const auto& child : children) {
+      if (findFocusedTitle(child.toObject(), title)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/// Splits "first,rest" at the first comma, rest may contain more commas
+std::pair<QByteArrayView, QByteArrayView> splitOnce(QByteArrayView data) {
+  const qsizetype comma = data.indexOf(',');
+  if (comma < 0) {
+    return {data, {}};
+  }
+  return {data.first(comma), data.sliced(comma + 1)};
+}
+
+} // namespace
+
+// ####################### Client #######################
+
+Client::Client(QString socketPath, WorkspaceModel* workspaces,
+               TitleModel* title, QObject* parent)
+    : QObject{parent}, m_workspaces{workspaces}, m_title{title},
+      m_socketPath{std::move(socketPath)}, m_backoffMs{kInitialBackoffMs} {
+  m_reconnectTimer.setSingleShot(true);
+  connect(&m_reconnectTimer, &QTimer::timeout, this, &Client::start);
+
+  connect(&m_socket, &QLocalSocket::connected, this, [this]() {
+    m_backoffMs = kInitialBackoffMs;
+    onConnected();
+  });
+  connect(&m_socket, &QLocalSocket::readyRead, this, &Client::onReadyRead);
+  connect(&m_socket, &QLocalSocket::disconnected, this,
+          &Client::scheduleReconnect);
+  connect(&m_socket, &QLocalSocket::errorOccurred, this,
+          [this](QLocalSocket::LocalSocketError /*unused*/) {
+            qWarning() << "Compositor IPC:" << m_socketPath << "-"
+                       << m_socket.errorString();
+
+            // A failed connect never reaches disconnected()
+            if (m_socket.state() == QLocalSocket::UnconnectedState) {
+              scheduleReconnect();
+            }
+          });
+}
+
+Client::~Client() {
+  // Closing the socket below must not arm the timer again
+  m_socket.disconnect(this);
+}
+
+void Client::start() {
+  m_reconnectTimer.stop();
+  m_buffer.clear();
+
+  qDebug() << "Compositor IPC: connecting to" << m_socketPath;
+  m_socket.connectToServer(m_socketPath);
+}
+
+void Client::scheduleReconnect() {
+  // A dropped connection reports both an error and disconnected()
+  if (m_reconnectTimer.isActive()) {
+    return;
+  }
+
+  qDebug() << "Compositor IPC: reconnecting to" << m_socketPath << "in"
+           << m_backoffMs << "ms";
+
+  m_reconnectTimer.start(m_backoffMs);
+  m_backoffMs = qMin(m_backoffMs * 2, kMaxBackoffMs);
+}
+
+std::unique_ptr<Client> Client::create(const QString& protocol,
+                                       const QString& socketPath,
+                                       WorkspaceModel* workspaces,
+                                       TitleModel* title) {
+  if (!socketPath.isEmpty()) {
+    if (protocol == "hyprland") {
+      return std::make_unique<HyprlandClient>(socketPath, workspaces, title);
+    }
+    return std::make_unique<I3Client>(socketPath, workspaces, title);
+  }
+
+  const bool any = protocol == "auto";
+
+  if (any || protocol == "i3") {
+    QString path = qEnvironmentVariable("SWAYSOCK");
+    if (path.isEmpty()) {
+      path = qEnvironmentVariable("I3SOCK");
+    }
+    if (!path.isEmpty()) {
+      return std::make_unique<I3Client>(path, workspaces, title);
+    }
+  }
+
+  if (any || protocol == "hyprland") {
+    const QString signature =
+        qEnvironmentVariable("HYPRLAND_INSTANCE_SIGNATURE");
+    if (!signature.isEmpty()) {
+      const QString runtimeDir =
+          QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+      QString path =
+          QString("%1/hypr/%2/.socket2.sock").arg(runtimeDir, signature);
+      if (!QFileInfo::exists(path)) {
+        path = QString("/tmp/hypr/%1/.socket2.sock").arg(signature);
+      }
+      return std::make_unique<HyprlandClient>(path, workspaces, title);
+    }
+  }
+
+  return nullptr;
+}
+
+void Client::onReadyRead() {
+  m_buffer.append(m_socket.readAll());
+
+  const qsizetype consumed = parse(m_buffer);
+  if (consumed > 0) {
+    m_buffer.remove(0, consumed);
+  }
+}
+
+// ####################### I3Client #######################
+
+void I3Client::onConnected() {
+  send(kI3Subscribe, R"(["workspace","window"])");
+  send(kI3GetWorkspaces, {});
+  send(kI3GetTree, {});
+}
+
+void I3Client::send(const uint32_t type, const QByteArray& payload) {
+  QByteArray message;
+  message.reserve(kI3HeaderSize + payload.size());
+  message.append(kI3Magic);
+
+  const auto length = static_cast<uint32_t>(payload.size());
+  message.append(reinterpret_cast<const char*>(&length), sizeof(length));
+  message.append(reinterpret_cast<const char*>(&type), sizeof(type));
+  message.append(payload);
+
+  socket().write(message);
+}
+
+qsizetype I3Client::parse(QByteArrayView buffer) {
+  qsizetype offset = 0;
+
+  while (buffer.size() - offset >= kI3HeaderSize) {
+    const QByteArrayView header = buffer.sliced(offset, kI3HeaderSize);
+    if (!header.startsWith(kI3Magic)) {
+      qWarning() << "Compositor IPC: lost i3-ipc framing, reconnecting";
+      socket().abort();
+      start();
+      return buffer.size();
+    }
+
+    uint32_t length = 0;
+    uint32_t type = 0;
+    std::memcpy(&length, header.data() + kI3Magic.size(), sizeof(length));
+    std::memcpy(&type, header.data() + kI3Magic.size() + sizeof(length),
+                sizeof(type));
+
+    if (buffer.size() - offset - kI3HeaderSize < length) {
+      break;
+    }
+
+    handleMessage(type, buffer.sliced(offset + kI3HeaderSize, length));
+    offset += kI3HeaderSize + length;
+  }
+
+  return offset;
+}
+
+void I3Client::handleMessage(const uint32_t type, QByteArrayView payload) {
+  const QJsonDocument document = parseJson(payload);
+
+  switch (type) {
+  case kI3GetWorkspaces: {
+    QList<Workspace> workspaces;
+    for (const auto& value : document.array()) {
+      workspaces.append(workspaceFromJson(value.toObject()));
+    }
+    m_workspaces->reset(std::move(workspaces));
+    break;
+  }
+  case kI3GetTree: {
+    QString title;
+    findFocusedTitle(document.object(), title);
+    m_title->setTitle(title);
+    break;
+  }
+  case kI3WorkspaceEvent:
+    handleWorkspaceEvent(document.object());
+    break;
+  case kI3WindowEvent:
+    handleWindowEvent(document.object());
+    break;
+  default:
+    // Subscribe acknowledgement and events we did not ask for
+    break;
+  }
+}
+
+void I3Client::handleWorkspaceEvent(const QJsonObject& event) {
+  const QString change = event.value("change").toString();
+  const Workspace current = workspaceFromJson(event.value("current").toObject());
+
+  if (change == "init") {
+    m_workspaces->upsert(current);
+  } else if (change == "empty") {
+    m_workspaces->remove(current.id);
+  } else if (change == "focus") {
+    m_workspaces->upsert(current);
+    m_workspaces->setFocused(current.id);
+  } else if (change == "rename") {
+    // "current" carries the new num too, renaming "1" to "5" renumbers it
+    m_workspaces->rename(current.id, current.name, current.number);
+  } else if (change == "urgent") {
+    m_workspaces->setUrgent(current.id, current.urgent);
+  } else if (change == "reload") {
+    // Configuration reload can renumber everything, ask once
+    send(kI3GetWorkspaces, {});
+  }
+}
+
+void I3Client::handleWindowEvent(const QJsonObject& event) {
+  const QString change = event.value("change").toString();
+  const QJsonObject container = event.value("container").toObject();
+  const bool focused = container.value("focused").toBool();
+
+  if (change == "focus" || (change == "title" && focused)) {
+    m_title->setTitle(container.value("name").toString());
+  } else if (change == "close" && focused) {
+    m_title->setTitle({});
+  }
+}
+
+// ####################### HyprlandClient #######################
+
+void HyprlandClient::onConnected() {
+  request("j/workspaces", [this](const QByteArray& reply) {
+    QList<Workspace> workspaces;
+    for (const auto& value : parseJson(reply).array()) {
+      workspaces.append(workspaceFromJson(value.toObject()));
+    }
+    m_workspaces->reset(std::move(workspaces));
+
+    request("j/activeworkspace", [this](const QByteArray& active) {
+      m_workspaces->setFocused(workspaceFromJson(parseJson(active).object()).id);
+    });
+  });
+
+  request("j/activewindow", [this](const QByteArray& reply) {
+    m_title->setTitle(parseJson(reply).object().value("title").toString());
+  });
+}
+
+QString HyprlandClient::commandSocketPath() const {
+  return QFileInfo(socketPath()).dir().filePath(".socket.sock");
+}
+
+void HyprlandClient::request(
+    const QByteArray& command,
+    const std::function<void(const QByteArray&)>& handler) {
+  auto* connection = new QLocalSocket(this);
+  auto reply = std::make_shared<QByteArray>();
+
+  connect(connection, &QLocalSocket::connected, connection,
+          [connection, command]() { connection->write(command); });
+  connect(connection, &QLocalSocket::readyRead, connection,
+          [connection, reply]() { reply->append(connection->readAll()); });
+  connect(connection, &QLocalSocket::disconnected, this,
+          [connection, reply, handler]() {
+            reply->append(connection->readAll());
+            handler(*reply);
+            connection->deleteLater();
+          });
+  connect(connection, &QLocalSocket::errorOccurred, connection,
+          [connection, command](QLocalSocket::LocalSocketError error) {
+            if (error != QLocalSocket::PeerClosedError) {
+              qWarning() << "Compositor IPC: request" << command << "failed -"
+                         << connection->errorString();
+              connection->deleteLater();
+            }
+          });
+
+  connection->connectToServer(commandSocketPath());
+}
+
+qsizetype HyprlandClient::parse(QByteArrayView buffer) {
+  qsizetype offset = 0;
+
+  for (;;) {
+    const qsizetype end = buffer.indexOf('\n', offset);
+    if (end < 0) {
+      break;
+    }
+
+    const QByteArrayView line = buffer.sliced(offset, end - offset);
+    const qsizetype separator = line.indexOf(">>");
+    if (separator > 0) {
+      handleEvent(line.first(separator), line.sliced(separator + 2));
+    }
+
+    offset = end + 1;
+  }
+
+  return offset;
+}
+
+void HyprlandClient::handleEvent(QByteArrayView name, QByteArrayView data) {
+  if (name == "workspacev2" || name == "createworkspacev2") {
+    const auto [id, workspaceName] = splitOnce(data);
+
+    Workspace workspace;
+    workspace.id = id.toLongLong();
+    workspace.number = static_cast<int>(workspace.id);
+    workspace.name = QString::fromUtf8(workspaceName);
+    workspace.focused = name == "workspacev2";
+
+    m_workspaces->upsert(workspace);
+  } else if (name == "destroyworkspacev2") {
+    m_workspaces->remove(splitOnce(data).first.toLongLong());
+  } else if (name == "renameworkspace") {
+    const auto [id, workspaceName] = splitOnce(data);
+    // Hyprland numbers workspaces by their id, which a rename keeps
+    const qint64 workspaceId = id.toLongLong();
+    m_workspaces->rename(workspaceId, QString::fromUtf8(workspaceName),
+                         static_cast<int>(workspaceId));
+  } else if (name == "activewindow") {
+    m_title->setTitle(QString::fromUtf8(splitOnce(data).second));
+  }
+}
+
+} // namespace Compositor
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qjsonobject.h>
+#include <qlocalsocket.h>
+#include <qobject.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+#include "src/compositor/titlemodel.h"
+#include "src/compositor/workspacemodel.h"
+
+namespace Compositor {
+
+/**
+ * @class Client
+ * @brief Event-stream connection to a compositor's IPC socket.
+ *
+ * Subclasses subscribe after connecting, query the workspace list once, and
+ * from then on update the models from events only. Incoming bytes are
+ * accumulated and parsed as soon as a complete message is available; partial
+ * messages stay in the buffer until the rest arrives.
+ *
+ * A compositor that is not up yet or drops the connection, an i3 in-place
+ * restart for instance, is retried with a delay that doubles up to half a
+ * minute. Every successful connect runs onConnected() again, which asks for
+ * the full state, so nothing stays stale after a reconnect.
+ *
+ * The socket path is a constructor argument, so a client can be pointed at a
+ * local fake server that replays recorded events.
+ */
+class Client : public QObject {
+  Q_OBJECT
+
+public:
+  Client(QString socketPath, WorkspaceModel* workspaces, TitleModel* title,
+         QObject* parent = nullptr);
+  ~Client() override;
+
+  void start();
+
+  /**
+   * @brief Picks the client for the running compositor.
+   *
+   * @p protocol is "i3" (sway or i3), "hyprland" or "auto", which looks at
+   * $SWAYSOCK, $I3SOCK and $HYPRLAND_INSTANCE_SIGNATURE. A non-empty
+   * @p socketPath skips the discovery and is spoken to as hyprland if
+   * @p protocol says so, as i3 otherwise.
+   *
+   * @return nullptr if no supported compositor was found.
+   */
+  static std::unique_ptr<Client> create(const QString& protocol,
+                                        const QString& socketPath,
+                                        WorkspaceModel* workspaces,
+                                        TitleModel* title);
+
+protected:
+  virtual void onConnected() = 0;
+
+  /// Parses what it can from the front of @p buffer and returns the number
+  /// of bytes consumed
+  virtual qsizetype parse(QByteArrayView buffer) = 0;
+
+  QLocalSocket& socket() { return m_socket; }
+  [[nodiscard]] const QString& socketPath() const { return m_socketPath; }
+
+  WorkspaceModel* m_workspaces;
+  TitleModel* m_title;
+
+private:
+  void onReadyRead();
+  void scheduleReconnect();
+
+  QString m_socketPath;
+  QLocalSocket m_socket;
+  QByteArray m_buffer;
+
+  QTimer m_reconnectTimer;
+  int m_backoffMs;
+};
+
+/**
+ * @class I3Client
+ * @brief sway / i3 JSON IPC: "i3-ipc" framed messages with a native-endian
+ * length and type header.
+ */
+class I3Client final : public Client {
+  Q_OBJECT
+
+public:
+  using Client::Client;
+
+protected:
+  void onConnected() override;
+  qsizetype parse(QByteArrayView buffer) override;
+
+private:
+  void send(uint32_t type, const QByteArray& payload);
+  void handleMessage(uint32_t type, QByteArrayView payload);
+  void handleWorkspaceEvent(const QJsonObject& event);
+  void handleWindowEvent(const QJsonObject& event);
+};
+
+/**
+ * @class HyprlandClient
+ * @brief Hyprland socket2: newline separated "EVENT>>DATA" lines.
+ *
+ * The initial workspace list comes from one "j/workspaces" and one
+ * "j/activeworkspace" request on the command socket.
+ */
+class HyprlandClient final : public Client {
+  Q_OBJECT
+
+public:
+  using Client::Client;
+
+protected:
+  void onConnected() override;
+  qsizetype parse(QByteArrayView buffer) override;
+
+private:
+  void request(const QByteArray& command,
+               const std::function<void(const QByteArray&)>& handler);
+  void handleEvent(QByteArrayView name, QByteArrayView data);
+
+  [[nodiscard]] QString commandSocketPath() const;
+};
+
+} // namespace Compositor
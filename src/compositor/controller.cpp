@@ -0,0 +1,30 @@
+#include "compositor/controller.h"
+
+#include <qdebug.h>
+#include <qlogging.h>
+
+namespace Compositor {
+
+Controller::Controller(QObject* parent) : QObject{parent} {
+  m_workspaceModel = std::make_shared<WorkspaceModel>();
+  m_titleModel = std::make_shared<TitleModel>();
+}
+
+Controller::~Controller() = default;
+
+void Controller::start(const QString& protocol, const QString& socketPath) {
+  if (protocol == "none") {
+    return;
+  }
+
+  m_client = Client::create(protocol, socketPath, m_workspaceModel.get(),
+                            m_titleModel.get());
+  if (m_client == nullptr) {
+    qDebug() << "Compositor IPC: no supported compositor found";
+    return;
+  }
+
+  m_client->start();
+}
+
+} // namespace Compositor
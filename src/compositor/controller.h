@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <qobject.h>
+
+#include "src/compositor/client.h"
+#include "src/compositor/titlemodel.h"
+#include "src/compositor/workspacemodel.h"
+
+namespace Compositor {
+
+class Controller : public QObject {
+public:
+  Controller(QObject* parent = nullptr);
+  ~Controller() override;
+
+  /// Connects to the compositor selected by @p protocol, see Client::create()
+  void start(const QString& protocol, const QString& socketPath = QString());
+
+  [[nodiscard]] WorkspaceModelRef getWorkspaceModel() const {
+    return m_workspaceModel;
+  }
+  [[nodiscard]] TitleModelRef getTitleModel() const { return m_titleModel; }
+
+private:
+  WorkspaceModelRef m_workspaceModel;
+  TitleModelRef m_titleModel;
+  std::unique_ptr<Client> m_client;
+};
+
+} // namespace Compositor
+
+using CompositorController = Compositor::Controller;
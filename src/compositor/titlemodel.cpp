@@ -0,0 +1,89 @@
+#include "titlemodel.h"
+#include "config.h"
+
+#include <qfontmetrics.h>
+#include <qqmlengine.h>
+
+namespace Compositor {
+
+namespace {
+
+/// Entries before the elide cache starts over, titles pile up as focus moves
+constexpr qsizetype kMaxCachedTitles = 64;
+
+} // namespace
+
+TitleModel::TitleModel(QObject* parent) : QObject{parent} {
+  QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+
+  followConfigFont();
+  connect(&CONFIG, &Config::qmlDefaultFontFamilyChanged, this,
+          &TitleModel::followConfigFont);
+  connect(&CONFIG, &Config::qmlDefaultFontSizeChanged, this,
+          &TitleModel::followConfigFont);
+}
+
+TitleModel::~TitleModel() = default;
+
+void TitleModel::setTitle(const QString& title) {
+  if (m_title == title) {
+    return;
+  }
+
+  m_title = title;
+  emit titleChanged();
+
+  updateElidedTitle();
+}
+
+void TitleModel::setElideWidth(const int width) {
+  if (m_elideWidth == width) {
+    return;
+  }
+
+  m_elideWidth = width;
+  emit elideWidthChanged();
+
+  updateElidedTitle();
+}
+
+void TitleModel::setFont(const QFont& font) {
+  if (m_font == font) {
+    return;
+  }
+
+  m_font = font;
+  m_elideCache.clear();
+  updateElidedTitle();
+}
+
+void TitleModel::followConfigFont() {
+  QFont font(CONFIG.qmlDefaultFontFamily());
+  font.setPixelSize(CONFIG.qmlDefaultFontSize());
+  setFont(font);
+}
+
+void TitleModel::updateElidedTitle() {
+  QString elided = m_title;
+
+  if (m_elideWidth > 0) {
+    const QPair<QString, int> key{m_title, m_elideWidth};
+    auto it = m_elideCache.constFind(key);
+    if (it == m_elideCache.cend()) {
+      if (m_elideCache.size() >= kMaxCachedTitles) {
+        m_elideCache.clear();
+      }
+      const QFontMetricsF metrics(m_font);
+      it = m_elideCache.insert(
+          key, metrics.elidedText(m_title, Qt::ElideRight, m_elideWidth));
+    }
+    elided = it.value();
+  }
+
+  if (m_elidedTitle != elided) {
+    m_elidedTitle = elided;
+    emit elidedTitleChanged();
+  }
+}
+
+} // namespace Compositor
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <qfont.h>
+#include <qhash.h>
+#include <qobject.h>
+#include <qpair.h>
+#include <qtmetamacros.h>
+
+namespace Compositor {
+
+/**
+ * @class TitleModel
+ * @brief Title of the focused window, with an elided variant for the bar.
+ *
+ * Elided strings are cached per title and width, so focus going back and
+ * forth between windows, a view resizing back and forth or several views
+ * showing the title at different widths measure each text once. The font
+ * follows the bar font in the config.
+ */
+class TitleModel : public QObject {
+  Q_OBJECT
+
+  Q_PROPERTY(QString title READ title NOTIFY titleChanged)
+  Q_PROPERTY(int elideWidth READ elideWidth WRITE setElideWidth NOTIFY
+                 elideWidthChanged)
+  Q_PROPERTY(QString elidedTitle READ elidedTitle NOTIFY elidedTitleChanged)
+
+public:
+  explicit TitleModel(QObject* parent = nullptr);
+  ~TitleModel() override;
+
+  [[nodiscard]] QString title() const { return m_title; }
+  void setTitle(const QString& title);
+
+  [[nodiscard]] int elideWidth() const { return m_elideWidth; }
+  void setElideWidth(int width);
+
+  [[nodiscard]] QString elidedTitle() const { return m_elidedTitle; }
+
+  /// Font the elision is measured with, replaced when the bar font changes
+  void setFont(const QFont& font);
+
+signals:
+  void titleChanged();
+  void elideWidthChanged();
+  void elidedTitleChanged();
+
+private:
+  void updateElidedTitle();
+  void followConfigFont();
+
+  QString m_title;
+  QString m_elidedTitle;
+  int m_elideWidth = 0;
+
+  QFont m_font;
+  QHash<QPair<QString, int>, QString> m_elideCache;
+};
+
+} // namespace Compositor
+
+using TitleModelRef = std::shared_ptr<Compositor::TitleModel>;
@@ -0,0 +1,189 @@
+#include "workspacemodel.h"
+
+#include <algorithm>
+#include <qqmlengine.h>
+
+namespace Compositor {
+
+namespace {
+
+bool lessThan(const Workspace& lhs, const Workspace& rhs) {
+  if (lhs.number != rhs.number) {
+    return lhs.number < rhs.number;
+  }
+  return lhs.name < rhs.name;
+}
+
+} // namespace
+
+WorkspaceModel::WorkspaceModel(QObject* parent) : QAbstractListModel{parent} {
+  QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+}
+
+WorkspaceModel::~WorkspaceModel() = default;
+
+int WorkspaceModel::rowCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : static_cast<int>(m_workspaces.size());
+}
+
+QVariant WorkspaceModel::data(const QModelIndex& index, const int role) const {
+  if (!checkIndex(index, CheckIndexOption::IndexIsValid)) {
+    return {};
+  }
+
+  const Workspace& workspace = m_workspaces.at(index.row());
+  switch (role) {
+  case IdRole:
+    return workspace.id;
+  case Qt::DisplayRole:
+  case NameRole:
+    return workspace.name;
+  case FocusedRole:
+    return workspace.focused;
+  case UrgentRole:
+    return workspace.urgent;
+  default:
+    break;
+  }
+  return {};
+}
+
+QHash<int, QByteArray> WorkspaceModel::roleNames() const {
+  return {
+      {IdRole, "workspaceId"},
+      {NameRole, "name"},
+      {FocusedRole, "focused"},
+      {UrgentRole, "urgent"},
+  };
+}
+
+void WorkspaceModel::reset(QList<Workspace> workspaces) {
+  std::sort(workspaces.begin(), workspaces.end(), lessThan);
+
+  beginResetModel();
+  m_workspaces = std::move(workspaces);
+  endResetModel();
+}
+
+void WorkspaceModel::upsert(const Workspace& workspace) {
+  const qsizetype existing = indexOf(workspace.id);
+  if (existing >= 0) {
+    const Workspace& current = m_workspaces.at(existing);
+    if (current.name != workspace.name || current.number != workspace.number) {
+      rename(workspace.id, workspace.name, workspace.number);
+    }
+    if (current.urgent != workspace.urgent) {
+      setUrgent(workspace.id, workspace.urgent);
+    }
+    if (workspace.focused && !current.focused) {
+      setFocused(workspace.id);
+    }
+    return;
+  }
+
+  const auto position = std::upper_bound(m_workspaces.cbegin(),
+                                         m_workspaces.cend(), workspace,
+                                         lessThan);
+  const auto row = static_cast<int>(position - m_workspaces.cbegin());
+
+  beginInsertRows({}, row, row);
+  m_workspaces.insert(row, workspace);
+  m_workspaces[row].focused = false;
+  endInsertRows();
+
+  if (workspace.focused) {
+    setFocused(workspace.id);
+  }
+}
+
+void WorkspaceModel::remove(const qint64 id) {
+  const qsizetype row = indexOf(id);
+  if (row < 0) {
+    return;
+  }
+
+  beginRemoveRows({}, static_cast<int>(row), static_cast<int>(row));
+  m_workspaces.remove(row);
+  endRemoveRows();
+}
+
+void WorkspaceModel::rename(const qint64 id, const QString& name,
+                            const int number) {
+  const qsizetype row = indexOf(id);
+  if (row < 0) {
+    return;
+  }
+
+  Workspace& workspace = m_workspaces[row];
+  if (workspace.name == name && workspace.number == number) {
+    return;
+  }
+
+  const bool nameChanged = workspace.name != name;
+  workspace.name = name;
+  workspace.number = number;
+  if (nameChanged) {
+    emitRowChanged(row, NameRole);
+  }
+  moveToSortedRow(row);
+}
+
+void WorkspaceModel::setFocused(const qint64 id) {
+  for (qsizetype row = 0; row < m_workspaces.size(); row++) {
+    Workspace& workspace = m_workspaces[row];
+    const bool focused = workspace.id == id;
+
+    if (workspace.focused != focused) {
+      workspace.focused = focused;
+      emitRowChanged(row, FocusedRole);
+    }
+  }
+}
+
+void WorkspaceModel::setUrgent(const qint64 id, const bool urgent) {
+  const qsizetype row = indexOf(id);
+  if (row < 0 || m_workspaces.at(row).urgent == urgent) {
+    return;
+  }
+
+  m_workspaces[row].urgent = urgent;
+  emitRowChanged(row, UrgentRole);
+}
+
+qsizetype WorkspaceModel::indexOf(const qint64 id) const {
+  for (qsizetype row = 0; row < m_workspaces.size(); row++) {
+    if (m_workspaces.at(row).id == id) {
+      return row;
+    }
+  }
+  return -1;
+}
+
+void WorkspaceModel::emitRowChanged(const qsizetype row, const int role) {
+  const QModelIndex changed = index(static_cast<int>(row));
+  emit dataChanged(changed, changed, {role});
+}
+
+void WorkspaceModel::moveToSortedRow(const qsizetype row) {
+  const Workspace& workspace = m_workspaces.at(row);
+
+  // Where the row belongs among all the others, equal ones stay in front
+  qsizetype target = 0;
+  for (qsizetype other = 0; other < m_workspaces.size(); other++) {
+    if (other != row && !lessThan(workspace, m_workspaces.at(other))) {
+      target++;
+    }
+  }
+  if (target == row) {
+    return;
+  }
+
+  // beginMoveRows() counts the destination in rows before the move
+  const auto source = static_cast<int>(row);
+  const auto destination = static_cast<int>(target > row ? target + 1 : target);
+  beginMoveRows({}, source, source, {}, destination);
+  m_workspaces.move(row, target);
+  endMoveRows();
+}
+
+} // namespace Compositor
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <qabstractitemmodel.h>
+#include <qlist.h>
+#include <qstring.h>
+#include <qtmetamacros.h>
+
+namespace Compositor {
+
+struct Workspace {
+  qint64 id = 0;
+  int number = 0;
+  QString name;
+  bool focused = false;
+  bool urgent = false;
+};
+
+/**
+ * @class WorkspaceModel
+ * @brief Workspaces of the current compositor session, ordered by number.
+ *
+ * Every mutator touches only the affected rows and roles, so a focus change
+ * is two single-role dataChanged() emissions instead of a model reset.
+ */
+class WorkspaceModel : public QAbstractListModel {
+  Q_OBJECT
+
+public:
+  enum Role {
+    IdRole = Qt::UserRole + 1,
+    NameRole,
+    FocusedRole,
+    UrgentRole,
+  };
+  Q_ENUM(Role)
+
+  explicit WorkspaceModel(QObject* parent = nullptr);
+  ~WorkspaceModel() override;
+
+  [[nodiscard]] int rowCount(const QModelIndex& parent = {}) const override;
+  [[nodiscard]] QVariant data(const QModelIndex& index,
+                              int role = Qt::DisplayRole) const override;
+  [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+  void reset(QList<Workspace> workspaces);
+  void upsert(const Workspace& workspace);
+  void remove(qint64 id);
+  /// i3 renames can renumber, the row then moves to its new place
+  void rename(qint64 id, const QString& name, int number);
+  void setFocused(qint64 id);
+  void setUrgent(qint64 id, bool urgent);
+
+  [[nodiscard]] qsizetype indexOf(qint64 id) const;
+  [[nodiscard]] const QList<Workspace>& workspaces() const {
+    return m_workspaces;
+  }
+
+private:
+  void emitRowChanged(qsizetype row, int role);
+  void moveToSortedRow(qsizetype row);
+
+  QList<Workspace> m_workspaces;
+};
+
+} // namespace Compositor
+
+using WorkspaceModelRef = std::shared_ptr<Compositor::WorkspaceModel>;
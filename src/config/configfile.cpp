@@ -0,0 +1,154 @@
+#include "configfile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <qdebug.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qlogging.h>
+#include <qsocketnotifier.h>
+#include <qstandardpaths.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace ConfigFile {
+
+namespace {
+
+constexpr int kDebounceMs = 50;
+
+constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE |
+                                IN_DELETE | IN_MOVED_FROM;
+
+} // namespace
+
+void parse(QByteArrayView data, const Visitor& visitor) {
+  while (!data.isEmpty()) {
+    qsizetype end = data.indexOf('\n');
+    if (end < 0) {
+      end = data.size();
+    }
+
+    const QByteArrayView line = data.first(end).trimmed();
+    data = data.sliced(qMin(end + 1, data.size()));
+
+    if (line.isEmpty() || line.startsWith('#')) {
+      continue;
+    }
+
+    const qsizetype separator = line.indexOf('=');
+    if (separator <= 0) {
+      qWarning() << "Config: ignoring line" << line;
+      continue;
+    }
+
+    const QByteArrayView key = line.first(separator).trimmed();
+    QByteArrayView value = line.sliced(separator + 1).trimmed();
+
+    if (value.size() >= 2 && value.startsWith('"') && value.endsWith('"')) {
+      value = value.sliced(1, value.size() - 2);
+    }
+
+    visitor(key, value);
+  }
+}
+
+bool read(const QString& path, const Visitor& visitor) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  const qint64 size = file.size();
+  if (size == 0) {
+    return true;
+  }
+
+  uchar* mapped = file.map(0, size);
+  if (mapped == nullptr) {
+    // Not mappable (e.g. a pipe), read it the ordinary way
+    const QByteArray contents = file.readAll();
+    parse(contents, visitor);
+    return true;
+  }
+
+  parse(QByteArrayView(mapped, size), visitor);
+  file.unmap(mapped);
+
+  return true;
+}
+
+QString defaultPath() {
+  return QDir(QStandardPaths::writableLocation(
+                  QStandardPaths::GenericConfigLocation))
+      .filePath("simbar/simbar.conf");
+}
+
+// #################################################################
+
+Watcher::Watcher(QObject* parent) : QObject{parent} {
+  m_debounce.setSingleShot(true);
+  m_debounce.setInterval(kDebounceMs);
+  connect(&m_debounce, &QTimer::timeout, this, &Watcher::changed);
+}
+
+Watcher::~Watcher() {
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+}
+
+bool Watcher::watch(const QString& path) {
+  if (m_fd < 0) {
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+      qWarning() << "Config: inotify unavailable -" << strerror(errno);
+      return false;
+    }
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this,
+            &Watcher::readEvents);
+  }
+
+  if (m_watch >= 0) {
+    inotify_rm_watch(m_fd, m_watch);
+    m_watch = -1;
+  }
+
+  const QFileInfo info(path);
+  m_fileName = QFile::encodeName(info.fileName());
+
+  m_watch = inotify_add_watch(
+      m_fd, QFile::encodeName(info.absolutePath()).constData(), kWatchMask);
+  if (m_watch < 0) {
+    qWarning() << "Config: cannot watch" << info.absolutePath() << "-"
+               << strerror(errno);
+    return false;
+  }
+
+  return true;
+}
+
+void Watcher::readEvents() {
+  alignas(inotify_event) char buffer[4096];
+
+  for (;;) {
+    const ssize_t length = ::read(m_fd, buffer, sizeof(buffer));
+    if (length <= 0) {
+      return;
+    }
+
+    for (ssize_t offset = 0; offset < length;) {
+      const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+      offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+      if (event->len > 0 && m_fileName == event->name) {
+        m_debounce.start();
+      }
+    }
+  }
+}
+
+} // namespace ConfigFile
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <functional>
+#include <qbytearrayview.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+class QSocketNotifier;
+
+namespace ConfigFile {
+
+using Visitor = std::function<void(QByteArrayView key, QByteArrayView value)>;
+
+/**
+ * @brief Walks every `key = value` line of @p data without copying it.
+ *
+ * Blank lines and lines starting with `#` are skipped, a value may be wrapped
+ * in double quotes. Key and value views point into @p data.
+ */
+void parse(QByteArrayView data, const Visitor& visitor);
+
+/**
+ * @brief Maps @p path and parses it in place.
+ * @return false if the file cannot be opened. An empty file is valid.
+ */
+bool read(const QString& path, const Visitor& visitor);
+
+/// Default location, $XDG_CONFIG_HOME/simbar/simbar.conf
+[[nodiscard]] QString defaultPath();
+
+/**
+ * @class Watcher
+ * @brief Reports changes of one file through inotify.
+ *
+ * Watches the containing directory rather than the file, so editors that save
+ * by writing a new file and renaming it over the old one are followed too.
+ * Bursts of events are coalesced into one changed() signal.
+ */
+class Watcher final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit Watcher(QObject* parent = nullptr);
+  ~Watcher() override;
+
+  bool watch(const QString& path);
+
+signals:
+  void changed();
+
+private:
+  void readEvents();
+
+  int m_fd = -1;
+  int m_watch = -1;
+  QByteArray m_fileName;
+  QSocketNotifier* m_notifier = nullptr;
+  QTimer m_debounce;
+};
+
+} // namespace ConfigFile
@@ -1,65 +1,416 @@
 #include "engine.h"
 #include "appview.h"
+#include "imageprovider.h"
+#include "artprovider.h"
 #include "config.h"
-#include "mocha.h"
+#include "configfile.h"
+#include "glyphcache.h"
+#include "memory.h"
+#include "palette.h"
+#include "renderpolicy.h"
 #include "theme.h"
+#include "themes.h"
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
 #include <qdebug.h>
+#include <qdir.h>
+#include <qguiapplication.h>
 #include <qlogging.h>
+#include <qstandardpaths.h>
 #include <qqmlcontext.h>
 #include <qquickview.h>
+#include <qscreen.h>
+#include <qset.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 
 #include <LayerShellQt/window.h>
 
 ApplicationEngine::ApplicationEngine() = default;
 
-ApplicationEngine::~ApplicationEngine() = default;
+ApplicationEngine::~ApplicationEngine() {
+  m_ipcThread.quit();
+  m_ipcThread.wait();
+}
+
+void ApplicationEngine::setRenderSettings(const Render::Settings& settings) {
+  m_renderSettings = settings;
+}
+
+void ApplicationEngine::setConfigPath(const QString& path) {
+  m_configPath = path;
+}
+
+void ApplicationEngine::setRecordPath(const QString& path) {
+  m_recordPath = path;
+}
+
+bool ApplicationEngine::setReplay(const QString& path, const double speed) {
+  if (!m_replayPlayer.load(path)) {
+    return false;
+  }
+  m_replayPlayer.setSpeed(speed);
+  m_replayPath = path;
+  return true;
+}
+
+void ApplicationEngine::showSplash() {
+  if (!CONFIG.snapshotEnabled() || replaying()) {
+    return;
+  }
+
+  const qreal ratio = QGuiApplication::primaryScreen() != nullptr
+                          ? QGuiApplication::primaryScreen()->devicePixelRatio()
+                          : 1.0;
+  m_snapshotKeeper.setPath(Snapshot::defaultPath());
+  m_snapshotKeeper.setTarget(CONFIG.width(), CONFIG.height(), ratio,
+                             CONFIG.themeName());
+  m_snapshotKeeper.showSplash();
+}
 
 void ApplicationEngine::initialize() {
-  qDebug() << "Load theme: Mocha";
-  CONFIG.loadTheme(CATPUCCIN_MOCHA);
+  m_baselineMemoryKiB = Metrics::residentMemoryKiB();
+
+  qDebug() << "Theme:" << CONFIG.themeNames().value(CONFIG.themeIndex());
+
+  // Palette-colored items fade, everything else follows the Config colors
+  UI::Palette::instance().reset(CONFIG.theme());
+  QObject::connect(&CONFIG, &Config::themeColorsChanged, &CONFIG, []() {
+    UI::Palette::instance().transitionTo(
+        CONFIG.theme(),
+        qRound(CONFIG.themeTransition() *
+               RenderPolicy::instance().transitionScale()));
+  });
+
+  m_idlePolicy.setTimeout(CONFIG.idleTimeout());
+
+  m_memoryReport.installSignalHandler();
+  m_memoryReport.setInterval(CONFIG.memoryReportInterval());
+  QObject::connect(&CONFIG, &Config::memoryReportIntervalChanged,
+                   &m_memoryReport, [this]() {
+                     m_memoryReport.setInterval(CONFIG.memoryReportInterval());
+                   });
+  m_memoryReport.addAtlas("glyphs", &UI::GlyphCache::instance().atlas());
+  m_memoryReport.addAtlas("tray", &m_trayHost.atlas());
+
+  // Same rounding as IconGlyph, so the prebaked masks are the ones it asks for
+  const qreal ratio = QGuiApplication::primaryScreen() != nullptr
+                          ? QGuiApplication::primaryScreen()->devicePixelRatio()
+                          : 1.0;
+  UI::GlyphCache::instance().prebake(
+      CONFIG.qmlDefaultFontFamily(),
+      qRound(CONFIG.qmlDefaultIconSize() * ratio), CONFIG.qmlPrebakedIcons());
+
+  // Before the QML is loaded, so it starts with the right render policy
+  if (!replaying()) {
+    m_powerController.start(CONFIG.powerSysfsRoot(),
+                            CONFIG.powerUeventSocket());
+  }
+  RenderPolicy::instance().start(m_powerController.getBatteryModel());
+
+  auto refreshPower = [this]() {
+    m_powerController.setRefreshInterval(
+        RenderPolicy::instance().pollInterval(CONFIG.powerRefreshInterval()));
+  };
+  if (!replaying()) {
+    refreshPower();
+    QObject::connect(&CONFIG, &Config::powerRefreshIntervalChanged,
+                     &m_powerController, refreshPower);
+    QObject::connect(&RenderPolicy::instance(), &RenderPolicy::policyChanged,
+                     &m_powerController, refreshPower);
+  }
 
   createMainBar();
+  createNotificationPopup();
+
+  watchConfig();
+
+  // The trace is the only source of updates, the live providers stay off
+  if (replaying()) {
+    startReplay();
+    return;
+  }
+
+  m_snapshotKeeper.setInterval(CONFIG.snapshotInterval());
+  m_snapshotKeeper.attach(m_viewMap.value("MainBar"));
+
+  if (!m_recordPath.isEmpty()) {
+    m_recorder.start(m_recordPath, replayModels());
+  }
+
+  m_compositorController.start(CONFIG.compositorIpc(),
+                               CONFIG.compositorSocket());
+  m_trayHost.start(CONFIG.qmlTrayIconSize());
+  m_mediaController.start(qRound(CONFIG.qmlDefaultBoxSize() * ratio));
+  startUpdateServer();
 }
 
 void ApplicationEngine::showView() {
   for (const auto& viewName : m_viewMap.keys()) {
     const auto& appView = m_viewMap.value(viewName);
     if (appView->autoShow()) {
-      appView->asView().show();
+      appView->show();
     }
   }
 }
 
 void ApplicationEngine::createMainBar() {
   qDebug() << "Setup: MainBar";
-  auto mainView = ApplicationView::Builder()
-                      .withName("MainBar")
-                      .withSample(CONFIG.renderSample())
-                      .withAnchor(LayerShellQt::Window::AnchorTop)
-                      .withLayer(LayerShellQt::Window::LayerBottom)
-                      .withExclusiveZone(CONFIG.height())
-                      .withWidth(CONFIG.width())
-                      .withHeight(CONFIG.height())
-                      .withPositionX(0)
-                      .withPositionY(0)
-                      .withShowByDefault(true)
-                      .create();
+  ApplicationView::Builder builder;
+  builder.withName("MainBar")
+      .withSample(m_renderSettings.lowMemory ? 0 : CONFIG.renderSample())
+      .withAnchor(LayerShellQt::Window::AnchorTop)
+      .withLayer(LayerShellQt::Window::LayerBottom)
+      .withExclusiveZone(CONFIG.height())
+      .withWidth(CONFIG.width())
+      .withHeight(CONFIG.height())
+      .withPositionX(0)
+      .withPositionY(0)
+      .withShowByDefault(true)
+      .withLowMemory(m_renderSettings.lowMemory);
+
+  // Frequently changing regions get their own subsurface, see Main.qml
+  if (CONFIG.splitRegions()) {
+    builder
+        .withRegion("LeftRegion", Qt::AlignLeft | Qt::AlignVCenter,
+                    CONFIG.qmlDefaultPadding())
+        .withRegion("CenterRegion", Qt::AlignHCenter | Qt::AlignVCenter, 0)
+        .withRegion("RightRegion", Qt::AlignRight | Qt::AlignVCenter,
+                    CONFIG.qmlDefaultPadding());
+  }
+
+  auto mainView = builder.create();
+
+  monitorRendering(mainView);
+  m_idlePolicy.watch(mainView);
+  RenderPolicy::instance().watch(&mainView->asView());
+  for (auto* regionView : mainView->regionViews()) {
+    RenderPolicy::instance().watch(regionView);
+  }
+  m_memoryReport.watch(mainView);
 
   qDebug() << "Set context properties for MainBar";
   mainView->asView().rootContext()->setContextProperty(
       "btModel", m_btController.getModel().get());
+  mainView->asView().rootContext()->setContextProperty(
+      "workspaceModel", m_compositorController.getWorkspaceModel().get());
+  mainView->asView().rootContext()->setContextProperty(
+      "titleModel", m_compositorController.getTitleModel().get());
+  mainView->asView().rootContext()->setContextProperty(
+      "batteryModel", m_powerController.getBatteryModel().get());
+  mainView->asView().rootContext()->setContextProperty(
+      "backlightModel", m_powerController.getBacklightModel().get());
+  mainView->asView().rootContext()->setContextProperty(
+      "mediaModel", m_mediaController.getModel().get());
+  mainView->asView().engine()->addImageProvider(
+      "mediaart", new Media::ArtProvider(m_mediaController.getModel()));
+  mainView->asView().rootContext()->setContextProperty("trayHost",
+                                                       &m_trayHost);
+
+  if (CONFIG.splitRegions()) {
+    // Region windows clear to the bar background instead of drawing it
+    mainView->asView().setColor(CONFIG.themeCrust());
+    QObject::connect(&CONFIG, &Config::themeCrustChanged, &mainView->asView(),
+                     [view = &mainView->asView()]() {
+                       view->setColor(CONFIG.themeCrust());
+                     });
+  }
+
+  mainView->loadFromModule("Simbar", "Main");
 
-  mainView->asView().loadFromModule("Simbar", "Main");
+  m_updateDispatcher.addView(&mainView->asView());
+  for (auto* regionView : mainView->regionViews()) {
+    m_updateDispatcher.addView(regionView);
+  }
 
   m_viewMap.insert(mainView->name(), mainView);
 }
 
+void ApplicationEngine::createNotificationPopup() {
+  // A replay owns no bus name, so it can always show what the trace holds
+  if (!CONFIG.notifyServer() && !replaying()) {
+    return;
+  }
+
+  const qreal ratio = QGuiApplication::primaryScreen() != nullptr
+                          ? QGuiApplication::primaryScreen()->devicePixelRatio()
+                          : 1.0;
+  const Notify::Queue::Limits limits{
+      .queueSize = CONFIG.notifyQueueSize(),
+      .maxVisible = CONFIG.notifyMaxVisible(),
+      .minInterval = CONFIG.notifyMinInterval(),
+      .defaultTimeout = CONFIG.notifyTimeout(),
+  };
+  const int imageSize = qRound(CONFIG.qmlNotifyHeight() * ratio);
+  if (replaying()) {
+    m_notifyController.configure(limits, imageSize);
+  } else if (!m_notifyController.start(limits, imageSize)) {
+    return;
+  }
+
+  // One popup for every toast, hidden while empty and sized to its toasts
+  qDebug() << "Setup: Notifications";
+  const int32_t padding = CONFIG.qmlDefaultPadding();
+  m_notificationView =
+      ApplicationView::Builder()
+          .withName("Notifications")
+          .withSample(m_renderSettings.lowMemory ? 0 : CONFIG.renderSample())
+          .withAnchor(LayerShellQt::Window::AnchorTop |
+                      LayerShellQt::Window::AnchorRight)
+          .withMargins(QMargins(0, CONFIG.height() + padding, padding, 0))
+          .withLayer(LayerShellQt::Window::LayerOverlay)
+          .withWidth(CONFIG.qmlNotifyWidth())
+          .withHeight(CONFIG.qmlNotifyHeight())
+          .withShowByDefault(false)
+          .create();
+
+  QQuickView& view = m_notificationView->asView();
+  view.setColor(Qt::transparent);
+  view.rootContext()->setContextProperty(
+      "notifyModel", m_notifyController.getModel().get());
+  view.engine()->addImageProvider(
+      "notify", new Notify::ImageProvider(m_notifyController.getModel()));
+  view.loadFromModule("Simbar", "NotificationPopup");
+
+  monitorRendering(m_notificationView);
+  m_memoryReport.watch(m_notificationView);
+
+  const NotifyModelRef model = m_notifyController.getModel();
+  QObject::connect(
+      model.get(), &Notify::Model::countChanged, &view,
+      [appView = m_notificationView.get(), model = model.get(), padding]() {
+        const int count = model->count();
+        if (count == 0) {
+          appView->asView().hide();
+          return;
+        }
+        appView->resize(CONFIG.qmlNotifyWidth(),
+                        count * (CONFIG.qmlNotifyHeight() + padding) -
+                            padding);
+        appView->show();
+      });
+}
+
+void ApplicationEngine::watchConfig() {
+  if (m_configPath.isEmpty()) {
+    return;
+  }
+
+  QObject::connect(&m_configWatcher, &ConfigFile::Watcher::changed,
+                   &m_configWatcher, [path = m_configPath]() {
+                     qDebug() << "Config: reloading" << path;
+                     const int changed = CONFIG.loadFile(path);
+                     qDebug() << "Config:" << changed << "settings changed";
+                   });
+  m_configWatcher.watch(m_configPath);
+
+  // Everything else follows through bindings, the surfaces are sized here
+  auto resize = [this]() {
+    for (const auto& appView : std::as_const(m_viewMap)) {
+      appView->resize(CONFIG.width(), CONFIG.height());
+    }
+  };
+  QObject::connect(&CONFIG, &Config::widthChanged, &m_configWatcher, resize);
+  QObject::connect(&CONFIG, &Config::heightChanged, &m_configWatcher, resize);
+}
+
+Replay::Models ApplicationEngine::replayModels() const {
+  return {
+      .bluetooth = m_btController.getModel(),
+      .workspaces = m_compositorController.getWorkspaceModel(),
+      .title = m_compositorController.getTitleModel(),
+      .battery = m_powerController.getBatteryModel(),
+      .backlight = m_powerController.getBacklightModel(),
+      .notifications = m_notifyController.getQueue(),
+  };
+}
+
+void ApplicationEngine::startReplay() {
+  const ApplicationViewPtr mainView = m_viewMap.value("MainBar");
+  if (mainView == nullptr) {
+    qWarning() << "Replay: no MainBar view to replay into";
+    // exit() before exec() is ignored, so queue it
+    QTimer::singleShot(0, QCoreApplication::instance(),
+                       []() { QCoreApplication::exit(1); });
+    return;
+  }
+
+  m_replayPlayer.watch(&mainView->asView());
+  for (auto* regionView : mainView->regionViews()) {
+    m_replayPlayer.watch(regionView);
+  }
+  if (m_notificationView) {
+    m_replayPlayer.watch(&m_notificationView->asView());
+  }
+
+  QObject::connect(&m_replayPlayer, &Replay::Player::finished,
+                   QCoreApplication::instance(), &QCoreApplication::quit);
+
+  // Loading the QML and the first frame are not part of the measurement
+  QObject::connect(
+      &mainView->asView(), &QQuickWindow::frameSwapped, &m_replayPlayer,
+      [this]() { m_replayPlayer.start(replayModels()); },
+      Qt::SingleShotConnection);
+}
+
+void ApplicationEngine::startUpdateServer() {
+  const QString path =
+      QDir(QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation))
+          .filePath(CONFIG.ipcSocketName());
+
+  qDebug() << "Setup: update socket";
+  m_updateServer = new Ipc::UpdateServer;
+  m_updateServer->moveToThread(&m_ipcThread);
+  QObject::connect(&m_ipcThread, &QThread::finished, m_updateServer,
+                   &QObject::deleteLater);
+
+  m_updateDispatcher.setServer(m_updateServer);
+
+  m_ipcThread.setObjectName("simbar-ipc");
+  m_ipcThread.start();
+
+  QMetaObject::invokeMethod(
+      m_updateServer,
+      [server = m_updateServer, path]() { server->listen(path); },
+      Qt::QueuedConnection);
+}
+
+void ApplicationEngine::monitorRendering(
+    const ApplicationViewPtr& appView) const {
+  QQuickView& view = appView->asView();
+  const Render::Backend backend = m_renderSettings.backend;
+
+  QObject::connect(&view, &QQuickWindow::sceneGraphError, &view,
+                   [backend](QQuickWindow::SceneGraphError /*unused*/,
+                             const QString& message) {
+                     Render::relaunchWithFallback(backend, message);
+                   });
+
+  // Report what the backend costs once the first frame is on screen
+  const QString name = appView->name();
+  const qint64 baseline = m_baselineMemoryKiB;
+  QObject::connect(
+      &view, &QQuickWindow::frameSwapped, &view,
+      [name, backend, baseline]() {
+        const qint64 resident = Metrics::residentMemoryKiB();
+        qDebug().noquote() << QString("%1: first frame with %2, resident "
+                                      "%3 KiB (+%4 KiB since startup)")
+                                  .arg(name, Render::toString(backend))
+                                  .arg(resident)
+                                  .arg(resident - baseline);
+      },
+      Qt::SingleShotConnection);
+}
+
 // ####################### Config implementation #######################
 
 Config::Config() {
   QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+
+  // Every setting registered itself in its initializer, before this body
+  publish();
 }
 
 Config& Config::instance() {
@@ -71,35 +422,271 @@ Config* Config::create(QQmlEngine* /*unused*/, QJSEngine* /*unused*/) {
   return &instance();
 }
 
+bool Config::registerSetting(const char* key, Setter setter, Getter getter) {
+  m_settings.insert(key, std::move(setter));
+  m_getters.insert(key, std::move(getter));
+  return true;
+}
+
+Config::Batch::Batch(Config& config) : m_config{config} {
+  m_config.m_batchDepth++;
+}
+
+Config::Batch::~Batch() {
+  if (--m_config.m_batchDepth > 0 || m_config.m_deferred.isEmpty()) {
+    return;
+  }
+
+  m_config.publish();
+  const auto deferred = std::exchange(m_config.m_deferred, {});
+  for (const auto notify : deferred) {
+    emit(m_config.*notify)();
+  }
+}
+
+void Config::notifyChanged(void (Config::*notify)()) {
+  if (m_batchDepth > 0) {
+    if (!m_deferred.contains(notify)) {
+      m_deferred.append(notify);
+    }
+    return;
+  }
+
+  publish();
+  emit(this->*notify)();
+}
+
+void Config::publish() {
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->version = ++m_version;
+  snapshot->theme = m_theme;
+  snapshot->themeIndex = m_themeIndex;
+  snapshot->values.reserve(m_getters.size());
+  for (auto it = m_getters.cbegin(); it != m_getters.cend(); ++it) {
+    snapshot->values.insert(it.key(), it.value()());
+  }
+
+  // Readers holding the previous one keep it alive until they drop it
+  std::atomic_store(&m_snapshot, SnapshotPtr(std::move(snapshot)));
+}
+
+int Config::loadFile(const QString& path) {
+  // The whole reload becomes one snapshot
+  const Batch batch(*this);
+
+  QSet<QByteArray> seen;
+  QList<QPair<QString, Theme>> userThemes;
+  int changed = 0;
+
+  // Taken by name, user themes may move when the file is edited
+  const QString activeTheme = themeNames().value(m_themeIndex);
+  const QString configuredTheme = m_themeName;
+
+  const bool found = ConfigFile::read(
+      path, [this, &seen, &userThemes, &changed](QByteArrayView key,
+                                                 QByteArrayView value) {
+        const QByteArray name = key.toByteArray();
+        const auto it = m_settings.constFind(name);
+        if (it == m_settings.cend()) {
+          if (!parseUserTheme(key, value, userThemes)) {
+            qWarning() << "Config: unknown key" << key;
+          }
+          return;
+        }
+
+        seen.insert(name);
+        changed += (*it)(value) ? 1 : 0;
+      });
+
+  if (!found) {
+    qDebug() << "Config: no file at" << path << "- using defaults";
+  }
+
+  // Removed keys fall back to their defaults
+  for (auto it = m_settings.cbegin(); it != m_settings.cend(); ++it) {
+    if (!seen.contains(it.key())) {
+      changed += it.value()(std::nullopt) ? 1 : 0;
+    }
+  }
+
+  if (userThemes != m_userThemes) {
+    m_userThemes = userThemes;
+    notifyChanged(&Config::themeNamesChanged);
+  }
+
+  // A theme picked at runtime survives reloads unless themeName itself was
+  // edited. Re-applying the active theme picks up an edited definition,
+  // unchanged colors stay quiet.
+  int index = m_themeName == configuredTheme ? findTheme(activeTheme) : -1;
+  if (index < 0) {
+    index = findTheme(m_themeName);
+    if (index < 0) {
+      qWarning() << "Config: unknown theme" << m_themeName;
+    }
+  }
+  setThemeIndex(index < 0 ? DEFAULT_THEME_INDEX : index);
+
+  return changed;
+}
+
+bool Config::parseValue(QByteArrayView text, int32_t& value) {
+  bool ok = false;
+  const int parsed = text.toInt(&ok);
+  if (ok) {
+    value = parsed;
+  }
+  return ok;
+}
+
+bool Config::parseValue(QByteArrayView text, bool& value) {
+  if (text == "true" || text == "yes" || text == "1") {
+    value = true;
+    return true;
+  }
+  if (text == "false" || text == "no" || text == "0") {
+    value = false;
+    return true;
+  }
+  return false;
+}
+
+bool Config::parseValue(QByteArrayView text, QString& value) {
+  value = QString::fromUtf8(text);
+  return true;
+}
+
+void Config::warnInvalid(QByteArrayView text) {
+  qWarning() << "Config: invalid value" << text << "- using the default";
+}
+
 void Config::loadTheme(const Theme& theme) {
-  m_themeRosewater = theme.rosewater;
-  m_themeFlamingo = theme.flamingo;
-  m_themePink = theme.pink;
-  m_themeMauve = theme.mauve;
-  m_themeRed = theme.red;
-  m_themeMaroon = theme.maroon;
-  m_themePeach = theme.peach;
-  m_themeYellow = theme.yellow;
-  m_themeGreen = theme.green;
-  m_themeTeal = theme.teal;
-  m_themeSky = theme.sky;
-  m_themeSapphire = theme.sapphire;
-  m_themeBlue = theme.blue;
-  m_themeLavender = theme.lavender;
-
-  m_themeText = theme.text;
-  m_themeSubtext1 = theme.subtext1;
-  m_themeSubtext0 = theme.subtext0;
-  m_themeOverlay2 = theme.overlay2;
-  m_themeOverlay1 = theme.overlay1;
-  m_themeOverlay0 = theme.overlay0;
-  m_themeSurface2 = theme.surface2;
-  m_themeSurface1 = theme.surface1;
-  m_themeSurface0 = theme.surface0;
-
-  m_themeBase = theme.base;
-  m_themeMantle = theme.mantle;
-  m_themeCrust = theme.crust;
-
-  emit themeChanged();
+  const Batch batch(*this);
+
+  const Theme previous = m_theme;
+  m_theme = theme;
+
+  for (std::size_t i = 0; i < COLOR_ROLE_COUNT; i++) {
+    const auto role = static_cast<ColorRole>(i);
+    if (previous.color(role) != theme.color(role)) {
+      notifyChanged(m_colorSignals.at(i));
+    }
+  }
+
+  if (previous != theme) {
+    notifyChanged(&Config::themeColorsChanged);
+  }
+}
+
+void Config::setThemeIndex(const int index) {
+  const int count = static_cast<int>(BUILTIN_THEMES.size()) +
+                    static_cast<int>(m_userThemes.size());
+  if (index < 0 || index >= count) {
+    qWarning() << "Config: no theme with index" << index;
+    return;
+  }
+
+  const Batch batch(*this);
+
+  const auto builtins = static_cast<int>(BUILTIN_THEMES.size());
+  loadTheme(index < builtins ? *BUILTIN_THEMES.at(index).theme
+                             : m_userThemes.at(index - builtins).second);
+
+  if (m_themeIndex != index) {
+    m_themeIndex = index;
+    notifyChanged(&Config::themeIndexChanged);
+  }
+}
+
+QStringList Config::themeNames() const {
+  QStringList names;
+  for (const auto& builtin : BUILTIN_THEMES) {
+    names.append(builtin.name);
+  }
+  for (const auto& [name, theme] : m_userThemes) {
+    names.append(name);
+  }
+  return names;
+}
+
+int Config::findTheme(const QString& name) const {
+  return static_cast<int>(themeNames().indexOf(name));
+}
+
+QVariantList Config::themeColors() const {
+  QVariantList colors;
+  colors.reserve(COLOR_ROLE_COUNT);
+  for (std::size_t i = 0; i < COLOR_ROLE_COUNT; i++) {
+    colors.append(QColor::fromRgba(m_theme.color(static_cast<ColorRole>(i))));
+  }
+  return colors;
+}
+
+bool Config::registerColor(const ColorRole role, const ColorSignal notify) {
+  m_colorSignals.at(static_cast<std::size_t>(role)) = notify;
+  return true;
+}
+
+bool Config::parseUserTheme(QByteArrayView key, QByteArrayView value,
+                            QList<QPair<QString, Theme>>& themes) {
+  if (!key.startsWith("theme.")) {
+    return false;
+  }
+
+  const QByteArrayView rest = key.sliced(6);
+  const qsizetype dot = rest.lastIndexOf('.');
+  if (dot <= 0) {
+    return false;
+  }
+
+  const QString name = QString::fromUtf8(rest.first(dot));
+  const QByteArrayView roleName = rest.sliced(dot + 1);
+
+  std::size_t role = 0;
+  while (role < COLOR_ROLE_COUNT && roleName != COLOR_ROLE_NAMES.at(role)) {
+    role++;
+  }
+  if (role == COLOR_ROLE_COUNT) {
+    return false;
+  }
+
+  QRgb color = 0;
+  if (!parseColor(value, color)) {
+    warnInvalid(value);
+    return true;
+  }
+
+  auto it = std::find_if(themes.begin(), themes.end(),
+                         [&name](const auto& theme) {
+                           return theme.first == name;
+                         });
+  if (it == themes.end()) {
+    themes.append({name, CATPUCCIN_MOCHA});
+    it = std::prev(themes.end());
+  }
+
+  it->second.setColor(static_cast<ColorRole>(role), color);
+  return true;
+}
+
+bool Config::parseColor(QByteArrayView text, QRgb& color) {
+  if (!text.startsWith('#')) {
+    return false;
+  }
+
+  bool ok = false;
+  const uint value = text.sliced(1).toUInt(&ok, 16);
+  if (!ok) {
+    return false;
+  }
+
+  // Same forms QColor accepts, #rrggbb and #aarrggbb
+  if (text.size() == 7) {
+    color = rgb(value);
+    return true;
+  }
+  if (text.size() == 9) {
+    color = value;
+    return true;
+  }
+  return false;
 }
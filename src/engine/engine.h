@@ -2,15 +2,44 @@
 
 #include <LayerShellQt/window.h>
 #include <qquickview.h>
+#include <qthread.h>
 
 #include "appview.h"
+#include "idlepolicy.h"
 #include "src/bluetooth/controller.h"
+#include "src/compositor/controller.h"
+#include "src/config/configfile.h"
+#include "src/ipc/dispatcher.h"
+#include "src/ipc/updateserver.h"
+#include "src/media/controller.h"
+#include "src/metrics/memoryreport.h"
+#include "src/notify/controller.h"
+#include "src/power/controller.h"
+#include "src/render/backend.h"
+#include "src/replay/player.h"
+#include "src/replay/recorder.h"
+#include "src/snapshot/keeper.h"
+#include "src/tray/host.h"
 
 class ApplicationEngine {
 public:
   ApplicationEngine();
   virtual ~ApplicationEngine();
 
+  void setRenderSettings(const Render::Settings& settings);
+  /// Config file to watch, already loaded by the caller
+  void setConfigPath(const QString& path);
+  /// Records the updates going into the models to @p path, see Replay
+  void setRecordPath(const QString& path);
+  /**
+   * Replays the trace at @p path instead of starting the providers, then
+   * quits with a report. No D-Bus name, socket or cached frame is touched.
+   * @return false if @p path is not a readable trace
+   */
+  bool setReplay(const QString& path, double speed);
+
+  /// Puts the cached last frame on screen, call before initialize()
+  void showSplash();
   void initialize();
   void showView();
 
@@ -19,9 +48,44 @@ private:
   // Then put them in initialize()
   // ----------------------------------------------
   void createMainBar();
+  void createNotificationPopup();
   // ----------------------------------------------
 
+  void monitorRendering(const ApplicationViewPtr& appView) const;
+  void startUpdateServer();
+  /// Watches the views and starts the trace once the bar is on screen
+  void startReplay();
+  void watchConfig();
+
+  [[nodiscard]] bool replaying() const { return !m_replayPath.isEmpty(); }
+  [[nodiscard]] Replay::Models replayModels() const;
+
+  Render::Settings m_renderSettings;
+  QString m_configPath;
+  ConfigFile::Watcher m_configWatcher;
+
+  qint64 m_baselineMemoryKiB = -1;
+
+  IdlePolicy m_idlePolicy;
+  Snapshot::Keeper m_snapshotKeeper;
+  Metrics::MemoryReport m_memoryReport;
   BluetoothController m_btController;
+  CompositorController m_compositorController;
+  PowerController m_powerController;
+  MediaController m_mediaController;
+  NotifyController m_notifyController;
+  Tray::Host m_trayHost;
+
+  QString m_recordPath;
+  QString m_replayPath;
+  Replay::Recorder m_recorder;
+  Replay::Player m_replayPlayer;
+
+  QThread m_ipcThread;
+  Ipc::UpdateServer* m_updateServer = nullptr;
+  Ipc::Dispatcher m_updateDispatcher;
 
   QHash<QString, ApplicationViewPtr> m_viewMap;
+  // Not in m_viewMap, it is neither shown at startup nor sized like the bar
+  ApplicationViewPtr m_notificationView;
 };
@@ -0,0 +1,121 @@
+#include "idlepolicy.h"
+#include "memory.h"
+
+#include <qdebug.h>
+#include <qevent.h>
+#include <qlogging.h>
+
+IdlePolicy::IdlePolicy(QObject* parent) : QObject{parent} {}
+
+IdlePolicy::~IdlePolicy() = default;
+
+void IdlePolicy::setTimeout(const int32_t msec) {
+  m_timeout = qMax(0, msec);
+
+  for (auto& state : m_views) {
+    state.quietTimer->setInterval(m_timeout);
+    if (m_timeout == 0) {
+      state.quietTimer->stop();
+    }
+  }
+}
+
+void IdlePolicy::watch(const ApplicationViewPtr& appView) {
+  watch(&appView->asView(), appView->name());
+
+  const auto& regionViews = appView->regionViews();
+  for (qsizetype i = 0; i < regionViews.size(); i++) {
+    watch(regionViews.at(i),
+          appView->name() + "/" + appView->regions().at(i).component);
+  }
+}
+
+void IdlePolicy::watch(QQuickView* view, const QString& name) {
+  Q_ASSERT(!m_views.contains(view));
+
+  view->setPersistentGraphics(false);
+  view->setPersistentSceneGraph(false);
+  view->installEventFilter(this);
+
+  ViewState state;
+  state.name = name;
+  state.quietTimer = new QTimer(this);
+  state.quietTimer->setSingleShot(true);
+  state.quietTimer->setInterval(m_timeout);
+
+  connect(state.quietTimer, &QTimer::timeout, this,
+          [this, view]() { enterIdle(view, "quiet period elapsed"); });
+
+  // frameSwapped comes from the render thread, this queues it to ours
+  connect(view, &QQuickWindow::frameSwapped, this,
+          [this, view]() { onFrameSwapped(view); });
+
+  connect(view, &QObject::destroyed, this, [this, view]() {
+    delete m_views.value(view).quietTimer;
+    m_views.remove(view);
+  });
+
+  m_views.insert(view, state);
+}
+
+bool IdlePolicy::eventFilter(QObject* watched, QEvent* event) {
+  if (event->type() == QEvent::Expose) {
+    auto* view = static_cast<QQuickView*>(watched);
+    auto it = m_views.find(view);
+
+    if (it != m_views.end() && it->exposed != view->isExposed()) {
+      it->exposed = view->isExposed();
+
+      if (!it->exposed) {
+        // Output off or fully occluded: Qt skips rendering unexposed windows
+        // already, make sure nothing is held for them meanwhile
+        it->quietTimer->stop();
+        enterIdle(view, "surface not exposed");
+      } else {
+        qDebug() << it->name << "exposed, rendering";
+      }
+    }
+  }
+
+  return QObject::eventFilter(watched, event);
+}
+
+void IdlePolicy::onFrameSwapped(QQuickView* view) {
+  auto it = m_views.find(view);
+  if (it == m_views.end()) {
+    return;
+  }
+
+  if (it->idle) {
+    it->idle = false;
+    qDebug() << it->name << "left idle, resident"
+             << Metrics::residentMemoryKiB() << "KiB";
+  }
+
+  if (m_timeout > 0) {
+    it->quietTimer->start();
+  }
+}
+
+void IdlePolicy::enterIdle(QQuickView* view, const char* reason) {
+  auto it = m_views.find(view);
+  if (it == m_views.end() || it->idle) {
+    return;
+  }
+
+  it->idle = true;
+
+  const qint64 before = Metrics::residentMemoryKiB();
+  view->releaseResources();
+
+  // The release happens on the render thread at its next opportunity, sample
+  // the result a little later
+  const QString name = it->name;
+  QTimer::singleShot(500, this, [name, before, reason]() {
+    const qint64 after = Metrics::residentMemoryKiB();
+    qDebug().noquote() << QString("%1 idle (%2): resident %3 KiB -> %4 KiB")
+                              .arg(name, reason)
+                              .arg(before)
+                              .arg(after);
+  });
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <qhash.h>
+#include <qobject.h>
+#include <qquickview.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+#include "appview.h"
+
+/**
+ * @class IdlePolicy
+ * @brief Releases scene graph and GPU resources of views that stop changing.
+ *
+ * Every watched view restarts its quiet-period timer on each swapped frame.
+ * When the timer fires the view is considered idle and asked to release what
+ * it can rebuild (QQuickWindow::releaseResources drops glyph caches, unused
+ * textures and, with the threaded loop, the scene graph nodes). The next
+ * update rebuilds them transparently.
+ *
+ * Views are also switched to non-persistent graphics and scene graph, so when
+ * an output is turned off or the surface is fully occluded (window no longer
+ * exposed) Qt stops rendering it and may drop its graphics resources.
+ */
+class IdlePolicy final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit IdlePolicy(QObject* parent = nullptr);
+  ~IdlePolicy() override;
+
+  /**
+   * @brief Sets the quiet period after which a view becomes idle.
+   * @param msec Quiet period in milliseconds, 0 disables idle release.
+   */
+  void setTimeout(int32_t msec);
+
+  void watch(const ApplicationViewPtr& appView);
+  void watch(QQuickView* view, const QString& name);
+
+protected:
+  bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+  struct ViewState {
+    QString name;
+    QTimer* quietTimer = nullptr;
+    bool idle = false;
+    bool exposed = false;
+  };
+
+  void onFrameSwapped(QQuickView* view);
+  void enterIdle(QQuickView* view, const char* reason);
+
+  int32_t m_timeout = 0;
+  QHash<QQuickView*, ViewState> m_views;
+};
@@ -0,0 +1,132 @@
+#include "renderpolicy.h"
+#include "config.h"
+#include "wakeups.h"
+
+#include <algorithm>
+#include <qdebug.h>
+#include <qlogging.h>
+
+namespace {
+
+constexpr int kSampleMs = 60000;
+
+} // namespace
+
+RenderPolicy::RenderPolicy() {
+  QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+
+  m_sampleTimer.setTimerType(Qt::VeryCoarseTimer);
+  m_sampleTimer.setInterval(kSampleMs);
+  connect(&m_sampleTimer, &QTimer::timeout, this, &RenderPolicy::sample);
+}
+
+RenderPolicy& RenderPolicy::instance() {
+  static RenderPolicy self;
+  return self;
+}
+
+RenderPolicy* RenderPolicy::create(QQmlEngine* /*unused*/,
+                                   QJSEngine* /*unused*/) {
+  return &instance();
+}
+
+void RenderPolicy::start(const BatteryModelRef& model) {
+  m_batteryModel = model;
+
+  connect(model.get(), &Power::BatteryModel::onAcChanged, this,
+          &RenderPolicy::update);
+  connect(model.get(), &Power::BatteryModel::presentChanged, this,
+          &RenderPolicy::update);
+
+  // Every setting only changes what saving means, or whether it is on
+  for (const auto changed :
+       {&Config::powerSaveModeChanged, &Config::powerSaveFpsChanged,
+        &Config::powerSaveScrambleChanged, &Config::powerSavePollScaleChanged}) {
+    connect(&CONFIG, changed, this, &RenderPolicy::update);
+  }
+
+  m_lastWakeups = Metrics::voluntaryContextSwitches();
+  m_sampleTimer.start();
+  update();
+}
+
+void RenderPolicy::watch(QQuickWindow* window) {
+  // Counted on the render thread, a queued slot would cost a wakeup a frame
+  connect(
+      window, &QQuickWindow::frameSwapped, this,
+      [this]() { m_frames.fetch_add(1, std::memory_order_relaxed); },
+      Qt::DirectConnection);
+}
+
+int RenderPolicy::animationFps() const {
+  return m_saving ? std::max(1, CONFIG.powerSaveFps()) : 0;
+}
+
+double RenderPolicy::scrambleScale() const {
+  return m_saving ? std::clamp(CONFIG.powerSaveScramble() / 100.0, 0.0, 1.0)
+                  : 1.0;
+}
+
+double RenderPolicy::transitionScale() const { return m_saving ? 0.0 : 1.0; }
+
+double RenderPolicy::pollScale() const {
+  return m_saving ? std::max(1, CONFIG.powerSavePollScale()) : 1.0;
+}
+
+int RenderPolicy::pollInterval(const int base) const {
+  return static_cast<int>(base * pollScale());
+}
+
+void RenderPolicy::update() {
+  const QString mode = CONFIG.powerSaveMode();
+  bool saving = false;
+  if (mode == "on") {
+    saving = true;
+  } else if (mode == "auto") {
+    saving = m_batteryModel != nullptr && m_batteryModel->present() &&
+             !m_batteryModel->onAc();
+  }
+
+  if (saving != m_saving) {
+    logAverages(m_saving ? "saving" : "full");
+    m_saving = saving;
+    qDebug() << "RenderPolicy:" << (m_saving ? "saving power" : "full rate");
+  }
+
+  // Settings may have changed the saving values, notify either way
+  emit policyChanged();
+}
+
+void RenderPolicy::sample() {
+  const int64_t frames = m_frames.load(std::memory_order_relaxed);
+  const qint64 wakeups = Metrics::voluntaryContextSwitches();
+
+  m_framesPerMinute = static_cast<int>(frames - m_lastFrames);
+  m_wakeupsPerMinute =
+      m_lastWakeups >= 0 && wakeups >= 0
+          ? static_cast<int>(wakeups - m_lastWakeups)
+          : 0;
+  m_lastFrames = frames;
+  m_lastWakeups = wakeups;
+
+  m_modeFrames += m_framesPerMinute;
+  m_modeWakeups += m_wakeupsPerMinute;
+  m_modeMinutes++;
+
+  emit statsChanged();
+}
+
+void RenderPolicy::logAverages(const char* mode) {
+  if (m_modeMinutes == 0) {
+    return;
+  }
+  qDebug().noquote() << QString("RenderPolicy: %1 mode averaged %2 frames/min, "
+                                "%3 wakeups/min over %4 min")
+                            .arg(mode)
+                            .arg(m_modeFrames / m_modeMinutes)
+                            .arg(m_modeWakeups / m_modeMinutes)
+                            .arg(m_modeMinutes);
+  m_modeFrames = 0;
+  m_modeWakeups = 0;
+  m_modeMinutes = 0;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <qobject.h>
+#include <qqmlengine.h>
+#include <qqmlintegration.h>
+#include <qquickwindow.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+#include "src/power/batterymodel.h"
+
+/**
+ * @class RenderPolicy
+ * @brief How much the bar may animate, decided by power source and settings.
+ *
+ * Saving is on while on battery (powerSaveMode auto), or forced on or off.
+ * While saving, animations step at no more than animationFps, text scrambles
+ * are shortened by scrambleScale (0 makes them instant), theme transitions
+ * are instant and polling intervals are stretched by pollScale. QML binds to
+ * these properties and C++ consumers follow policyChanged(), so a switch
+ * takes effect live.
+ *
+ * Frames and wakeups are counted per minute, and the averages of the
+ * previous mode are logged on every switch, which shows what saving saves.
+ */
+class RenderPolicy final : public QObject {
+  Q_OBJECT
+  QML_ELEMENT
+  QML_SINGLETON
+
+  Q_PROPERTY(bool saving READ saving NOTIFY policyChanged)
+  /// Step rate of stepped animations, 0 for every frame
+  Q_PROPERTY(int animationFps READ animationFps NOTIFY policyChanged)
+  Q_PROPERTY(double scrambleScale READ scrambleScale NOTIFY policyChanged)
+  Q_PROPERTY(double transitionScale READ transitionScale NOTIFY policyChanged)
+  Q_PROPERTY(double pollScale READ pollScale NOTIFY policyChanged)
+  Q_PROPERTY(int framesPerMinute READ framesPerMinute NOTIFY statsChanged)
+  Q_PROPERTY(int wakeupsPerMinute READ wakeupsPerMinute NOTIFY statsChanged)
+
+public:
+  static RenderPolicy& instance();
+  static RenderPolicy* create(QQmlEngine* /*unused*/, QJSEngine* /*unused*/);
+
+  /// Follows the AC state of @p model, and the power settings of CONFIG
+  void start(const BatteryModelRef& model);
+  /// Counts the frames of @p window
+  void watch(QQuickWindow* window);
+
+  [[nodiscard]] bool saving() const { return m_saving; }
+  [[nodiscard]] int animationFps() const;
+  [[nodiscard]] double scrambleScale() const;
+  [[nodiscard]] double transitionScale() const;
+  [[nodiscard]] double pollScale() const;
+
+  /// @p base milliseconds stretched by pollScale
+  Q_INVOKABLE int pollInterval(int base) const;
+
+  [[nodiscard]] int framesPerMinute() const { return m_framesPerMinute; }
+  [[nodiscard]] int wakeupsPerMinute() const { return m_wakeupsPerMinute; }
+
+signals:
+  void policyChanged();
+  void statsChanged();
+
+private:
+  RenderPolicy();
+
+  void update();
+  void sample();
+  void logAverages(const char* mode);
+
+  BatteryModelRef m_batteryModel;
+  bool m_saving = false;
+
+  std::atomic<int64_t> m_frames{0};
+  QTimer m_sampleTimer;
+  int64_t m_lastFrames = 0;
+  qint64 m_lastWakeups = -1;
+  int m_framesPerMinute = 0;
+  int m_wakeupsPerMinute = 0;
+
+  // Totals since the last switch, for the averages logged on the next one
+  int64_t m_modeFrames = 0;
+  int64_t m_modeWakeups = 0;
+  int m_modeMinutes = 0;
+};
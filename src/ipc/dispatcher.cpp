@@ -0,0 +1,97 @@
+#include "dispatcher.h"
+#include "updateserver.h"
+
+#include <qcolor.h>
+#include <qdebug.h>
+#include <qlogging.h>
+#include <qquickitem.h>
+
+namespace Ipc {
+
+namespace {
+
+constexpr int kFrameIntervalMs = 16;
+
+} // namespace
+
+Dispatcher::Dispatcher(QObject* parent) : QObject{parent} {
+  m_frameTimer.setSingleShot(true);
+  m_frameTimer.setInterval(kFrameIntervalMs);
+  m_frameTimer.setTimerType(Qt::PreciseTimer);
+
+  connect(&m_frameTimer, &QTimer::timeout, this, &Dispatcher::flush);
+}
+
+Dispatcher::~Dispatcher() = default;
+
+void Dispatcher::setServer(UpdateServer* server) {
+  m_server = server;
+
+  // Queued: the server emits from its own thread
+  connect(m_server, &UpdateServer::updatesPending, this, &Dispatcher::schedule,
+          Qt::QueuedConnection);
+}
+
+void Dispatcher::addView(QQuickView* view) { m_views.append(view); }
+
+void Dispatcher::schedule() {
+  if (!m_frameTimer.isActive()) {
+    m_frameTimer.start();
+  }
+}
+
+void Dispatcher::flush() {
+  if (m_server == nullptr) {
+    return;
+  }
+
+  const UpdateBatch batch = m_server->takePending();
+
+  for (auto it = batch.cbegin(); it != batch.cend(); ++it) {
+    QObject* widget = findWidget(it.key().widgetId);
+    if (widget == nullptr) {
+      qWarning() << "Update socket: no widget named" << it.key().widgetId;
+      continue;
+    }
+
+    apply(widget, it.key().property, it.value());
+  }
+}
+
+QObject* Dispatcher::findWidget(const QString& widgetId) {
+  if (const auto cached = m_widgets.value(widgetId); cached != nullptr) {
+    return cached;
+  }
+
+  for (const auto& view : std::as_const(m_views)) {
+    if (view == nullptr || view->rootObject() == nullptr) {
+      continue;
+    }
+
+    if (auto* widget = view->rootObject()->findChild<QObject*>(widgetId)) {
+      m_widgets.insert(widgetId, widget);
+      return widget;
+    }
+  }
+
+  return nullptr;
+}
+
+void Dispatcher::apply(QObject* widget, const Property property,
+                       const QVariant& value) {
+  switch (property) {
+  case Property::Text:
+    QMetaObject::invokeMethod(widget, "updateText", Q_ARG(QVariant, value));
+    break;
+  case Property::Color:
+    // A palette role would win over the color, the widget leaves the theme
+    widget->setProperty("iconBoxRole", -1);
+    widget->setProperty("iconBoxColor", value);
+    break;
+  case Property::Visible:
+    widget->setProperty("visible", value);
+    break;
+  }
+}
+
+} // namespace Ipc
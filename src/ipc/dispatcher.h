@@ -0,0 +1,49 @@
+#pragma once
+
+#include <qhash.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qquickview.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+#include "src/ipc/protocol.h"
+
+namespace Ipc {
+
+class UpdateServer;
+
+/**
+ * @class Dispatcher
+ * @brief Applies pending socket updates to widgets on the GUI thread.
+ *
+ * Widgets are looked up by objectName in the root objects of the added views
+ * and cached. Pending updates are collected at most once per frame interval,
+ * however often the server signals.
+ */
+class Dispatcher final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit Dispatcher(QObject* parent = nullptr);
+  ~Dispatcher() override;
+
+  void setServer(UpdateServer* server);
+  void addView(QQuickView* view);
+
+private:
+  void schedule();
+  void flush();
+
+  [[nodiscard]] QObject* findWidget(const QString& widgetId);
+  static void apply(QObject* widget, Property property, const QVariant& value);
+
+  UpdateServer* m_server = nullptr;
+  QTimer m_frameTimer;
+
+  QList<QPointer<QQuickView>> m_views;
+  QHash<QString, QPointer<QObject>> m_widgets;
+};
+
+} // namespace Ipc
@@ -0,0 +1,91 @@
+#include "protocol.h"
+
+#include <qendian.h>
+
+namespace Ipc {
+
+namespace {
+
+class Reader {
+public:
+  explicit Reader(QByteArrayView data) : m_data{data} {}
+
+  template <typename T> bool read(T& value) {
+    if (m_offset + sizeof(T) > static_cast<size_t>(m_data.size())) {
+      return false;
+    }
+    value = qFromLittleEndian<T>(m_data.data() + m_offset);
+    m_offset += sizeof(T);
+    return true;
+  }
+
+  bool read(QByteArrayView& view, size_t size) {
+    if (m_offset + size > static_cast<size_t>(m_data.size())) {
+      return false;
+    }
+    view = m_data.sliced(static_cast<qsizetype>(m_offset),
+                         static_cast<qsizetype>(size));
+    m_offset += size;
+    return true;
+  }
+
+  [[nodiscard]] bool atEnd() const {
+    return m_offset == static_cast<size_t>(m_data.size());
+  }
+
+private:
+  QByteArrayView m_data;
+  size_t m_offset = 0;
+};
+
+} // namespace
+
+bool decodeBatch(QByteArrayView payload, UpdateBatch& batch) {
+  Reader reader(payload);
+
+  uint16_t count = 0;
+  if (!reader.read(count)) {
+    return false;
+  }
+
+  for (uint16_t i = 0; i < count; i++) {
+    uint8_t property = 0;
+    uint8_t idLength = 0;
+    uint16_t valueLength = 0;
+    QByteArrayView id;
+    QByteArrayView value;
+
+    if (!reader.read(property) || !reader.read(idLength) ||
+        !reader.read(id, idLength) || !reader.read(valueLength) ||
+        !reader.read(value, valueLength)) {
+      return false;
+    }
+
+    UpdateKey key{QString::fromUtf8(id), static_cast<Property>(property)};
+
+    switch (key.property) {
+    case Property::Text:
+      batch.insert(key, QVariant(QString::fromUtf8(value)));
+      break;
+    case Property::Color:
+      if (value.size() != sizeof(uint32_t)) {
+        return false;
+      }
+      batch.insert(key, QVariant::fromValue(QColor::fromRgba(
+                            qFromLittleEndian<uint32_t>(value.data()))));
+      break;
+    case Property::Visible:
+      if (value.size() != 1) {
+        return false;
+      }
+      batch.insert(key, QVariant(value.at(0) != 0));
+      break;
+    default:
+      return false;
+    }
+  }
+
+  return reader.atEnd();
+}
+
+} // namespace Ipc
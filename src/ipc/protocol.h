@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <qbytearrayview.h>
+#include <qcolor.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qstring.h>
+#include <qvariant.h>
+
+/**
+ * Widget update protocol, spoken over the engine's Unix-domain socket.
+ *
+ * A client sends any number of frames. Every frame is one batch:
+ *
+ *   frame  := u32 payloadLength, payload          (payloadLength <= 64 KiB)
+ *   payload:= u16 count, record * count
+ *   record := u8 property, u8 idLength, id, u16 valueLength, value
+ *
+ * All integers are little endian, ids are the widget's objectName in UTF-8.
+ * Values by property:
+ *   Text    : UTF-8 text, animated like TextBaseWidget.updateText()
+ *   Color   : u32 0xAARRGGBB applied to the widget's iconBoxColor, replacing
+ *             its palette role
+ *   Visible : u8, 0 hides the widget
+ *
+ * A malformed frame closes the connection.
+ */
+namespace Ipc {
+
+enum class Property : uint8_t {
+  Text = 0,
+  Color = 1,
+  Visible = 2,
+};
+
+constexpr uint32_t kMaxFrameSize = 64 * 1024;
+
+struct UpdateKey {
+  QString widgetId;
+  Property property;
+
+  bool operator==(const UpdateKey& other) const {
+    return property == other.property && widgetId == other.widgetId;
+  }
+};
+
+inline size_t qHash(const UpdateKey& key, size_t seed = 0) {
+  return qHashMulti(seed, key.widgetId, static_cast<uint8_t>(key.property));
+}
+
+/// Pending updates, the latest value per widget and property wins
+using UpdateBatch = QHash<UpdateKey, QVariant>;
+
+/**
+ * @brief Decodes one frame payload into @p batch.
+ * @return false if the payload is malformed. @p batch may then already
+ * hold some of its records, decode into an empty batch to discard them.
+ */
+bool decodeBatch(QByteArrayView payload, UpdateBatch& batch);
+
+} // namespace Ipc
@@ -0,0 +1,118 @@
+#include "updateserver.h"
+
+#include <qdebug.h>
+#include <qendian.h>
+#include <qlogging.h>
+#include <utility>
+
+namespace Ipc {
+
+UpdateServer::UpdateServer(QObject* parent) : QObject{parent} {}
+
+UpdateServer::~UpdateServer() = default;
+
+void UpdateServer::listen(const QString& path) {
+  Q_ASSERT(m_server == nullptr);
+
+  m_server = new QLocalServer(this);
+  m_server->setSocketOptions(QLocalServer::UserAccessOption);
+
+  connect(m_server, &QLocalServer::newConnection, this,
+          &UpdateServer::onNewConnection);
+
+  QLocalServer::removeServer(path);
+  if (!m_server->listen(path)) {
+    qWarning() << "Update socket: cannot listen on" << path << "-"
+               << m_server->errorString();
+    return;
+  }
+
+  qDebug() << "Update socket listening on" << path;
+}
+
+UpdateBatch UpdateServer::takePending() {
+  QMutexLocker locker(&m_pendingMutex);
+  return std::exchange(m_pending, {});
+}
+
+void UpdateServer::onNewConnection() {
+  while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+    m_clients.insert(socket, {});
+
+    connect(socket, &QLocalSocket::readyRead, this,
+            [this, socket]() { onReadyRead(socket); });
+    connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+      m_clients.remove(socket);
+      socket->deleteLater();
+    });
+  }
+}
+
+void UpdateServer::onReadyRead(QLocalSocket* socket) {
+  auto it = m_clients.find(socket);
+  if (it == m_clients.end()) {
+    return;
+  }
+
+  Client& client = *it;
+  client.buffer.append(socket->readAll());
+
+  UpdateBatch decoded;
+  bool malformed = false;
+
+  // Decode every complete frame straight out of the receive buffer
+  while (client.buffer.size() - client.offset >=
+         static_cast<qsizetype>(sizeof(uint32_t))) {
+    const auto length = qFromLittleEndian<uint32_t>(client.buffer.constData() +
+                                                    client.offset);
+    if (length > kMaxFrameSize) {
+      malformed = true;
+      break;
+    }
+
+    const qsizetype frameSize = sizeof(uint32_t) + length;
+    if (client.buffer.size() - client.offset < frameSize) {
+      break;
+    }
+
+    const QByteArrayView payload(client.buffer.constData() + client.offset +
+                                     sizeof(uint32_t),
+                                 length);
+    // A malformed frame may have decoded some records already, none of it
+    // is applied
+    UpdateBatch frame;
+    if (!decodeBatch(payload, frame)) {
+      malformed = true;
+      break;
+    }
+    decoded.insert(frame);
+
+    client.offset += frameSize;
+  }
+
+  // Compact once per read instead of once per frame
+  if (client.offset > 0) {
+    client.buffer.remove(0, client.offset);
+    client.offset = 0;
+  }
+
+  if (!decoded.isEmpty()) {
+    bool wasEmpty = false;
+    {
+      QMutexLocker locker(&m_pendingMutex);
+      wasEmpty = m_pending.isEmpty();
+      m_pending.insert(decoded);
+    }
+
+    if (wasEmpty) {
+      emit updatesPending();
+    }
+  }
+
+  if (malformed) {
+    qWarning() << "Update socket: malformed frame, dropping client";
+    socket->abort();
+  }
+}
+
+} // namespace Ipc
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <qhash.h>
+#include <qlocalserver.h>
+#include <qlocalsocket.h>
+#include <qmutex.h>
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+#include "src/ipc/protocol.h"
+
+namespace Ipc {
+
+/**
+ * @class UpdateServer
+ * @brief Accepts widget update batches on a Unix-domain socket.
+ *
+ * Meant to live on its own thread: reading and decoding never touch the GUI
+ * thread. Decoded records are merged into one pending batch, keeping only the
+ * latest value per widget and property, so a client sending thousands of
+ * updates per second costs the GUI thread one batch per frame at most.
+ *
+ * updatesPending() is emitted when the pending batch goes from empty to
+ * non-empty; the consumer then calls takePending() from its own thread.
+ */
+class UpdateServer final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit UpdateServer(QObject* parent = nullptr);
+  ~UpdateServer() override;
+
+  /// Starts listening on @p path, replacing a stale socket file
+  void listen(const QString& path);
+
+  /// Thread-safe, hands over everything received since the last call
+  [[nodiscard]] UpdateBatch takePending();
+
+signals:
+  void updatesPending();
+
+private:
+  struct Client {
+    QByteArray buffer;
+    qsizetype offset = 0;
+  };
+
+  void onNewConnection();
+  void onReadyRead(QLocalSocket* socket);
+
+  QLocalServer* m_server = nullptr;
+  QHash<QLocalSocket*, Client> m_clients;
+
+  QMutex m_pendingMutex;
+  UpdateBatch m_pending;
+};
+
+} // namespace Ipc
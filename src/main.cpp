@@ -1,14 +1,120 @@
+#include <cstring>
+#include <qcommandlineparser.h>
+#include <qdebug.h>
 #include <qguiapplication.h>
-#include <qquickwindow.h>
 
+#include "config.h"
+#include "config/configfile.h"
 #include "engine/engine.h"
+#include "render/backend.h"
+
+namespace {
+
+/// The platform has to be chosen before the application exists
+bool wantsReplay(int argc, char* argv[]) {
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--replay") == 0 ||
+        std::strncmp(argv[i], "--replay=", 9) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
 
 int main(int argc, char* argv[]) {
+  // A replay is a benchmark, it runs headless unless told otherwise
+  const bool replay = wantsReplay(argc, argv);
+  if (replay && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+
   QGuiApplication app(argc, argv);
 
-  QQuickWindow::setGraphicsApi(QSGRendererInterface::VulkanRhi);
+  QCommandLineParser parser;
+  parser.addHelpOption();
+
+  const QCommandLineOption configOption(
+      {"c", "config"}, "Config file, reloaded whenever it changes.", "path",
+      ConfigFile::defaultPath());
+  const QCommandLineOption backendOption(
+      {"b", "backend"},
+      "Render backend: auto, vulkan, opengl or software. Overrides the "
+      "renderBackend setting.",
+      "backend");
+  const QCommandLineOption lowMemoryOption(
+      "low-memory",
+      "Use the software renderer (unless a backend is given) and minimal "
+      "surface buffers.");
+
+  const QCommandLineOption recordOption(
+      "record", "Record the updates going into the models to a trace file.",
+      "path");
+  const QCommandLineOption replayOption(
+      "replay",
+      "Replay a recorded trace headless instead of starting the providers, "
+      "then print CPU time, frames, allocations and update latency.",
+      "path");
+  const QCommandLineOption replaySpeedOption(
+      "replay-speed",
+      "Speed factor of the replay, 0 for as fast as possible. Default 1.",
+      "factor", "1");
+
+  parser.addOption(configOption);
+  parser.addOption(backendOption);
+  parser.addOption(lowMemoryOption);
+  parser.addOption(recordOption);
+  parser.addOption(replayOption);
+  parser.addOption(replaySpeedOption);
+  parser.process(app);
 
+  if (parser.isSet(recordOption) && parser.isSet(replayOption)) {
+    qCritical() << "--record and --replay cannot be combined";
+    return 1;
+  }
+
+  const QString configPath = parser.value(configOption);
+  CONFIG.loadFile(configPath);
+
+  // Before probing render backends, the cached frame needs none of them
   ApplicationEngine engine;
+  engine.setConfigPath(configPath);
+
+  if (replay) {
+    bool ok = false;
+    const double speed = parser.value(replaySpeedOption).toDouble(&ok);
+    if (!ok || speed < 0) {
+      qCritical() << "--replay-speed needs a factor of 0 or more";
+      return 1;
+    }
+    if (!engine.setReplay(parser.value(replayOption), speed)) {
+      return 1;
+    }
+  }
+  if (parser.isSet(recordOption)) {
+    engine.setRecordPath(parser.value(recordOption));
+  }
+
+  engine.showSplash();
+
+  // Offscreen has no GPU surface, and numbers should not depend on one
+  QString backend =
+      replay ? QStringLiteral("software") : CONFIG.renderBackend();
+  if (parser.isSet(backendOption)) {
+    backend = parser.value(backendOption);
+  }
+
+  Render::Settings renderSettings{
+      .backend = Render::fromString(backend),
+      .lowMemory = parser.isSet(lowMemoryOption) || CONFIG.renderLowMemory(),
+  };
+  renderSettings.backend = Render::select(renderSettings);
+  Render::apply(renderSettings.backend);
+
+  qDebug() << "Render backend:" << Render::toString(renderSettings.backend);
+
+  engine.setRenderSettings(renderSettings);
 
   engine.initialize();
   engine.showView();
@@ -0,0 +1,122 @@
+#include "artloader.h"
+
+#include <algorithm>
+#include <qbuffer.h>
+#include <qimagereader.h>
+#include <qnetworkreply.h>
+#include <qnetworkrequest.h>
+#include <qurl.h>
+
+namespace Media {
+
+namespace {
+
+/// Cache budget in KiB, QCache costs are per image
+constexpr int kCacheKiB = 2048;
+
+QImage decodeScaled(QImageReader& reader, const int size) {
+  reader.setAutoTransform(true);
+  const QSize original = reader.size();
+  if (original.isValid() &&
+      (original.width() > size || original.height() > size)) {
+    reader.setScaledSize(original.scaled(size, size, Qt::KeepAspectRatio));
+  }
+
+  QImage image = reader.read();
+  if (image.isNull()) {
+    return image;
+  }
+  // Formats without scaled decoding return the full image
+  if (image.width() > size || image.height() > size) {
+    image = image.scaled(size, size, Qt::KeepAspectRatio,
+                         Qt::SmoothTransformation);
+  }
+  return image.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+}
+
+} // namespace
+
+ArtLoader::ArtLoader(QObject* parent) : QObject{parent}, m_cache{kCacheKiB} {
+  m_pool.setMaxThreadCount(1);
+}
+
+ArtLoader::~ArtLoader() {
+  // Decodes finish into queued calls on this object, which die with it
+  m_pool.clear();
+  m_pool.waitForDone();
+}
+
+void ArtLoader::setSize(const int size) {
+  if (size == m_size) {
+    return;
+  }
+  m_size = size;
+  m_cache.clear();
+}
+
+void ArtLoader::load(const QString& url) {
+  if (const QImage* cached = m_cache.object(url); cached != nullptr) {
+    emit loaded(url, *cached);
+    return;
+  }
+  if (m_pending.contains(url)) {
+    return;
+  }
+
+  const QUrl parsed(url);
+  if (parsed.isLocalFile()) {
+    m_pending.insert(url);
+    decode(url, QByteArray(), parsed.toLocalFile());
+    return;
+  }
+
+  if (parsed.scheme() != "http" && parsed.scheme() != "https") {
+    emit loaded(url, QImage());
+    return;
+  }
+
+  if (m_network == nullptr) {
+    m_network = new QNetworkAccessManager(this);
+  }
+  m_pending.insert(url);
+  QNetworkReply* reply = m_network->get(QNetworkRequest(parsed));
+  connect(reply, &QNetworkReply::finished, this, [this, url, reply]() {
+    reply->deleteLater();
+    if (reply->error() != QNetworkReply::NoError) {
+      finish(url, QImage());
+      return;
+    }
+    decode(url, reply->readAll(), QString());
+  });
+}
+
+void ArtLoader::decode(const QString& url, QByteArray data,
+                       const QString& path) {
+  m_pool.start([this, url, data = std::move(data), path, size = m_size]() {
+    QImage image;
+    if (path.isEmpty()) {
+      QBuffer buffer;
+      buffer.setData(data);
+      QImageReader reader(&buffer);
+      image = decodeScaled(reader, size);
+    } else {
+      QImageReader reader(path);
+      image = decodeScaled(reader, size);
+    }
+
+    QMetaObject::invokeMethod(
+        this, [this, url, image]() { finish(url, image); },
+        Qt::QueuedConnection);
+  });
+}
+
+void ArtLoader::finish(const QString& url, const QImage& image) {
+  m_pending.remove(url);
+  if (!image.isNull()) {
+    m_cache.insert(url, new QImage(image),
+                   std::max<int>(1, static_cast<int>(image.sizeInBytes() / 1024)));
+  }
+  emit loaded(url, image);
+}
+
+} // namespace Media
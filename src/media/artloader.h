@@ -0,0 +1,51 @@
+#pragma once
+
+#include <qcache.h>
+#include <qimage.h>
+#include <qnetworkaccessmanager.h>
+#include <qobject.h>
+#include <qset.h>
+#include <qstring.h>
+#include <qthreadpool.h>
+#include <qtmetamacros.h>
+
+namespace Media {
+
+/**
+ * @class ArtLoader
+ * @brief Decodes album art off the GUI thread, downscaled once.
+ *
+ * The decoder is asked for the target size directly, so a large JPEG cover is
+ * decoded at a fraction of its size instead of decoded in full and scaled.
+ * Results are cached by URL, a track coming back costs nothing. Remote art is
+ * fetched first, then decoded the same way.
+ */
+class ArtLoader final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit ArtLoader(QObject* parent = nullptr);
+  ~ArtLoader() override;
+
+  /// Images fit into @p size x @p size device pixels
+  void setSize(int size);
+
+  /// Emits loaded() once the image for @p url is ready, at once if cached
+  void load(const QString& url);
+
+signals:
+  /// @p image is null if the art could not be read
+  void loaded(const QString& url, const QImage& image);
+
+private:
+  void decode(const QString& url, QByteArray data, const QString& path);
+  void finish(const QString& url, const QImage& image);
+
+  int m_size = 64;
+  QCache<QString, QImage> m_cache;
+  QSet<QString> m_pending;
+  QThreadPool m_pool;
+  QNetworkAccessManager* m_network = nullptr;
+};
+
+} // namespace Media
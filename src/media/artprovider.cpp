@@ -0,0 +1,18 @@
+#include "media/artprovider.h"
+
+namespace Media {
+
+ArtProvider::ArtProvider(MediaModelRef model)
+    : QQuickImageProvider{QQuickImageProvider::Image},
+      m_model{std::move(model)} {}
+
+QImage ArtProvider::requestImage(const QString& /*id*/, QSize* size,
+                                 const QSize& /*requestedSize*/) {
+  QImage image = m_model->art();
+  if (size != nullptr) {
+    *size = image.size();
+  }
+  return image;
+}
+
+} // namespace Media
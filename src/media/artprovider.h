@@ -0,0 +1,27 @@
+#pragma once
+
+#include <qquickimageprovider.h>
+
+#include "src/media/model.h"
+
+namespace Media {
+
+/**
+ * @class ArtProvider
+ * @brief Serves the decoded album art of a Model as image://mediaart/.
+ *
+ * The image is already at display size, so requestImage() only hands out a
+ * shared copy.
+ */
+class ArtProvider final : public QQuickImageProvider {
+public:
+  explicit ArtProvider(MediaModelRef model);
+
+  QImage requestImage(const QString& id, QSize* size,
+                      const QSize& requestedSize) override;
+
+private:
+  MediaModelRef m_model;
+};
+
+} // namespace Media
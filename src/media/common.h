@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <qobject.h>
+#include <qobjectdefs.h>
+#include <qqmlintegration.h>
+#include <qtmetamacros.h>
+
+namespace Media {
+Q_NAMESPACE
+QML_ELEMENT
+
+enum class PlaybackStatus : uint8_t {
+  Stopped = 0,
+  Playing,
+  Paused,
+};
+Q_ENUM_NS(PlaybackStatus)
+
+} // namespace Media
@@ -0,0 +1,170 @@
+#include "media/controller.h"
+
+#include <qdbusconnection.h>
+#include <qdbusconnectioninterface.h>
+#include <qdbuspendingcall.h>
+#include <qdbuspendingreply.h>
+#include <qdebug.h>
+#include <qlogging.h>
+
+namespace Media {
+
+namespace {
+
+constexpr auto kServicePrefix = "org.mpris.MediaPlayer2.";
+
+} // namespace
+
+Controller::Controller(QObject* parent) : QObject{parent} {
+  m_model = std::make_shared<Model>();
+
+  connect(m_model.get(), &Model::controlRequested, this,
+          [this](const QString& method) {
+            if (m_active != nullptr) {
+              m_active->call(method);
+            }
+          });
+  connect(&m_artLoader, &ArtLoader::loaded, this, &Controller::onArtLoaded);
+}
+
+Controller::~Controller() = default;
+
+void Controller::start(const int artSize) {
+  m_artLoader.setSize(artSize);
+
+  QDBusConnection bus = QDBusConnection::sessionBus();
+  if (!bus.isConnected()) {
+    qWarning() << "Media: no session bus";
+    return;
+  }
+
+  // Matches on the name prefix, no polling of the bus names
+  m_serviceWatcher.setConnection(bus);
+  m_serviceWatcher.setWatchMode(QDBusServiceWatcher::WatchForRegistration |
+                                QDBusServiceWatcher::WatchForUnregistration);
+  m_serviceWatcher.addWatchedService(QString(kServicePrefix) + '*');
+  connect(&m_serviceWatcher, &QDBusServiceWatcher::serviceRegistered, this,
+          &Controller::onServiceRegistered);
+  connect(&m_serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this,
+          &Controller::onServiceUnregistered);
+
+  listPlayers();
+}
+
+void Controller::listPlayers() {
+  auto* watcher = new QDBusPendingCallWatcher(
+      QDBusConnection::sessionBus().interface()->asyncCall("ListNames"),
+      this);
+
+  connect(watcher, &QDBusPendingCallWatcher::finished, this,
+          [this](QDBusPendingCallWatcher* call) {
+            const QDBusPendingReply<QStringList> reply = *call;
+            call->deleteLater();
+
+            if (reply.isError()) {
+              return;
+            }
+            for (const QString& name : reply.value()) {
+              if (name.startsWith(kServicePrefix)) {
+                onServiceRegistered(name);
+              }
+            }
+          });
+}
+
+void Controller::onServiceRegistered(const QString& service) {
+  if (m_players.contains(service)) {
+    return;
+  }
+
+  auto* player = new Player(service, this);
+  m_players.insert(service, player);
+
+  connect(player, &Player::statusChanged, this,
+          [this, player]() { onStatusChanged(player); });
+  connect(player, &Player::trackChanged, this, [this, player]() {
+    if (player == m_active) {
+      syncTrack();
+    }
+  });
+  connect(player, &Player::positionAnchored, this, [this, player]() {
+    if (player == m_active) {
+      syncPlayback();
+    }
+  });
+
+  if (m_active == nullptr) {
+    setActive(player);
+  }
+}
+
+void Controller::onServiceUnregistered(const QString& service) {
+  Player* player = m_players.take(service);
+  if (player == nullptr) {
+    return;
+  }
+
+  if (player == m_active) {
+    Player* next = nullptr;
+    for (Player* candidate : std::as_const(m_players)) {
+      if (next == nullptr || candidate->status() == PlaybackStatus::Playing) {
+        next = candidate;
+      }
+    }
+    setActive(next);
+  }
+  player->deleteLater();
+}
+
+void Controller::onStatusChanged(Player* player) {
+  if (player != m_active && player->status() == PlaybackStatus::Playing) {
+    setActive(player);
+  }
+}
+
+void Controller::setActive(Player* player) {
+  m_active = player;
+  m_model->setPresent(player != nullptr);
+  syncTrack();
+  syncPlayback();
+}
+
+void Controller::syncTrack() {
+  if (m_active == nullptr) {
+    m_model->setTrack(QString(), QString(), QString(), 0);
+    m_model->setArt(QImage());
+    return;
+  }
+
+  const Track& track = m_active->track();
+  m_model->setTrack(track.title, track.artists.join(", "), track.album,
+                    static_cast<double>(track.lengthUs) / 1000.0);
+
+  if (track.artUrl.isEmpty()) {
+    m_model->setArt(QImage());
+  } else {
+    m_artLoader.load(track.artUrl);
+  }
+}
+
+void Controller::syncPlayback() {
+  if (m_active == nullptr) {
+    m_model->setPlayback(PlaybackStatus::Stopped, 1.0, 0, 0);
+    return;
+  }
+
+  m_model->setPlayback(m_active->status(), m_active->rate(),
+                       static_cast<double>(m_active->anchorPosition()) /
+                           1000.0,
+                       m_active->anchorTime());
+}
+
+void Controller::onArtLoaded(const QString& url, const QImage& image) {
+  // A late decode of a track that is no longer shown
+  if (m_active == nullptr || m_active->track().artUrl != url) {
+    return;
+  }
+  m_model->setArt(image);
+}
+
+} // namespace Media
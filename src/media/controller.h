@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <qdbusservicewatcher.h>
+#include <qhash.h>
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+#include "src/media/artloader.h"
+#include "src/media/model.h"
+#include "src/media/player.h"
+
+namespace Media {
+
+/**
+ * @class Controller
+ * @brief Follows the MPRIS players on the session bus and feeds the Model.
+ *
+ * Players come and go with their org.mpris.MediaPlayer2.* bus names. The
+ * active player is the one that most recently started playing, or the last
+ * active one while nothing plays.
+ *
+ * Uses the session bus as given by $DBUS_SESSION_BUS_ADDRESS, which makes it
+ * possible to run against a private dbus-daemon with a fake player.
+ */
+class Controller : public QObject {
+  Q_OBJECT
+
+public:
+  Controller(QObject* parent = nullptr);
+  ~Controller() override;
+
+  /// Album art is decoded to fit @p artSize device pixels
+  void start(int artSize);
+
+  [[nodiscard]] MediaModelRef getModel() const { return m_model; }
+
+private slots:
+  void onServiceRegistered(const QString& service);
+  void onServiceUnregistered(const QString& service);
+
+private:
+  void listPlayers();
+  void onStatusChanged(Player* player);
+  void setActive(Player* player);
+  void syncTrack();
+  void syncPlayback();
+  void onArtLoaded(const QString& url, const QImage& image);
+
+  QDBusServiceWatcher m_serviceWatcher;
+  QHash<QString, Player*> m_players;
+  Player* m_active = nullptr;
+  ArtLoader m_artLoader;
+
+  MediaModelRef m_model;
+};
+
+} // namespace Media
+
+using MediaController = Media::Controller;
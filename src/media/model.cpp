@@ -0,0 +1,83 @@
+#include "media/model.h"
+
+#include <algorithm>
+#include <qqmlengine.h>
+
+#include "common/clock.h"
+
+namespace Media {
+
+Model::Model(QObject* parent) : QObject{parent} {
+  QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+}
+
+Model::~Model() = default;
+
+void Model::setPresent(const bool present) {
+  if (m_present == present) {
+    return;
+  }
+  m_present = present;
+  emit presentChanged();
+}
+
+void Model::setTrack(const QString& title, const QString& artist,
+                     const QString& album, const double length) {
+  if (m_title == title && m_artist == artist && m_album == album &&
+      m_length == length) {
+    return;
+  }
+  m_title = title;
+  m_artist = artist;
+  m_album = album;
+  m_length = length;
+  emit trackChanged();
+}
+
+void Model::setPlayback(const PlaybackStatus status, const double rate,
+                        const double position, const qint64 anchorTime) {
+  const bool statusDiffers = m_status != status;
+  m_status = status;
+  m_rate = rate;
+  m_anchorPosition = position;
+  m_anchorTime = anchorTime;
+
+  if (statusDiffers) {
+    emit statusChanged();
+  }
+  emit positionAnchored();
+}
+
+double Model::position() const {
+  double position = m_anchorPosition;
+  if (m_status == PlaybackStatus::Playing) {
+    position += static_cast<double>(Clock::monotonicMs() - m_anchorTime) * m_rate;
+  }
+  if (m_length > 0) {
+    position = std::min(position, m_length);
+  }
+  return std::max(position, 0.0);
+}
+
+QImage Model::art() const {
+  const std::lock_guard lock(m_artMutex);
+  return m_art;
+}
+
+void Model::setArt(const QImage& art) {
+  {
+    const std::lock_guard lock(m_artMutex);
+    if (art.isNull() && m_art.isNull()) {
+      return;
+    }
+    m_art = art;
+  }
+
+  // A new URL per image, the QML image cache never serves a stale cover
+  m_artSource = art.isNull()
+                    ? QString()
+                    : QString("image://mediaart/%1").arg(++m_artGeneration);
+  emit artSourceChanged();
+}
+
+} // namespace Media
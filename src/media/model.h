@@ -0,0 +1,103 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <qimage.h>
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+#include "src/media/common.h"
+
+namespace Media {
+
+/**
+ * @class Model
+ * @brief Now-playing state of the active MPRIS player.
+ *
+ * The position is not a notifying property. positionAnchored() tells when
+ * the player reported one, position() extrapolates it to the current time.
+ * A view animates from there at rate() on the shared animation clock and
+ * only has to restart the animation on the next anchor.
+ */
+class Model : public QObject {
+  Q_OBJECT
+
+  Q_PROPERTY(bool present READ present NOTIFY presentChanged)
+  Q_PROPERTY(Media::PlaybackStatus status READ status NOTIFY statusChanged)
+  Q_PROPERTY(bool playing READ playing NOTIFY statusChanged)
+  Q_PROPERTY(QString title READ title NOTIFY trackChanged)
+  Q_PROPERTY(QString artist READ artist NOTIFY trackChanged)
+  Q_PROPERTY(QString album READ album NOTIFY trackChanged)
+  /// Track length in ms, 0 if unknown
+  Q_PROPERTY(double length READ length NOTIFY trackChanged)
+  Q_PROPERTY(double rate READ rate NOTIFY positionAnchored)
+  /// image://mediaart/ URL of the album art, empty without art
+  Q_PROPERTY(QString artSource READ artSource NOTIFY artSourceChanged)
+
+public:
+  explicit Model(QObject* parent = nullptr);
+  ~Model() override;
+
+  [[nodiscard]] bool present() const { return m_present; }
+  void setPresent(bool present);
+
+  [[nodiscard]] PlaybackStatus status() const { return m_status; }
+  [[nodiscard]] bool playing() const {
+    return m_status == PlaybackStatus::Playing;
+  }
+
+  [[nodiscard]] QString title() const { return m_title; }
+  [[nodiscard]] QString artist() const { return m_artist; }
+  [[nodiscard]] QString album() const { return m_album; }
+  [[nodiscard]] double length() const { return m_length; }
+  void setTrack(const QString& title, const QString& artist,
+                const QString& album, double length);
+
+  [[nodiscard]] double rate() const { return m_rate; }
+  /**
+   * @param position Position in ms at the monotonic time @p anchorTime
+   */
+  void setPlayback(PlaybackStatus status, double rate, double position,
+                   qint64 anchorTime);
+
+  /// Position in ms, extrapolated to now
+  Q_INVOKABLE double position() const;
+
+  [[nodiscard]] QString artSource() const { return m_artSource; }
+  /// Any thread, read by the image provider
+  [[nodiscard]] QImage art() const;
+  void setArt(const QImage& art);
+
+  Q_INVOKABLE void playPause() { emit controlRequested("PlayPause"); }
+  Q_INVOKABLE void next() { emit controlRequested("Next"); }
+  Q_INVOKABLE void previous() { emit controlRequested("Previous"); }
+
+signals:
+  void presentChanged();
+  void statusChanged();
+  void trackChanged();
+  void positionAnchored();
+  void artSourceChanged();
+  void controlRequested(const QString& method);
+
+private:
+  bool m_present = false;
+  PlaybackStatus m_status = PlaybackStatus::Stopped;
+  QString m_title;
+  QString m_artist;
+  QString m_album;
+  double m_length = 0;
+
+  double m_rate = 1.0;
+  double m_anchorPosition = 0;
+  qint64 m_anchorTime = 0;
+
+  QString m_artSource;
+  uint32_t m_artGeneration = 0;
+  mutable std::mutex m_artMutex;
+  QImage m_art;
+};
+
+} // namespace Media
+
+using MediaModelRef = std::shared_ptr<Media::Model>;
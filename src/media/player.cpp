@@ -0,0 +1,220 @@
+#include "player.h"
+
+#include <algorithm>
+#include <qdbusargument.h>
+#include <qdbusconnection.h>
+#include <qdbusmessage.h>
+#include <qdbusmetatype.h>
+#include <qdbuspendingcall.h>
+#include <qdbuspendingreply.h>
+#include <qdbusvariant.h>
+
+namespace Media {
+
+namespace {
+
+constexpr auto kPlayerPath = "/org/mpris/MediaPlayer2";
+constexpr auto kPlayerInterface = "org.mpris.MediaPlayer2.Player";
+constexpr auto kPropertiesInterface = "org.freedesktop.DBus.Properties";
+
+PlaybackStatus parseStatus(const QString& status) {
+  if (status == "Playing") {
+    return PlaybackStatus::Playing;
+  }
+  if (status == "Paused") {
+    return PlaybackStatus::Paused;
+  }
+  return PlaybackStatus::Stopped;
+}
+
+/// Container values arrive as QDBusArgument when nested in a variant
+QVariantMap toVariantMap(const QVariant& value) {
+  if (value.canConvert<QDBusArgument>()) {
+    return qdbus_cast<QVariantMap>(value.value<QDBusArgument>());
+  }
+  return value.toMap();
+}
+
+QStringList toStringList(const QVariant& value) {
+  if (value.canConvert<QDBusArgument>()) {
+    return qdbus_cast<QStringList>(value.value<QDBusArgument>());
+  }
+  return value.toStringList();
+}
+
+} // namespace
+
+Player::Player(QString service, QObject* parent)
+    : QObject{parent}, m_service{std::move(service)} {
+  QDBusConnection bus = QDBusConnection::sessionBus();
+  bus.connect(m_service, kPlayerPath, kPropertiesInterface,
+              "PropertiesChanged", this,
+              SLOT(onPropertiesChanged(QString, QVariantMap, QStringList)));
+  bus.connect(m_service, kPlayerPath, kPlayerInterface, "Seeked", this,
+              SLOT(onSeeked(qlonglong)));
+
+  getAll();
+}
+
+Player::~Player() = default;
+
+qint64 Player::positionAt(const qint64 nowMs) const {
+  qint64 position = m_anchorPosition;
+  if (m_status == PlaybackStatus::Playing) {
+    position += static_cast<qint64>(
+        static_cast<double>(nowMs - m_anchorTime) * 1000.0 * m_rate);
+  }
+  if (m_track.lengthUs > 0) {
+    position = std::min(position, m_track.lengthUs);
+  }
+  return std::max<qint64>(position, 0);
+}
+
+void Player::call(const QString& method) const {
+  QDBusConnection::sessionBus().asyncCall(QDBusMessage::createMethodCall(
+      m_service, kPlayerPath, kPlayerInterface, method));
+}
+
+void Player::onPropertiesChanged(const QString& interface,
+                                 const QVariantMap& changed,
+                                 const QStringList& invalidated) {
+  if (interface != kPlayerInterface) {
+    return;
+  }
+
+  applyProperties(changed);
+
+  // Some players invalidate instead of sending values
+  if (invalidated.contains("Metadata") ||
+      invalidated.contains("PlaybackStatus")) {
+    getAll();
+  }
+}
+
+void Player::onSeeked(const qlonglong position) { anchor(position); }
+
+void Player::getAll() {
+  QDBusMessage message = QDBusMessage::createMethodCall(
+      m_service, kPlayerPath, kPropertiesInterface, "GetAll");
+  message << QString(kPlayerInterface);
+
+  auto* watcher = new QDBusPendingCallWatcher(
+      QDBusConnection::sessionBus().asyncCall(message), this);
+
+  connect(watcher, &QDBusPendingCallWatcher::finished, this,
+          [this](QDBusPendingCallWatcher* call) {
+            const QDBusPendingReply<QVariantMap> reply = *call;
+            call->deleteLater();
+
+            if (reply.isError()) {
+              return;
+            }
+            applyProperties(reply.value());
+          });
+}
+
+void Player::fetchPosition() {
+  QDBusMessage message = QDBusMessage::createMethodCall(
+      m_service, kPlayerPath, kPropertiesInterface, "Get");
+  message << QString(kPlayerInterface) << QString("Position");
+
+  auto* watcher = new QDBusPendingCallWatcher(
+      QDBusConnection::sessionBus().asyncCall(message), this);
+
+  connect(watcher, &QDBusPendingCallWatcher::finished, this,
+          [this](QDBusPendingCallWatcher* call) {
+            const QDBusPendingReply<QDBusVariant> reply = *call;
+            call->deleteLater();
+
+            if (reply.isError()) {
+              return;
+            }
+            anchor(reply.value().variant().toLongLong());
+          });
+}
+
+void Player::applyProperties(const QVariantMap& properties) {
+  bool refetchPosition = false;
+
+  if (const auto it = properties.constFind("Metadata");
+      it != properties.cend()) {
+    Track track = trackFromMetadata(*it);
+    if (track != m_track) {
+      const bool newTrack = track.id != m_track.id;
+      m_track = std::move(track);
+      refetchPosition = refetchPosition || newTrack;
+      emit trackChanged();
+    }
+  }
+
+  // Freeze the extrapolated position before the status or rate changes
+  const qint64 now = Clock::monotonicMs();
+  const qint64 position = positionAt(now);
+  bool reanchor = false;
+
+  if (const auto it = properties.constFind("PlaybackStatus");
+      it != properties.cend()) {
+    const PlaybackStatus status = parseStatus(it->toString());
+    if (status != m_status) {
+      m_anchorPosition = position;
+      m_anchorTime = now;
+      m_status = status;
+      reanchor = true;
+      refetchPosition = true;
+      emit statusChanged();
+    }
+  }
+
+  if (const auto it = properties.constFind("Rate"); it != properties.cend()) {
+    const double rate = it->toDouble();
+    if (rate > 0.0 && rate != m_rate) {
+      m_anchorPosition = position;
+      m_anchorTime = now;
+      m_rate = rate;
+      reanchor = true;
+      refetchPosition = true;
+    }
+  }
+
+  if (const auto it = properties.constFind("Position");
+      it != properties.cend()) {
+    anchor(it->toLongLong());
+    return;
+  }
+
+  if (reanchor) {
+    emit positionAnchored();
+  }
+  if (refetchPosition) {
+    fetchPosition();
+  }
+}
+
+void Player::anchor(const qint64 position) {
+  m_anchorPosition = position;
+  m_anchorTime = Clock::monotonicMs();
+  emit positionAnchored();
+}
+
+Track Player::trackFromMetadata(const QVariant& metadata) {
+  const QVariantMap map = toVariantMap(metadata);
+
+  Track track;
+  const QVariant id = map.value("mpris:trackid");
+  track.id = id.canConvert<QDBusObjectPath>()
+                 ? id.value<QDBusObjectPath>().path()
+                 : id.toString();
+  track.title = map.value("xesam:title").toString();
+  track.artists = toStringList(map.value("xesam:artist"));
+  track.album = map.value("xesam:album").toString();
+  track.artUrl = map.value("mpris:artUrl").toString();
+  track.lengthUs = map.value("mpris:length").toLongLong();
+
+  // Without a track id, a new title is the only sign of a new track
+  if (track.id.isEmpty()) {
+    track.id = track.title;
+  }
+  return track;
+}
+
+} // namespace Media
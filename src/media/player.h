@@ -0,0 +1,89 @@
+#pragma once
+
+#include <qobject.h>
+#include <qstring.h>
+#include <qstringlist.h>
+#include <qtmetamacros.h>
+#include <qvariant.h>
+
+#include "src/common/clock.h"
+#include "src/media/common.h"
+
+namespace Media {
+
+struct Track {
+  QString id;
+  QString title;
+  QStringList artists;
+  QString album;
+  QString artUrl;
+  qint64 lengthUs = 0;
+
+  bool operator==(const Track& other) const {
+    return id == other.id && title == other.title &&
+           artists == other.artists && album == other.album &&
+           artUrl == other.artUrl && lengthUs == other.lengthUs;
+  }
+  bool operator!=(const Track& other) const { return !(*this == other); }
+};
+
+/**
+ * @class Player
+ * @brief Client-side proxy of one org.mpris.MediaPlayer2 player.
+ *
+ * Reads all properties once, then follows PropertiesChanged. Position is not
+ * announced by players, so it is kept as an anchor: a position and the
+ * monotonic time it was valid at. The anchor is refreshed from Seeked, and
+ * fetched once whenever the status, rate or track changes. In between the
+ * position is extrapolated with the rate, nothing is polled.
+ */
+class Player final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit Player(QString service, QObject* parent = nullptr);
+  ~Player() override;
+
+  [[nodiscard]] const QString& service() const { return m_service; }
+  [[nodiscard]] const Track& track() const { return m_track; }
+  [[nodiscard]] PlaybackStatus status() const { return m_status; }
+  [[nodiscard]] double rate() const { return m_rate; }
+
+  /// Position in µs at the monotonic time @p nowMs, see Clock::monotonicMs()
+  [[nodiscard]] qint64 positionAt(qint64 nowMs) const;
+  [[nodiscard]] qint64 anchorPosition() const { return m_anchorPosition; }
+  [[nodiscard]] qint64 anchorTime() const { return m_anchorTime; }
+
+  /// Calls a method without arguments, e.g. PlayPause, Next or Previous
+  void call(const QString& method) const;
+
+signals:
+  void trackChanged();
+  void statusChanged();
+  /// The position anchor, status or rate changed
+  void positionAnchored();
+
+private slots:
+  void onPropertiesChanged(const QString& interface,
+                           const QVariantMap& changed,
+                           const QStringList& invalidated);
+  void onSeeked(qlonglong position);
+
+private:
+  void getAll();
+  void fetchPosition();
+  void applyProperties(const QVariantMap& properties);
+  void anchor(qint64 position);
+
+  [[nodiscard]] static Track trackFromMetadata(const QVariant& metadata);
+
+  QString m_service;
+  Track m_track;
+  PlaybackStatus m_status = PlaybackStatus::Stopped;
+  double m_rate = 1.0;
+
+  qint64 m_anchorPosition = 0;
+  qint64 m_anchorTime = 0;
+};
+
+} // namespace Media
@@ -0,0 +1,141 @@
+#include "allocations.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace Metrics::Allocations {
+
+#ifdef SIMBAR_COUNT_ALLOCATIONS
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_frees{0};
+std::atomic<int64_t> g_liveBytes{0};
+thread_local uint64_t t_allocations = 0;
+
+void* counted(void* pointer) {
+  if (pointer != nullptr) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_liveBytes.fetch_add(static_cast<int64_t>(malloc_usable_size(pointer)),
+                          std::memory_order_relaxed);
+    t_allocations++;
+  }
+  return pointer;
+}
+
+void release(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+
+  g_frees.fetch_add(1, std::memory_order_relaxed);
+  g_liveBytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(pointer)),
+                        std::memory_order_relaxed);
+  std::free(pointer);
+}
+
+void* allocate(const std::size_t size) {
+  void* pointer = counted(std::malloc(size == 0 ? 1 : size));
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* allocateAligned(std::size_t size, const std::align_val_t alignment) {
+  const auto align = static_cast<std::size_t>(alignment);
+  // aligned_alloc wants a multiple of the alignment
+  size = ((size == 0 ? 1 : size) + align - 1) & ~(align - 1);
+
+  void* pointer = counted(std::aligned_alloc(align, size));
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+} // namespace
+
+bool enabled() { return true; }
+
+Counters process() {
+  return {g_allocations.load(std::memory_order_relaxed),
+          g_frees.load(std::memory_order_relaxed),
+          g_liveBytes.load(std::memory_order_relaxed)};
+}
+
+uint64_t thisThread() { return t_allocations; }
+
+#else
+
+bool enabled() { return false; }
+
+Counters process() { return {}; }
+
+uint64_t thisThread() { return 0; }
+
+#endif
+
+} // namespace Metrics::Allocations
+
+#ifdef SIMBAR_COUNT_ALLOCATIONS
+
+using Metrics::Allocations::allocate;
+using Metrics::Allocations::allocateAligned;
+using Metrics::Allocations::release;
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t& /*unused*/) noexcept {
+  try {
+    return allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size,
+                     const std::nothrow_t& /*unused*/) noexcept {
+  try {
+    return allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { release(pointer); }
+void operator delete[](void* pointer) noexcept { release(pointer); }
+void operator delete(void* pointer, std::size_t /*unused*/) noexcept {
+  release(pointer);
+}
+void operator delete[](void* pointer, std::size_t /*unused*/) noexcept {
+  release(pointer);
+}
+void operator delete(void* pointer, std::align_val_t /*unused*/) noexcept {
+  release(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t /*unused*/) noexcept {
+  release(pointer);
+}
+void operator delete(void* pointer, std::size_t /*unused*/,
+                     std::align_val_t /*unused*/) noexcept {
+  release(pointer);
+}
+void operator delete[](void* pointer, std::size_t /*unused*/,
+                       std::align_val_t /*unused*/) noexcept {
+  release(pointer);
+}
+
+#endif
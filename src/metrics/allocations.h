@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Metrics {
+
+/**
+ * @brief Heap allocation counters fed by the replacement operator new/delete
+ * in allocations.cpp.
+ *
+ * Only compiled in with SIMBAR_COUNT_ALLOCATIONS (debug builds), otherwise
+ * enabled() is false and every counter stays 0. Counting costs two relaxed
+ * atomic adds and a malloc_usable_size() per allocation.
+ */
+namespace Allocations {
+
+struct Counters {
+  uint64_t allocations = 0;
+  uint64_t frees = 0;
+  int64_t liveBytes = 0; ///< Usable size of blocks allocated through new
+};
+
+[[nodiscard]] bool enabled();
+
+/// Process-wide totals
+[[nodiscard]] Counters process();
+
+/// Allocations made by the calling thread, for attributing work to a phase
+[[nodiscard]] uint64_t thisThread();
+
+} // namespace Allocations
+
+} // namespace Metrics
@@ -0,0 +1,19 @@
+#include "cputime.h"
+
+#include <sys/resource.h>
+
+namespace Metrics {
+
+qint64 cpuTimeUs() {
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+
+  auto toUs = [](const timeval& time) {
+    return static_cast<qint64>(time.tv_sec) * 1000000 + time.tv_usec;
+  };
+  return toUs(usage.ru_utime) + toUs(usage.ru_stime);
+}
+
+} // namespace Metrics
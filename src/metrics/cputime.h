@@ -0,0 +1,15 @@
+#pragma once
+
+#include <qtypes.h>
+
+namespace Metrics {
+
+/**
+ * @brief User plus system CPU time of every thread of this process, from
+ * getrusage(RUSAGE_SELF).
+ *
+ * @return The time in microseconds, or -1 if it could not be read.
+ */
+qint64 cpuTimeUs();
+
+} // namespace Metrics
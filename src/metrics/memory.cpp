@@ -0,0 +1,26 @@
+#include "memory.h"
+
+#include <cstdio>
+#include <unistd.h>
+
+namespace Metrics {
+
+qint64 residentMemoryKiB() {
+  FILE* statm = std::fopen("/proc/self/statm", "re");
+  if (statm == nullptr) {
+    return -1;
+  }
+
+  long long size = 0;
+  long long resident = 0;
+  const int matched = std::fscanf(statm, "%lld %lld", &size, &resident);
+  std::fclose(statm);
+
+  if (matched != 2) {
+    return -1;
+  }
+
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+} // namespace Metrics
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <qtypes.h>
+
+namespace Metrics {
+
+/**
+ * @brief Reads the resident set size of this process.
+ *
+ * Parses /proc/self/statm, which is cheap enough to call around single
+ * operations (view creation, resource release) to attribute memory to them.
+ *
+ * @return Resident memory in KiB, or -1 if it could not be read.
+ */
+qint64 residentMemoryKiB();
+
+} // namespace Metrics
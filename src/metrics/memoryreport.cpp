@@ -0,0 +1,302 @@
+#include "memoryreport.h"
+
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <malloc.h>
+#include <qdebug.h>
+#include <qlogging.h>
+#include <qsocketnotifier.h>
+#include <qstringlist.h>
+#include <qsurfaceformat.h>
+#include <unistd.h>
+#include <utility>
+
+#include "allocations.h"
+#include "memory.h"
+#include "src/ui/atlastexture.h"
+#include "src/ui/flexrectangle.h"
+
+namespace Metrics {
+
+namespace {
+
+// Gives the GPU stats frame time to render before the report is logged
+constexpr int kCollectDelayMs = 100;
+
+int g_signalPipe[2] = {-1, -1};
+
+void onSignal(int /*unused*/) {
+  const int savedErrno = errno;
+  const char byte = 'r';
+  [[maybe_unused]] const ssize_t written = ::write(g_signalPipe[1], &byte, 1);
+  errno = savedErrno;
+}
+
+QString kib(const qint64 bytes) {
+  return QString("%1 KiB").arg(static_cast<double>(bytes) / 1024.0, 0, 'f', 1);
+}
+
+struct ItemCounts {
+  int items = 0;
+  int drawn = 0;
+  int flexRectangles = 0;
+  qint64 geometryBytes = 0;
+};
+
+void countItems(const QQuickItem* item, ItemCounts& counts) {
+  counts.items++;
+  if (item->flags().testFlag(QQuickItem::ItemHasContents)) {
+    counts.drawn++;
+  }
+
+  if (const auto* rect = qobject_cast<const UI::FlexRectangle*>(item)) {
+    counts.flexRectangles++;
+    counts.geometryBytes += rect->geometryBytes();
+  }
+
+  for (const auto* child : item->childItems()) {
+    countItems(child, counts);
+  }
+}
+
+/// Color, MSAA and depth-stencil buffers of one surface, an estimate
+qint64 surfaceBytes(const QQuickView* view) {
+  const QSurfaceFormat format = view->format();
+  const qreal ratio = view->devicePixelRatio();
+  const qint64 pixels = static_cast<qint64>(view->width() * ratio) *
+                        static_cast<qint64>(view->height() * ratio);
+
+  const int buffers =
+      format.swapBehavior() == QSurfaceFormat::TripleBuffer ? 3 : 2;
+  const int samples = qMax(1, format.samples());
+  const bool depth = format.depthBufferSize() > 0 || format.stencilBufferSize() > 0;
+
+  qint64 bytes = pixels * 4 * buffers;
+  if (samples > 1) {
+    bytes += pixels * 4 * samples;
+  }
+  if (depth) {
+    bytes += pixels * 4 * samples;
+  }
+  return bytes;
+}
+
+} // namespace
+
+MemoryReport::MemoryReport(QObject* parent) : QObject{parent} {
+  connect(&m_interval, &QTimer::timeout, this, &MemoryReport::requestReport);
+
+  m_collect.setSingleShot(true);
+  m_collect.setInterval(kCollectDelayMs);
+  connect(&m_collect, &QTimer::timeout, this, &MemoryReport::log);
+}
+
+MemoryReport::~MemoryReport() {
+  if (m_signalNotifier != nullptr) {
+    std::signal(SIGUSR1, SIG_DFL);
+    ::close(g_signalPipe[0]);
+    ::close(g_signalPipe[1]);
+    g_signalPipe[0] = g_signalPipe[1] = -1;
+  }
+}
+
+void MemoryReport::watch(const ApplicationViewPtr& appView) {
+  watch(&appView->asView(), appView->name());
+
+  const auto& regionViews = appView->regionViews();
+  for (qsizetype i = 0; i < regionViews.size(); i++) {
+    watch(regionViews.at(i),
+          appView->name() + "/" + appView->regions().at(i).component);
+  }
+}
+
+void MemoryReport::watch(QQuickView* view, const QString& name) {
+  auto stats = std::make_unique<ViewStats>();
+  stats->view = view;
+  stats->name = name;
+  stats->lastProcessTotal = Allocations::process().allocations;
+  ViewStats* raw = stats.get();
+  m_views.push_back(std::move(stats));
+
+  // All of these run on the render thread, the GUI thread is blocked during
+  // sync, which is where updatePaintNode() allocates
+  connect(
+      view, &QQuickWindow::beforeSynchronizing, this,
+      [raw]() { raw->syncStart = Allocations::thisThread(); },
+      Qt::DirectConnection);
+
+  connect(
+      view, &QQuickWindow::afterSynchronizing, this,
+      [raw]() {
+        const uint64_t now = Allocations::thisThread();
+        raw->syncAllocations += now - raw->syncStart;
+        raw->renderStart = now;
+      },
+      Qt::DirectConnection);
+
+  connect(
+      view, &QQuickWindow::afterRendering, this,
+      [raw, view]() {
+        raw->renderAllocations += Allocations::thisThread() - raw->renderStart;
+
+        if (raw->captureRequested.exchange(false) && view->rhi() != nullptr) {
+          QMutexLocker locker(&raw->mutex);
+          raw->rhiStats = view->rhi()->statistics();
+          raw->hasRhiStats = true;
+        }
+      },
+      Qt::DirectConnection);
+
+  connect(
+      view, &QQuickWindow::frameSwapped, this,
+      [raw]() {
+        const uint64_t total = Allocations::process().allocations;
+        raw->totalAllocations += total - raw->lastProcessTotal;
+        raw->lastProcessTotal = total;
+        raw->frames++;
+      },
+      Qt::DirectConnection);
+}
+
+void MemoryReport::addAtlas(const QString& name,
+                            const UI::TextureAtlas* atlas) {
+  m_atlases.append({name, atlas});
+}
+
+bool MemoryReport::installSignalHandler() {
+  if (g_signalPipe[0] >= 0) {
+    return false;
+  }
+
+  if (pipe2(g_signalPipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+    qWarning() << "MemoryReport: cannot create signal pipe";
+    return false;
+  }
+
+  m_signalNotifier =
+      new QSocketNotifier(g_signalPipe[0], QSocketNotifier::Read, this);
+  connect(m_signalNotifier, &QSocketNotifier::activated, this,
+          &MemoryReport::readSignalPipe);
+
+  struct sigaction action = {};
+  action.sa_handler = onSignal;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGUSR1, &action, nullptr);
+
+  return true;
+}
+
+void MemoryReport::setInterval(const int32_t msec) {
+  if (msec > 0) {
+    m_interval.start(msec);
+  } else {
+    m_interval.stop();
+  }
+}
+
+void MemoryReport::requestReport() {
+  if (m_collect.isActive()) {
+    return;
+  }
+
+  for (const auto& stats : m_views) {
+    if (stats->view != nullptr) {
+      stats->captureRequested = true;
+      stats->view->update();
+    }
+  }
+
+  m_collect.start();
+}
+
+void MemoryReport::readSignalPipe() {
+  char buffer[64];
+  while (::read(g_signalPipe[0], buffer, sizeof(buffer)) > 0) {
+  }
+
+  requestReport();
+}
+
+void MemoryReport::log() {
+  const struct mallinfo2 heap = mallinfo2();
+
+  QStringList lines;
+  lines.append(QString("Memory report: resident %1 KiB, malloc heap in use %2 "
+                       "(QML and JS heaps included), free in heap %3")
+                   .arg(residentMemoryKiB())
+                   .arg(kib(static_cast<qint64>(heap.uordblks +
+                                                heap.hblkhd)))
+                   .arg(kib(static_cast<qint64>(heap.fordblks))));
+
+  if (Allocations::enabled()) {
+    const Allocations::Counters counters = Allocations::process();
+    lines.append(QString("  operator new: %1 live, %2 allocations, %3 frees")
+                     .arg(kib(counters.liveBytes))
+                     .arg(counters.allocations)
+                     .arg(counters.frees));
+  }
+
+  for (const auto& [name, atlas] : std::as_const(m_atlases)) {
+    lines.append(QString("  atlas %1: %2 CPU")
+                     .arg(name, kib(atlas->image().sizeInBytes())));
+  }
+
+  for (const auto& stats : m_views) {
+    if (stats->view != nullptr) {
+      lines.append(viewReport(*stats));
+    }
+  }
+
+  qDebug().noquote() << lines.join('\n');
+}
+
+QString MemoryReport::viewReport(ViewStats& stats) const {
+  QQuickView* view = stats.view;
+
+  ItemCounts counts;
+  if (view->contentItem() != nullptr) {
+    countItems(view->contentItem(), counts);
+  }
+
+  QString line =
+      QString("  %1: %2 items (%3 drawn), %4 FlexRectangle with %5 of "
+              "vertices, atlas textures %6, surface buffers ~%7")
+          .arg(stats.name)
+          .arg(counts.items)
+          .arg(counts.drawn)
+          .arg(counts.flexRectangles)
+          .arg(kib(counts.geometryBytes))
+          .arg(kib(UI::AtlasTexture::bytesForWindow(view)))
+          .arg(kib(surfaceBytes(view)));
+
+  {
+    QMutexLocker locker(&stats.mutex);
+    if (stats.hasRhiStats) {
+      line += QString(", GPU allocator %1 used %2 unused in %3 blocks")
+                  .arg(kib(static_cast<qint64>(stats.rhiStats.usedBytes)))
+                  .arg(kib(static_cast<qint64>(stats.rhiStats.unusedBytes)))
+                  .arg(stats.rhiStats.blockCount);
+    }
+  }
+
+  // Per frame since the previous report
+  const uint64_t frames = stats.frames.exchange(0);
+  const uint64_t sync = stats.syncAllocations.exchange(0);
+  const uint64_t render = stats.renderAllocations.exchange(0);
+  const uint64_t total = stats.totalAllocations.exchange(0);
+
+  if (Allocations::enabled() && frames > 0) {
+    line += QString(", allocations per frame over %1 frames: sync %2, render "
+                    "%3, process %4")
+                .arg(frames)
+                .arg(static_cast<double>(sync) / frames, 0, 'f', 1)
+                .arg(static_cast<double>(render) / frames, 0, 'f', 1)
+                .arg(static_cast<double>(total) / frames, 0, 'f', 1);
+  }
+
+  return line;
+}
+
+} // namespace Metrics
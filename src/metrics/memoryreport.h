@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <qlist.h>
+#include <qmutex.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qquickview.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <rhi/qrhi.h>
+
+#include "appview.h"
+#include "src/ui/textureatlas.h"
+
+class QSocketNotifier;
+
+namespace Metrics {
+
+/**
+ * @class MemoryReport
+ * @brief Logs where resident memory goes, broken down per view.
+ *
+ * Per process: resident set, malloc heap in use (which is where the QML and
+ * JS heaps live), blocks live through operator new and CPU atlas images.
+ * Per view: items and drawn items, FlexRectangle vertex data, atlas textures,
+ * an estimate of swapchain, MSAA and depth buffers, QRhi allocator statistics
+ * and, in debug builds, heap allocations per frame split into the sync phase
+ * (updatePaintNode), the render phase and everything in between.
+ *
+ * A report is requested by SIGUSR1, periodically, or by calling
+ * requestReport(). Each watched view renders one frame first, so the QRhi
+ * statistics are read on its render thread.
+ */
+class MemoryReport final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit MemoryReport(QObject* parent = nullptr);
+  ~MemoryReport() override;
+
+  void watch(const ApplicationViewPtr& appView);
+  void watch(QQuickView* view, const QString& name);
+
+  void addAtlas(const QString& name, const UI::TextureAtlas* atlas);
+
+  /**
+   * @brief Reports on SIGUSR1.
+   *
+   * The handler only writes to a pipe, the report itself is produced on the
+   * GUI thread. Only one instance can own the signal.
+   */
+  bool installSignalHandler();
+
+  /// @param msec Interval of periodic reports, 0 disables them
+  void setInterval(int32_t msec);
+
+  void requestReport();
+
+private:
+  struct ViewStats {
+    QPointer<QQuickView> view;
+    QString name;
+
+    // Render thread bookkeeping
+    uint64_t syncStart = 0;
+    uint64_t renderStart = 0;
+    uint64_t lastProcessTotal = 0;
+
+    std::atomic<uint64_t> frames{0};
+    std::atomic<uint64_t> syncAllocations{0};
+    std::atomic<uint64_t> renderAllocations{0};
+    std::atomic<uint64_t> totalAllocations{0};
+
+    std::atomic<bool> captureRequested{false};
+    QMutex mutex;
+    QRhiStats rhiStats;
+    bool hasRhiStats = false;
+  };
+
+  void log();
+  [[nodiscard]] QString viewReport(ViewStats& stats) const;
+  void readSignalPipe();
+
+  std::vector<std::unique_ptr<ViewStats>> m_views;
+  QList<QPair<QString, const UI::TextureAtlas*>> m_atlases;
+
+  QTimer m_interval;
+  QTimer m_collect;
+  QSocketNotifier* m_signalNotifier = nullptr;
+};
+
+} // namespace Metrics
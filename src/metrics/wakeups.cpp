@@ -0,0 +1,15 @@
+#include "wakeups.h"
+
+#include <sys/resource.h>
+
+namespace Metrics {
+
+qint64 voluntaryContextSwitches() {
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+  return static_cast<qint64>(usage.ru_nvcsw);
+}
+
+} // namespace Metrics
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <qtypes.h>
+
+namespace Metrics {
+
+/**
+ * @brief Counts how often the threads of this process went to sleep.
+ *
+ * Reads ru_nvcsw of getrusage(RUSAGE_SELF), which keeps counting the threads
+ * that already exited, so the value never goes back when a pool worker ends.
+ * Each switch is a sleep that ended in a wakeup, so the growth of this
+ * counter over time is the wakeup rate of the process.
+ *
+ * @return The sum over all threads, or -1 if it could not be read.
+ */
+qint64 voluntaryContextSwitches();
+
+} // namespace Metrics
@@ -0,0 +1,23 @@
+#include "notify/controller.h"
+
+namespace Notify {
+
+Controller::Controller(QObject* parent) : QObject{parent} {
+  m_model = std::make_shared<Model>();
+  m_queue = std::make_unique<Queue>(m_model);
+  m_server = std::make_unique<Server>(m_queue.get());
+}
+
+Controller::~Controller() = default;
+
+bool Controller::start(const Queue::Limits& limits, const int imageSize) {
+  configure(limits, imageSize);
+  return m_server->registerOnBus();
+}
+
+void Controller::configure(const Queue::Limits& limits, const int imageSize) {
+  m_queue->setLimits(limits);
+  m_queue->setImageSize(imageSize);
+}
+
+} // namespace Notify
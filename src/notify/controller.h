@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <qobject.h>
+
+#include "src/notify/model.h"
+#include "src/notify/queue.h"
+#include "src/notify/server.h"
+
+namespace Notify {
+
+class Controller : public QObject {
+public:
+  Controller(QObject* parent = nullptr);
+  ~Controller() override;
+
+  /**
+   * Takes over org.freedesktop.Notifications unless another daemon owns it.
+   * @param imageSize Toast image size in device pixels
+   */
+  bool start(const Queue::Limits& limits, int imageSize);
+  /// Like start() without taking over the bus, for replaying a trace
+  void configure(const Queue::Limits& limits, int imageSize);
+
+  [[nodiscard]] NotifyModelRef getModel() const { return m_model; }
+  [[nodiscard]] Queue* getQueue() const { return m_queue.get(); }
+
+private:
+  NotifyModelRef m_model;
+  std::unique_ptr<Queue> m_queue;
+  std::unique_ptr<Server> m_server;
+};
+
+} // namespace Notify
+
+using NotifyController = Notify::Controller;
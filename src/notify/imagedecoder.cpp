@@ -0,0 +1,64 @@
+#include "imagedecoder.h"
+
+#include <qimagereader.h>
+#include <qurl.h>
+
+namespace Notify {
+
+namespace {
+
+QImage fromRaw(const RawImage& raw) {
+  const QImage::Format format =
+      raw.channels == 4 ? QImage::Format_RGBA8888 : QImage::Format_RGB888;
+  // Wraps the hint's bytes, copy() detaches before they go away
+  return QImage(reinterpret_cast<const uchar*>(raw.data.constData()),
+                raw.width, raw.height, raw.rowStride, format)
+      .copy();
+}
+
+QImage fromFile(const QString& path, const int size) {
+  const QUrl url(path);
+  QImageReader reader(url.isLocalFile() ? url.toLocalFile() : path);
+  reader.setAutoTransform(true);
+  const QSize original = reader.size();
+  if (original.isValid() &&
+      (original.width() > size || original.height() > size)) {
+    reader.setScaledSize(original.scaled(size, size, Qt::KeepAspectRatio));
+  }
+  return reader.read();
+}
+
+} // namespace
+
+ImageDecoder::ImageDecoder(QObject* parent) : QObject{parent} {
+  m_pool.setMaxThreadCount(1);
+}
+
+ImageDecoder::~ImageDecoder() {
+  // Results are queued calls on this object, which die with it
+  m_pool.clear();
+  m_pool.waitForDone();
+}
+
+void ImageDecoder::decode(const uint32_t id, const uint32_t generation,
+                          const RawImage& image, const QString& path) {
+  m_pool.start([this, id, generation, image, path, size = m_size]() {
+    QImage result = image.isValid() ? fromRaw(image) : fromFile(path, size);
+    if (!result.isNull() && (result.width() > size || result.height() > size)) {
+      result = result.scaled(size, size, Qt::KeepAspectRatio,
+                             Qt::SmoothTransformation);
+    }
+    if (!result.isNull()) {
+      result = result.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+    }
+
+    QMetaObject::invokeMethod(
+        this,
+        [this, id, generation, result]() {
+          emit decoded(id, generation, result);
+        },
+        Qt::QueuedConnection);
+  });
+}
+
+} // namespace Notify
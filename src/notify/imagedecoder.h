@@ -0,0 +1,42 @@
+#pragma once
+
+#include <qimage.h>
+#include <qobject.h>
+#include <qthreadpool.h>
+#include <qtmetamacros.h>
+
+#include "src/notify/notification.h"
+
+namespace Notify {
+
+/**
+ * @class ImageDecoder
+ * @brief Converts notification images on a worker thread.
+ *
+ * Both the raw image-data hint and image files are scaled to the toast's
+ * image size there, the GUI thread only receives the finished image. A
+ * single worker keeps a burst of notifications from taking every core.
+ */
+class ImageDecoder final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit ImageDecoder(QObject* parent = nullptr);
+  ~ImageDecoder() override;
+
+  /// Images fit into @p size x @p size device pixels
+  void setSize(int size) { m_size = size; }
+
+  /// Decodes @p image, or the file at @p path if it is invalid
+  void decode(uint32_t id, uint32_t generation, const RawImage& image,
+              const QString& path);
+
+signals:
+  void decoded(uint32_t id, uint32_t generation, const QImage& image);
+
+private:
+  int m_size = 48;
+  QThreadPool m_pool;
+};
+
+} // namespace Notify
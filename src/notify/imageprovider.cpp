@@ -0,0 +1,18 @@
+#include "notify/imageprovider.h"
+
+namespace Notify {
+
+ImageProvider::ImageProvider(NotifyModelRef model)
+    : QQuickImageProvider{QQuickImageProvider::Image},
+      m_model{std::move(model)} {}
+
+QImage ImageProvider::requestImage(const QString& id, QSize* size,
+                                   const QSize& /*requestedSize*/) {
+  const QImage image = m_model->image(id.section('/', 0, 0).toUInt());
+  if (size != nullptr) {
+    *size = image.size();
+  }
+  return image;
+}
+
+} // namespace Notify
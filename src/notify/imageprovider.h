@@ -0,0 +1,24 @@
+#pragma once
+
+#include <qquickimageprovider.h>
+
+#include "src/notify/model.h"
+
+namespace Notify {
+
+/**
+ * @class ImageProvider
+ * @brief Serves decoded notification images as image://notify/<id>/<n>.
+ */
+class ImageProvider final : public QQuickImageProvider {
+public:
+  explicit ImageProvider(NotifyModelRef model);
+
+  QImage requestImage(const QString& id, QSize* size,
+                      const QSize& requestedSize) override;
+
+private:
+  NotifyModelRef m_model;
+};
+
+} // namespace Notify
@@ -0,0 +1,133 @@
+#include "notify/model.h"
+
+#include <qqmlengine.h>
+
+namespace Notify {
+
+Model::Model(QObject* parent) : QAbstractListModel{parent} {
+  QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+}
+
+Model::~Model() = default;
+
+int Model::rowCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : static_cast<int>(m_notifications.size());
+}
+
+QVariant Model::data(const QModelIndex& index, const int role) const {
+  if (!checkIndex(index, CheckIndexOption::IndexIsValid)) {
+    return {};
+  }
+
+  const Notification& notification = m_notifications.at(index.row());
+  switch (role) {
+  case IdRole:
+    return notification.id;
+  case AppNameRole:
+    return notification.appName;
+  case Qt::DisplayRole:
+  case SummaryRole:
+    return notification.summary;
+  case BodyRole:
+    return notification.body;
+  case ActionsRole:
+    return notification.actions;
+  case CriticalRole:
+    return notification.urgency == Urgency::Critical;
+  case CountRole:
+    return notification.count;
+  case ImageSourceRole: {
+    const uint32_t generation =
+        m_imageGenerations.value(notification.id, 0);
+    return generation == 0 ? QString()
+                           : QString("image://notify/%1/%2")
+                                 .arg(notification.id)
+                                 .arg(generation);
+  }
+  default:
+    break;
+  }
+  return {};
+}
+
+QHash<int, QByteArray> Model::roleNames() const {
+  return {
+      {IdRole, "notificationId"},
+      {AppNameRole, "appName"},
+      {SummaryRole, "summary"},
+      {BodyRole, "body"},
+      {ActionsRole, "actions"},
+      {CriticalRole, "critical"},
+      {CountRole, "count"},
+      {ImageSourceRole, "imageSource"},
+  };
+}
+
+void Model::append(const Notification& notification) {
+  const int row = rowCount();
+  beginInsertRows({}, row, row);
+  m_notifications.append(notification);
+  endInsertRows();
+  emit countChanged();
+}
+
+void Model::update(const Notification& notification) {
+  const qsizetype row = indexOf(notification.id);
+  if (row < 0) {
+    return;
+  }
+  m_notifications[row] = notification;
+  const QModelIndex modelIndex = index(static_cast<int>(row));
+  emit dataChanged(modelIndex, modelIndex,
+                   {AppNameRole, SummaryRole, BodyRole, ActionsRole,
+                    CriticalRole, CountRole});
+}
+
+void Model::remove(const uint32_t id) {
+  const qsizetype row = indexOf(id);
+  if (row < 0) {
+    return;
+  }
+  beginRemoveRows({}, static_cast<int>(row), static_cast<int>(row));
+  m_notifications.remove(row);
+  endRemoveRows();
+  emit countChanged();
+}
+
+qsizetype Model::indexOf(const uint32_t id) const {
+  for (qsizetype i = 0; i < m_notifications.size(); i++) {
+    if (m_notifications.at(i).id == id) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+QImage Model::image(const uint32_t id) const {
+  const std::lock_guard lock(m_imageMutex);
+  return m_images.value(id);
+}
+
+void Model::setImage(const uint32_t id, const QImage& image) {
+  {
+    const std::lock_guard lock(m_imageMutex);
+    m_images.insert(id, image);
+  }
+  m_imageGenerations[id]++;
+
+  const qsizetype row = indexOf(id);
+  if (row >= 0) {
+    const QModelIndex modelIndex = index(static_cast<int>(row));
+    emit dataChanged(modelIndex, modelIndex, {ImageSourceRole});
+  }
+}
+
+void Model::dropImage(const uint32_t id) {
+  {
+    const std::lock_guard lock(m_imageMutex);
+    m_images.remove(id);
+  }
+  m_imageGenerations.remove(id);
+}
+
+} // namespace Notify
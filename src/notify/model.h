@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <qabstractitemmodel.h>
+#include <qhash.h>
+#include <qimage.h>
+#include <qlist.h>
+#include <qtmetamacros.h>
+
+#include "src/notify/notification.h"
+
+namespace Notify {
+
+/**
+ * @class Model
+ * @brief Toasts currently on screen, oldest first.
+ *
+ * Only the Queue mutates it, one row at a time. Images are held by id for
+ * the image provider and can arrive before or after their toast is shown.
+ */
+class Model : public QAbstractListModel {
+  Q_OBJECT
+
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+  enum Role {
+    IdRole = Qt::UserRole + 1,
+    AppNameRole,
+    SummaryRole,
+    BodyRole,
+    ActionsRole,
+    CriticalRole,
+    CountRole,
+    ImageSourceRole,
+  };
+  Q_ENUM(Role)
+
+  explicit Model(QObject* parent = nullptr);
+  ~Model() override;
+
+  [[nodiscard]] int rowCount(const QModelIndex& parent = {}) const override;
+  [[nodiscard]] QVariant data(const QModelIndex& index,
+                              int role = Qt::DisplayRole) const override;
+  [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+  [[nodiscard]] int count() const { return rowCount(); }
+
+  void append(const Notification& notification);
+  /// Replaces the row with the same id
+  void update(const Notification& notification);
+  void remove(uint32_t id);
+  [[nodiscard]] qsizetype indexOf(uint32_t id) const;
+  [[nodiscard]] const QList<Notification>& notifications() const {
+    return m_notifications;
+  }
+
+  /// Any thread, read by the image provider
+  [[nodiscard]] QImage image(uint32_t id) const;
+  void setImage(uint32_t id, const QImage& image);
+  void dropImage(uint32_t id);
+
+  /// Closes the toast as dismissed by the user
+  Q_INVOKABLE void dismiss(uint32_t id) { emit dismissRequested(id); }
+  Q_INVOKABLE void invokeAction(uint32_t id, const QString& key) {
+    emit actionRequested(id, key);
+  }
+
+signals:
+  void countChanged();
+  void dismissRequested(uint32_t id);
+  void actionRequested(uint32_t id, const QString& key);
+
+private:
+  QList<Notification> m_notifications;
+
+  mutable std::mutex m_imageMutex;
+  QHash<uint32_t, QImage> m_images;
+  /// Bumped per image, part of the image URL so QML never shows a stale one
+  QHash<uint32_t, uint32_t> m_imageGenerations;
+};
+
+} // namespace Notify
+
+using NotifyModelRef = std::shared_ptr<Notify::Model>;
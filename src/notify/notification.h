@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <qbytearray.h>
+#include <qstring.h>
+#include <qstringlist.h>
+
+namespace Notify {
+
+enum class Urgency : uint8_t {
+  Low = 0,
+  Normal,
+  Critical,
+};
+
+/// Reasons of NotificationClosed, as in the specification
+enum class CloseReason : uint32_t {
+  Expired = 1,
+  Dismissed,
+  Closed,
+  Undefined,
+};
+
+/// The image-data hint (iiibiiay), kept raw until the decoder thread
+struct RawImage {
+  int width = 0;
+  int height = 0;
+  int rowStride = 0;
+  bool hasAlpha = false;
+  int bitsPerSample = 0;
+  int channels = 0;
+  QByteArray data;
+
+  [[nodiscard]] bool isValid() const {
+    return width > 0 && height > 0 && bitsPerSample == 8 &&
+           (channels == 3 || channels == 4) &&
+           data.size() >= static_cast<qsizetype>(rowStride) * (height - 1) +
+                              static_cast<qsizetype>(width) * channels;
+  }
+};
+
+struct Notification {
+  uint32_t id = 0;
+  QString appName;
+  QString summary;
+  QString body;
+  /// Pairs of action key and label
+  QStringList actions;
+  Urgency urgency = Urgency::Normal;
+  /// As sent, -1 for the default timeout and 0 for never
+  int32_t expireTimeout = -1;
+
+  RawImage image;
+  QString imagePath;
+
+  /// Notifications merged into this one, shown as a counter
+  int count = 1;
+  /// Monotonic ms at which it expires, 0 for never
+  qint64 deadline = 0;
+};
+
+} // namespace Notify
@@ -0,0 +1,234 @@
+#include "queue.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "common/clock.h"
+
+namespace Notify {
+
+Queue::Queue(NotifyModelRef model, QObject* parent)
+    : QObject{parent}, m_model{std::move(model)} {
+  m_pumpTimer.setSingleShot(true);
+  m_expiryTimer.setSingleShot(true);
+  m_expiryTimer.setTimerType(Qt::CoarseTimer);
+
+  connect(&m_pumpTimer, &QTimer::timeout, this, &Queue::pump);
+  connect(&m_expiryTimer, &QTimer::timeout, this, &Queue::expire);
+  connect(&m_decoder, &ImageDecoder::decoded, this, &Queue::onDecoded);
+
+  connect(m_model.get(), &Model::dismissRequested, this,
+          [this](const uint32_t id) { close(id, CloseReason::Dismissed); });
+  connect(m_model.get(), &Model::actionRequested, this,
+          [this](const uint32_t id, const QString& key) {
+            emit actionInvoked(id, key);
+            close(id, CloseReason::Dismissed);
+          });
+}
+
+Queue::~Queue() = default;
+
+void Queue::setLimits(const Limits& limits) {
+  m_limits = limits;
+  schedulePump();
+}
+
+uint32_t Queue::notify(Notification notification, const uint32_t replacesId) {
+  emit received(notification, replacesId);
+
+  const bool critical = notification.urgency == Urgency::Critical;
+
+  // Replacing keeps the id and the place on screen or in the queue
+  if (replacesId != 0) {
+    if (const qsizetype row = m_model->indexOf(replacesId); row >= 0) {
+      updateVisible(row, std::move(notification), false);
+      return replacesId;
+    }
+    if (const qsizetype pending = findPending(replacesId); pending >= 0) {
+      notification.id = replacesId;
+      m_pending[pending] = std::move(notification);
+      decodeImage(m_pending.at(pending));
+      return replacesId;
+    }
+  }
+
+  // Same application: count up instead of stacking toasts. Critical ones
+  // always stand on their own
+  if (!critical) {
+    const QList<Notification>& shown = m_model->notifications();
+    for (qsizetype row = 0; row < shown.size(); row++) {
+      if (shown.at(row).appName == notification.appName &&
+          shown.at(row).urgency != Urgency::Critical) {
+        const uint32_t id = shown.at(row).id;
+        updateVisible(row, std::move(notification), true);
+        return id;
+      }
+    }
+    for (Notification& waiting : m_pending) {
+      if (waiting.appName == notification.appName &&
+          waiting.urgency != Urgency::Critical) {
+        notification.id = waiting.id;
+        notification.count = waiting.count + 1;
+        waiting = std::move(notification);
+        decodeImage(waiting);
+        return waiting.id;
+      }
+    }
+  }
+
+  notification.id = m_nextId++;
+  if (m_nextId == 0) {
+    m_nextId = 1;
+  }
+  const uint32_t id = notification.id;
+  enqueue(std::move(notification));
+  return id;
+}
+
+bool Queue::close(const uint32_t id, const CloseReason reason) {
+  if (m_model->indexOf(id) >= 0) {
+    m_model->remove(id);
+    schedulePump();
+    armExpiry();
+  } else if (const qsizetype pending = findPending(id); pending >= 0) {
+    m_pending.remove(pending);
+  } else {
+    return false;
+  }
+
+  m_model->dropImage(id);
+  m_imageGenerations.remove(id);
+  emit closed(id, reason);
+  return true;
+}
+
+void Queue::updateVisible(const qsizetype row, Notification notification,
+                          const bool merged) {
+  const Notification& current = m_model->notifications().at(row);
+  notification.id = current.id;
+  notification.count = merged ? current.count + 1 : current.count;
+  notification.deadline = deadlineFor(notification);
+
+  decodeImage(notification);
+  m_model->update(notification);
+  armExpiry();
+}
+
+void Queue::enqueue(Notification notification) {
+  if (m_pending.size() >= m_limits.queueSize) {
+    auto victim = std::find_if(m_pending.begin(), m_pending.end(),
+                               [](const Notification& n) {
+                                 return n.urgency != Urgency::Critical;
+                               });
+    if (victim == m_pending.end()) {
+      victim = m_pending.begin();
+    }
+    const uint32_t dropped = victim->id;
+    m_pending.erase(victim);
+    m_model->dropImage(dropped);
+    m_imageGenerations.remove(dropped);
+    emit closed(dropped, CloseReason::Expired);
+  }
+
+  decodeImage(notification);
+  m_pending.append(std::move(notification));
+  schedulePump();
+}
+
+void Queue::pump() {
+  if (m_pending.isEmpty() || m_model->count() >= m_limits.maxVisible) {
+    return;
+  }
+
+  const qint64 now = Clock::monotonicMs();
+  const qint64 wait = m_lastShown + m_limits.minInterval - now;
+  if (wait > 0) {
+    m_pumpTimer.start(static_cast<int>(wait));
+    return;
+  }
+
+  Notification next = m_pending.takeFirst();
+  next.deadline = deadlineFor(next);
+  m_model->append(next);
+  m_lastShown = now;
+
+  armExpiry();
+  schedulePump();
+}
+
+void Queue::schedulePump() {
+  if (!m_pumpTimer.isActive()) {
+    m_pumpTimer.start(0);
+  }
+}
+
+void Queue::armExpiry() {
+  qint64 earliest = std::numeric_limits<qint64>::max();
+  for (const Notification& shown : m_model->notifications()) {
+    if (shown.deadline > 0) {
+      earliest = std::min(earliest, shown.deadline);
+    }
+  }
+
+  if (earliest == std::numeric_limits<qint64>::max()) {
+    m_expiryTimer.stop();
+    return;
+  }
+  m_expiryTimer.start(static_cast<int>(
+      std::max<qint64>(earliest - Clock::monotonicMs(), 0)));
+}
+
+void Queue::expire() {
+  const qint64 now = Clock::monotonicMs();
+
+  QList<uint32_t> expired;
+  for (const Notification& shown : m_model->notifications()) {
+    if (shown.deadline > 0 && shown.deadline <= now) {
+      expired.append(shown.id);
+    }
+  }
+  for (const uint32_t id : expired) {
+    close(id, CloseReason::Expired);
+  }
+  armExpiry();
+}
+
+void Queue::decodeImage(const Notification& notification) {
+  if (!notification.image.isValid() && notification.imagePath.isEmpty()) {
+    return;
+  }
+  const uint32_t generation = ++m_imageGenerations[notification.id];
+  m_decoder.decode(notification.id, generation, notification.image,
+                   notification.imagePath);
+}
+
+void Queue::onDecoded(const uint32_t id, const uint32_t generation,
+                      const QImage& image) {
+  // Closed or replaced while decoding
+  if (m_imageGenerations.value(id) != generation || image.isNull()) {
+    return;
+  }
+  m_model->setImage(id, image);
+}
+
+qint64 Queue::deadlineFor(const Notification& notification) const {
+  if (notification.urgency == Urgency::Critical ||
+      notification.expireTimeout == 0) {
+    return 0;
+  }
+  const int timeout = notification.expireTimeout < 0
+                          ? m_limits.defaultTimeout
+                          : notification.expireTimeout;
+  return Clock::monotonicMs() + timeout;
+}
+
+qsizetype Queue::findPending(const uint32_t id) const {
+  for (qsizetype i = 0; i < m_pending.size(); i++) {
+    if (m_pending.at(i).id == id) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+} // namespace Notify
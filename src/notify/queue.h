@@ -0,0 +1,86 @@
+#pragma once
+
+#include <qlist.h>
+#include <qobject.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+#include "src/notify/imagedecoder.h"
+#include "src/notify/model.h"
+#include "src/notify/notification.h"
+
+namespace Notify {
+
+/**
+ * @class Queue
+ * @brief Decides what reaches the screen, and when.
+ *
+ * A new notification first tries to merge: with the one it replaces, or
+ * with a shown or waiting notification of the same application, which then
+ * only counts up. Otherwise it waits in a bounded queue. The oldest
+ * non-critical entry is dropped when the queue is full. Waiting entries are
+ * shown one per minimum interval, up to the visible limit. A burst of
+ * hundreds of notifications therefore costs a few model updates, not
+ * hundreds of toasts.
+ *
+ * Expiry uses one timer armed for the earliest deadline.
+ */
+class Queue final : public QObject {
+  Q_OBJECT
+
+public:
+  struct Limits {
+    int queueSize = 32;
+    int maxVisible = 3;
+    int minInterval = 250;    ///< ms between two toasts appearing
+    int defaultTimeout = 5000; ///< ms for expireTimeout -1
+  };
+
+  explicit Queue(NotifyModelRef model, QObject* parent = nullptr);
+  ~Queue() override;
+
+  void setLimits(const Limits& limits);
+  /// Image size of a toast in device pixels
+  void setImageSize(int size) { m_decoder.setSize(size); }
+
+  /// @return The id the notification is known under
+  uint32_t notify(Notification notification, uint32_t replacesId);
+  /// @return False if no such notification exists
+  bool close(uint32_t id, CloseReason reason);
+
+signals:
+  void closed(uint32_t id, Notify::CloseReason reason);
+  void actionInvoked(uint32_t id, const QString& key);
+  /// Every notification as it arrives, before merging, for the recorder
+  void received(const Notify::Notification& notification, uint32_t replacesId);
+
+private:
+  /// Replaces the toast at @p row in place, counting up if @p merged
+  void updateVisible(qsizetype row, Notification notification, bool merged);
+  void enqueue(Notification notification);
+  void pump();
+  void schedulePump();
+  void armExpiry();
+  void expire();
+  void decodeImage(const Notification& notification);
+  void onDecoded(uint32_t id, uint32_t generation, const QImage& image);
+
+  [[nodiscard]] qint64 deadlineFor(const Notification& notification) const;
+  [[nodiscard]] qsizetype findPending(uint32_t id) const;
+
+  NotifyModelRef m_model;
+  Limits m_limits;
+
+  QList<Notification> m_pending;
+  uint32_t m_nextId = 1;
+  qint64 m_lastShown = 0;
+
+  QTimer m_pumpTimer;
+  QTimer m_expiryTimer;
+
+  ImageDecoder m_decoder;
+  /// Latest decode per id, older results are dropped
+  QHash<uint32_t, uint32_t> m_imageGenerations;
+};
+
+} // namespace Notify
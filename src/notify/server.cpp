@@ -0,0 +1,114 @@
+#include "server.h"
+
+#include <algorithm>
+#include <qcoreapplication.h>
+#include <qdbusargument.h>
+#include <qdbusconnection.h>
+#include <qdbusmessage.h>
+#include <qdebug.h>
+#include <qlogging.h>
+
+namespace Notify {
+
+namespace {
+
+constexpr auto kService = "org.freedesktop.Notifications";
+constexpr auto kPath = "/org/freedesktop/Notifications";
+
+} // namespace
+
+Server::Server(Queue* queue, QObject* parent)
+    : QObject{parent}, m_queue{queue} {
+  connect(m_queue, &Queue::closed, this,
+          [this](const uint32_t id, const CloseReason reason) {
+            emit NotificationClosed(id, static_cast<uint>(reason));
+          });
+  connect(m_queue, &Queue::actionInvoked, this, &Server::ActionInvoked);
+}
+
+Server::~Server() = default;
+
+bool Server::registerOnBus() {
+  QDBusConnection bus = QDBusConnection::sessionBus();
+
+  if (!bus.registerObject(kPath, this,
+                          QDBusConnection::ExportAllSlots |
+                              QDBusConnection::ExportAllSignals)) {
+    return false;
+  }
+
+  if (!bus.registerService(kService)) {
+    bus.unregisterObject(kPath);
+    qWarning() << "Notify: another notification daemon is running";
+    return false;
+  }
+
+  qDebug() << "Notify: acting as notification daemon";
+  return true;
+}
+
+QStringList Server::GetCapabilities() const {
+  return {"body", "actions", "icon-static", "persistence"};
+}
+
+uint Server::Notify(const QString& appName, const uint replacesId,
+                    const QString& appIcon, const QString& summary,
+                    const QString& body, const QStringList& actions,
+                    const QVariantMap& hints, const int expireTimeout) {
+  Notification notification;
+  notification.appName = appName;
+  notification.summary = summary;
+  notification.body = body;
+  notification.actions = actions;
+  notification.expireTimeout = expireTimeout;
+
+  if (const auto it = hints.constFind("urgency"); it != hints.cend()) {
+    notification.urgency =
+        static_cast<Urgency>(std::min(it->toUInt(), 2U));
+  }
+
+  // Hint names of the current and of older specification versions
+  for (const char* key : {"image-data", "image_data", "icon_data"}) {
+    if (const auto it = hints.constFind(key); it != hints.cend()) {
+      notification.image = rawImageFromHint(*it);
+      break;
+    }
+  }
+  if (!notification.image.isValid()) {
+    notification.imagePath =
+        hints.value("image-path", hints.value("image_path")).toString();
+    if (notification.imagePath.isEmpty() && appIcon.startsWith('/')) {
+      notification.imagePath = appIcon;
+    }
+  }
+
+  return m_queue->notify(std::move(notification), replacesId);
+}
+
+void Server::CloseNotification(const uint id) {
+  m_queue->close(id, CloseReason::Closed);
+}
+
+QString Server::GetServerInformation(QString& vendor, QString& version,
+                                     QString& specVersion) const {
+  vendor = "simbar";
+  version = QCoreApplication::applicationVersion();
+  specVersion = "1.2";
+  return QCoreApplication::applicationName();
+}
+
+RawImage Server::rawImageFromHint(const QVariant& hint) {
+  RawImage image;
+  if (!hint.canConvert<QDBusArgument>()) {
+    return image;
+  }
+
+  const auto argument = hint.value<QDBusArgument>();
+  argument.beginStructure();
+  argument >> image.width >> image.height >> image.rowStride >>
+      image.hasAlpha >> image.bitsPerSample >> image.channels >> image.data;
+  argument.endStructure();
+  return image;
+}
+
+} // namespace Notify
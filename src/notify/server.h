@@ -0,0 +1,55 @@
+#pragma once
+
+#include <qdbuscontext.h>
+#include <qobject.h>
+#include <qstringlist.h>
+#include <qtmetamacros.h>
+#include <qvariant.h>
+
+#include "src/notify/queue.h"
+
+namespace Notify {
+
+/**
+ * @class Server
+ * @brief org.freedesktop.Notifications on the session bus.
+ *
+ * Only parses the call; what is shown and when is up to the Queue. The
+ * image-data hint is only unpacked here, its pixels are converted on the
+ * decoder thread.
+ *
+ * Uses the session bus as given by $DBUS_SESSION_BUS_ADDRESS, which makes it
+ * possible to run against a private dbus-daemon.
+ */
+class Server final : public QObject, protected QDBusContext {
+  Q_OBJECT
+  Q_CLASSINFO("D-Bus Interface", "org.freedesktop.Notifications")
+
+public:
+  explicit Server(Queue* queue, QObject* parent = nullptr);
+  ~Server() override;
+
+  /// Claims the notifications name on the session bus, false if taken
+  bool registerOnBus();
+
+public slots:
+  QStringList GetCapabilities() const;
+  uint Notify(const QString& appName, uint replacesId, const QString& appIcon,
+              const QString& summary, const QString& body,
+              const QStringList& actions, const QVariantMap& hints,
+              int expireTimeout);
+  void CloseNotification(uint id);
+  QString GetServerInformation(QString& vendor, QString& version,
+                               QString& specVersion) const;
+
+signals:
+  void NotificationClosed(uint id, uint reason);
+  void ActionInvoked(uint id, const QString& actionKey);
+
+private:
+  [[nodiscard]] static RawImage rawImageFromHint(const QVariant& hint);
+
+  Queue* m_queue;
+};
+
+} // namespace Notify
@@ -0,0 +1,59 @@
+#include "attribute.h"
+
+#include <fcntl.h>
+#include <qfile.h>
+#include <unistd.h>
+#include <utility>
+
+namespace Power {
+
+namespace {
+
+// Every attribute the provider reads is a short number or word
+constexpr qsizetype kMaxAttributeSize = 64;
+
+} // namespace
+
+Attribute::Attribute(const QString& path)
+    : m_fd{::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC)} {}
+
+Attribute::~Attribute() {
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+}
+
+Attribute::Attribute(Attribute&& other) noexcept
+    : m_fd{std::exchange(other.m_fd, -1)} {}
+
+Attribute& Attribute::operator=(Attribute&& other) noexcept {
+  if (this != &other) {
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+    m_fd = std::exchange(other.m_fd, -1);
+  }
+  return *this;
+}
+
+QByteArray Attribute::read() const {
+  if (m_fd < 0) {
+    return {};
+  }
+
+  char buffer[kMaxAttributeSize];
+  const ssize_t length = ::pread(m_fd, buffer, sizeof(buffer), 0);
+  if (length <= 0) {
+    return {};
+  }
+
+  return QByteArray(buffer, length).trimmed();
+}
+
+qint64 Attribute::readInt(const qint64 fallback) const {
+  bool ok = false;
+  const qint64 value = read().toLongLong(&ok);
+  return ok ? value : fallback;
+}
+
+} // namespace Power
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qstring.h>
+
+namespace Power {
+
+/**
+ * @class Attribute
+ * @brief One sysfs attribute behind a file descriptor kept open.
+ *
+ * Rereading is a single pread() at offset 0, with no path lookup or open().
+ * Sysfs regenerates the value on every read from the start, regular files
+ * (a fake tree for testing) behave the same.
+ */
+class Attribute {
+public:
+  Attribute() = default;
+  explicit Attribute(const QString& path);
+  ~Attribute();
+
+  Attribute(Attribute&& other) noexcept;
+  Attribute& operator=(Attribute&& other) noexcept;
+  Attribute(const Attribute&) = delete;
+  Attribute& operator=(const Attribute&) = delete;
+
+  [[nodiscard]] bool isOpen() const { return m_fd >= 0; }
+  [[nodiscard]] int fd() const { return m_fd; }
+
+  /// Trimmed contents, empty on error
+  [[nodiscard]] QByteArray read() const;
+  /// Contents as integer, @p fallback on error
+  [[nodiscard]] qint64 readInt(qint64 fallback = -1) const;
+
+private:
+  int m_fd = -1;
+};
+
+} // namespace Power
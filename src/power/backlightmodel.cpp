@@ -0,0 +1,44 @@
+#include "power/backlightmodel.h"
+
+#include <cmath>
+#include <qqmlengine.h>
+
+namespace Power {
+
+BacklightModel::BacklightModel(QObject* parent) : QObject{parent} {
+  QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+}
+
+BacklightModel::~BacklightModel() = default;
+
+void BacklightModel::setPresent(const bool present) {
+  if (m_present == present) {
+    return;
+  }
+  m_present = present;
+  emit presentChanged();
+}
+
+void BacklightModel::setBrightness(const int brightness,
+                                   const int maxBrightness) {
+  if (m_maxBrightness != maxBrightness) {
+    m_maxBrightness = maxBrightness;
+    emit maxBrightnessChanged();
+  }
+
+  if (m_brightness != brightness) {
+    m_brightness = brightness;
+    emit brightnessChanged();
+  }
+
+  const int percent =
+      maxBrightness > 0
+          ? static_cast<int>(std::lround(100.0 * brightness / maxBrightness))
+          : 0;
+  if (m_percent != percent) {
+    m_percent = percent;
+    emit percentChanged();
+  }
+}
+
+} // namespace Power
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+namespace Power {
+
+/**
+ * @class BacklightModel
+ * @brief Brightness of the first backlight device.
+ */
+class BacklightModel : public QObject {
+  Q_OBJECT
+
+  Q_PROPERTY(bool present READ present NOTIFY presentChanged)
+  Q_PROPERTY(int brightness READ brightness NOTIFY brightnessChanged)
+  Q_PROPERTY(int maxBrightness READ maxBrightness NOTIFY maxBrightnessChanged)
+  Q_PROPERTY(int percent READ percent NOTIFY percentChanged)
+
+public:
+  explicit BacklightModel(QObject* parent = nullptr);
+  ~BacklightModel() override;
+
+  [[nodiscard]] bool present() const { return m_present; }
+  void setPresent(bool present);
+
+  [[nodiscard]] int brightness() const { return m_brightness; }
+  [[nodiscard]] int maxBrightness() const { return m_maxBrightness; }
+  [[nodiscard]] int percent() const { return m_percent; }
+  void setBrightness(int brightness, int maxBrightness);
+
+signals:
+  void presentChanged();
+  void brightnessChanged();
+  void maxBrightnessChanged();
+  void percentChanged();
+
+private:
+  bool m_present = false;
+  int m_brightness = 0;
+  int m_maxBrightness = 0;
+  int m_percent = 0;
+};
+
+} // namespace Power
+
+using BacklightModelRef = std::shared_ptr<Power::BacklightModel>;
@@ -0,0 +1,53 @@
+#include "power/batterymodel.h"
+
+#include <qqmlengine.h>
+
+namespace Power {
+
+BatteryModel::BatteryModel(QObject* parent) : QObject{parent} {
+  QQmlEngine::setObjectOwnership(this, QQmlEngine::CppOwnership);
+}
+
+BatteryModel::~BatteryModel() = default;
+
+void BatteryModel::setPresent(const bool present) {
+  if (m_present == present) {
+    return;
+  }
+  m_present = present;
+  emit presentChanged();
+}
+
+void BatteryModel::setPercent(const int percent) {
+  if (m_percent == percent) {
+    return;
+  }
+  m_percent = percent;
+  emit percentChanged();
+}
+
+void BatteryModel::setStatus(const BatteryStatus status) {
+  if (m_status == status) {
+    return;
+  }
+  m_status = status;
+  emit statusChanged();
+}
+
+void BatteryModel::setOnAc(const bool onAc) {
+  if (m_onAc == onAc) {
+    return;
+  }
+  m_onAc = onAc;
+  emit onAcChanged();
+}
+
+void BatteryModel::setMinutesLeft(const int minutes) {
+  if (m_minutesLeft == minutes) {
+    return;
+  }
+  m_minutesLeft = minutes;
+  emit minutesLeftChanged();
+}
+
+} // namespace Power
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+#include "src/power/common.h"
+
+namespace Power {
+
+/**
+ * @class BatteryModel
+ * @brief Combined state of all batteries and AC adapters.
+ *
+ * With several batteries the percentage is weighted by their capacity. Each
+ * property only notifies when its value changes.
+ */
+class BatteryModel : public QObject {
+  Q_OBJECT
+
+  Q_PROPERTY(bool present READ present NOTIFY presentChanged)
+  Q_PROPERTY(int percent READ percent NOTIFY percentChanged)
+  Q_PROPERTY(Power::BatteryStatus status READ status NOTIFY statusChanged)
+  Q_PROPERTY(bool charging READ charging NOTIFY statusChanged)
+  Q_PROPERTY(bool onAc READ onAc NOTIFY onAcChanged)
+  /// Minutes until empty or full, -1 if the driver cannot tell
+  Q_PROPERTY(int minutesLeft READ minutesLeft NOTIFY minutesLeftChanged)
+
+public:
+  explicit BatteryModel(QObject* parent = nullptr);
+  ~BatteryModel() override;
+
+  [[nodiscard]] bool present() const { return m_present; }
+  void setPresent(bool present);
+
+  [[nodiscard]] int percent() const { return m_percent; }
+  void setPercent(int percent);
+
+  [[nodiscard]] BatteryStatus status() const { return m_status; }
+  [[nodiscard]] bool charging() const {
+    return m_status == BatteryStatus::Charging;
+  }
+  void setStatus(BatteryStatus status);
+
+  [[nodiscard]] bool onAc() const { return m_onAc; }
+  void setOnAc(bool onAc);
+
+  [[nodiscard]] int minutesLeft() const { return m_minutesLeft; }
+  void setMinutesLeft(int minutes);
+
+signals:
+  void presentChanged();
+  void percentChanged();
+  void statusChanged();
+  void onAcChanged();
+  void minutesLeftChanged();
+
+private:
+  bool m_present = false;
+  int m_percent = 0;
+  BatteryStatus m_status = BatteryStatus::Unknown;
+  bool m_onAc = false;
+  int m_minutesLeft = -1;
+};
+
+} // namespace Power
+
+using BatteryModelRef = std::shared_ptr<Power::BatteryModel>;
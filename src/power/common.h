@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <qobject.h>
+#include <qobjectdefs.h>
+#include <qqmlintegration.h>
+#include <qtmetamacros.h>
+
+namespace Power {
+Q_NAMESPACE
+QML_ELEMENT
+
+/// POWER_SUPPLY_STATUS of a battery
+enum class BatteryStatus : uint8_t {
+  Unknown = 0,
+  Charging,
+  Discharging,
+  NotCharging,
+  Full,
+};
+Q_ENUM_NS(BatteryStatus)
+
+} // namespace Power
@@ -0,0 +1,339 @@
+#include "power/controller.h"
+
+#include <algorithm>
+#include <qdir.h>
+#include <qlogging.h>
+#include <qsocketnotifier.h>
+
+namespace Power {
+
+namespace {
+
+/// Attribute file and uevent key of each Controller::Field, in order
+struct FieldName {
+  const char* attribute;
+  const char* property;
+};
+
+constexpr FieldName FIELD_NAMES[] = {
+    {"online", "POWER_SUPPLY_ONLINE"},
+    {"status", "POWER_SUPPLY_STATUS"},
+    {"capacity", "POWER_SUPPLY_CAPACITY"},
+    {"energy_now", "POWER_SUPPLY_ENERGY_NOW"},
+    {"energy_full", "POWER_SUPPLY_ENERGY_FULL"},
+    {"power_now", "POWER_SUPPLY_POWER_NOW"},
+    {"charge_now", "POWER_SUPPLY_CHARGE_NOW"},
+    {"charge_full", "POWER_SUPPLY_CHARGE_FULL"},
+    {"current_now", "POWER_SUPPLY_CURRENT_NOW"},
+};
+
+BatteryStatus parseStatus(const QByteArray& status) {
+  if (status == "Charging") {
+    return BatteryStatus::Charging;
+  }
+  if (status == "Discharging") {
+    return BatteryStatus::Discharging;
+  }
+  if (status == "Not charging") {
+    return BatteryStatus::NotCharging;
+  }
+  if (status == "Full") {
+    return BatteryStatus::Full;
+  }
+  return BatteryStatus::Unknown;
+}
+
+qint64 toInt(const QByteArray& value) {
+  bool ok = false;
+  const qint64 result = value.toLongLong(&ok);
+  return ok ? result : -1;
+}
+
+} // namespace
+
+Controller::Controller(QObject* parent) : QObject{parent} {
+  static_assert(std::size(FIELD_NAMES) == FieldCount);
+
+  m_batteryModel = std::make_shared<BatteryModel>();
+  m_backlightModel = std::make_shared<BacklightModel>();
+
+  connect(&m_refresh, &QTimer::timeout, this, &Controller::refreshBatteries);
+}
+
+Controller::~Controller() = default;
+
+void Controller::start(const QString& sysfsRoot,
+                       const QString& ueventSocket) {
+  m_root = sysfsRoot;
+
+  // Listen before scanning so no change falls between the two
+  m_uevents = std::make_unique<UeventSource>(
+      QList<QByteArray>{"power_supply", "backlight"});
+  if (!m_uevents->open(ueventSocket)) {
+    qWarning() << "Power: no uevents, falling back to periodic refresh";
+  }
+  connect(m_uevents.get(), &UeventSource::received, this,
+          &Controller::onUevent);
+
+  scan();
+}
+
+void Controller::setRefreshInterval(const int32_t msec) {
+  if (msec <= 0) {
+    m_refresh.stop();
+    return;
+  }
+  m_refresh.start(msec);
+}
+
+QString Controller::classPath(const char* subsystem,
+                              const QByteArray& name) const {
+  return QStringLiteral("%1/class/%2/%3")
+      .arg(m_root, QLatin1StringView(subsystem), QString::fromUtf8(name));
+}
+
+// ####################################
+// Discovery
+// ####################################
+
+void Controller::scan() {
+  m_supplies.clear();
+  const QDir supplies(m_root + "/class/power_supply");
+  for (const QString& name :
+       supplies.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name)) {
+    addSupply(name.toUtf8());
+  }
+
+  m_backlight.reset();
+  const QDir backlights(m_root + "/class/backlight");
+  const QStringList names =
+      backlights.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+  if (!names.isEmpty()) {
+    setBacklight(names.first().toUtf8());
+  }
+
+  publishBattery();
+  publishBacklight();
+}
+
+void Controller::addSupply(const QByteArray& name) {
+  removeSupply(name);
+
+  const QString path = classPath("power_supply", name);
+  auto supply = std::make_unique<Supply>();
+  supply->name = name;
+  supply->type = Attribute(path + "/type").read();
+  if (supply->type.isEmpty()) {
+    return;
+  }
+
+  for (size_t i = 0; i < FieldCount; ++i) {
+    supply->attributes[i] =
+        Attribute(path + '/' + QLatin1StringView(FIELD_NAMES[i].attribute));
+  }
+  readSupply(*supply);
+  m_supplies.push_back(std::move(supply));
+}
+
+void Controller::removeSupply(const QByteArray& name) {
+  m_supplies.erase(
+      std::remove_if(m_supplies.begin(), m_supplies.end(),
+                     [&name](const std::unique_ptr<Supply>& supply) {
+                       return supply->name == name;
+                     }),
+      m_supplies.end());
+}
+
+void Controller::setBacklight(const QByteArray& name) {
+  const QString path = classPath("backlight", name);
+  auto backlight = std::make_unique<Backlight>();
+  backlight->name = name;
+  backlight->brightness = Attribute(path + "/actual_brightness");
+  if (!backlight->brightness.isOpen()) {
+    backlight->brightness = Attribute(path + "/brightness");
+  }
+  backlight->maxBrightness = Attribute(path + "/max_brightness");
+  if (!backlight->brightness.isOpen() || !backlight->maxBrightness.isOpen()) {
+    return;
+  }
+
+  // Writes to the brightness attribute call sysfs_notify() on the device,
+  // which wakes pollers with POLLPRI. The fd was read once above, so the
+  // next notification is armed.
+  backlight->notifier = std::make_unique<QSocketNotifier>(
+      backlight->brightness.fd(), QSocketNotifier::Exception);
+  connect(backlight->notifier.get(), &QSocketNotifier::activated, this,
+          &Controller::publishBacklight);
+
+  m_backlight = std::move(backlight);
+}
+
+// ####################################
+// Updates
+// ####################################
+
+void Controller::onUevent(const Uevent& event) {
+  const QByteArray name = event.name();
+
+  if (event.subsystem == "backlight") {
+    if (event.action == "remove" && m_backlight != nullptr &&
+        m_backlight->name == name) {
+      m_backlight.reset();
+    } else if (event.action == "add" && m_backlight == nullptr) {
+      setBacklight(name);
+    }
+    publishBacklight();
+    return;
+  }
+
+  if (event.action == "remove") {
+    removeSupply(name);
+    publishBattery();
+    return;
+  }
+
+  const auto it = std::find_if(
+      m_supplies.begin(), m_supplies.end(),
+      [&name](const std::unique_ptr<Supply>& supply) {
+        return supply->name == name;
+      });
+  if (it == m_supplies.end() || event.action == "add") {
+    addSupply(name);
+    publishBattery();
+    return;
+  }
+
+  // A change event carries the whole POWER_SUPPLY_* set on most drivers,
+  // only what is missing is read back
+  Supply& supply = **it;
+  for (size_t i = 0; i < FieldCount; ++i) {
+    const auto value = event.properties.constFind(FIELD_NAMES[i].property);
+    if (value != event.properties.cend()) {
+      supply.values[i] = *value;
+    } else if (supply.attributes[i].isOpen()) {
+      supply.values[i] = supply.attributes[i].read();
+    }
+  }
+  publishBattery();
+}
+
+void Controller::readSupply(Supply& supply) {
+  for (size_t i = 0; i < FieldCount; ++i) {
+    if (supply.attributes[i].isOpen()) {
+      supply.values[i] = supply.attributes[i].read();
+    }
+  }
+}
+
+void Controller::refreshBatteries() {
+  for (const auto& supply : m_supplies) {
+    if (supply->type == "Battery") {
+      readSupply(*supply);
+    }
+  }
+  publishBattery();
+}
+
+// ####################################
+// Publishing
+// ####################################
+
+void Controller::publishBattery() {
+  bool present = false;
+  bool haveMains = false;
+  bool onAc = false;
+  bool anyCharging = false;
+  bool anyDischarging = false;
+  bool allFull = true;
+  bool anyNotCharging = false;
+
+  // Sums over all batteries, in µWh (energy) or µAh (charge)
+  qint64 now = 0;
+  qint64 full = 0;
+  qint64 rate = 0;
+  qint64 capacitySum = 0;
+  int capacityCount = 0;
+
+  for (const auto& supply : m_supplies) {
+    const auto& values = supply->values;
+    if (supply->type != "Battery") {
+      if (!values[Online].isEmpty()) {
+        haveMains = true;
+        onAc = onAc || toInt(values[Online]) == 1;
+      }
+      continue;
+    }
+
+    present = true;
+    const BatteryStatus status = parseStatus(values[Status]);
+    anyCharging = anyCharging || status == BatteryStatus::Charging;
+    anyDischarging = anyDischarging || status == BatteryStatus::Discharging;
+    anyNotCharging = anyNotCharging || status == BatteryStatus::NotCharging;
+    allFull = allFull && status == BatteryStatus::Full;
+
+    const bool energy = !values[EnergyNow].isEmpty();
+    const qint64 batteryNow = toInt(values[energy ? EnergyNow : ChargeNow]);
+    const qint64 batteryFull =
+        toInt(values[energy ? EnergyFull : ChargeFull]);
+    const qint64 batteryRate = toInt(values[energy ? PowerNow : CurrentNow]);
+    if (batteryNow >= 0 && batteryFull > 0) {
+      now += batteryNow;
+      full += batteryFull;
+      rate += std::max<qint64>(batteryRate, 0);
+    }
+
+    const qint64 capacity = toInt(values[Capacity]);
+    if (capacity >= 0) {
+      capacitySum += capacity;
+      ++capacityCount;
+    }
+  }
+
+  BatteryStatus status = BatteryStatus::Unknown;
+  if (anyCharging) {
+    status = BatteryStatus::Charging;
+  } else if (anyDischarging) {
+    status = BatteryStatus::Discharging;
+  } else if (present && allFull) {
+    status = BatteryStatus::Full;
+  } else if (anyNotCharging) {
+    status = BatteryStatus::NotCharging;
+  }
+
+  int percent = 0;
+  if (full > 0) {
+    percent = static_cast<int>(std::clamp<qint64>(now * 100 / full, 0, 100));
+  } else if (capacityCount > 0) {
+    percent = static_cast<int>(capacitySum / capacityCount);
+  }
+
+  int minutesLeft = -1;
+  if (rate > 0 && status == BatteryStatus::Discharging) {
+    minutesLeft = static_cast<int>(now * 60 / rate);
+  } else if (rate > 0 && status == BatteryStatus::Charging) {
+    minutesLeft = static_cast<int>((full - now) * 60 / rate);
+  }
+
+  m_batteryModel->setPresent(present);
+  m_batteryModel->setPercent(percent);
+  m_batteryModel->setStatus(status);
+  // Without an adapter entry, charging is the only hint of AC
+  m_batteryModel->setOnAc(haveMains ? onAc
+                                    : status == BatteryStatus::Charging);
+  m_batteryModel->setMinutesLeft(minutesLeft);
+}
+
+void Controller::publishBacklight() {
+  if (m_backlight == nullptr) {
+    m_backlightModel->setPresent(false);
+    return;
+  }
+
+  const qint64 max = m_backlight->maxBrightness.readInt(0);
+  const qint64 brightness = m_backlight->brightness.readInt(0);
+  m_backlightModel->setBrightness(static_cast<int>(brightness),
+                                  static_cast<int>(max));
+  m_backlightModel->setPresent(max > 0);
+}
+
+} // namespace Power
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <qbytearray.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qsocketnotifier.h>
+#include <qtimer.h>
+
+#include "src/power/attribute.h"
+#include "src/power/backlightmodel.h"
+#include "src/power/batterymodel.h"
+#include "src/power/uevent.h"
+
+namespace Power {
+
+/**
+ * @class Controller
+ * @brief Feeds the battery and backlight models from sysfs, driven by events.
+ *
+ * Devices are found once under <root>/class/power_supply and
+ * <root>/class/backlight, and their attributes stay open. After that only
+ * kernel uevents cause work. A power_supply uevent carries the new values,
+ * so the attributes are read only when a value is missing from it. Backlight
+ * changes made through sysfs do not raise a uevent, but the kernel notifies
+ * pollers of actual_brightness, which is watched as well.
+ *
+ * Not every battery driver raises a uevent for each percent, so batteries
+ * are also reread at a slow interval (see setRefreshInterval()).
+ */
+class Controller : public QObject {
+public:
+  Controller(QObject* parent = nullptr);
+  ~Controller() override;
+
+  /**
+   * @param sysfsRoot Usually /sys, or a fake tree for testing.
+   * @param ueventSocket Empty for kernel uevents, or a path to bind a Unix
+   * datagram socket at, to inject uevents by hand.
+   */
+  void start(const QString& sysfsRoot, const QString& ueventSocket);
+
+  /// @param msec Interval of the battery fallback reread, 0 disables it
+  void setRefreshInterval(int32_t msec);
+
+  [[nodiscard]] BatteryModelRef getBatteryModel() const {
+    return m_batteryModel;
+  }
+  [[nodiscard]] BacklightModelRef getBacklightModel() const {
+    return m_backlightModel;
+  }
+
+private:
+  enum Field : uint8_t {
+    Online,
+    Status,
+    Capacity,
+    EnergyNow,
+    EnergyFull,
+    PowerNow,
+    ChargeNow,
+    ChargeFull,
+    CurrentNow,
+    FieldCount
+  };
+
+  struct Supply {
+    QByteArray name;
+    QByteArray type; ///< Battery, Mains, USB, ...
+    std::array<Attribute, FieldCount> attributes;
+    std::array<QByteArray, FieldCount> values;
+  };
+
+  struct Backlight {
+    QByteArray name;
+    Attribute brightness;
+    Attribute maxBrightness;
+    std::unique_ptr<QSocketNotifier> notifier;
+  };
+
+  void scan();
+  void addSupply(const QByteArray& name);
+  void removeSupply(const QByteArray& name);
+  void setBacklight(const QByteArray& name);
+
+  void onUevent(const Uevent& event);
+  void readSupply(Supply& supply);
+  void refreshBatteries();
+
+  void publishBattery();
+  void publishBacklight();
+
+  [[nodiscard]] QString classPath(const char* subsystem,
+                                  const QByteArray& name) const;
+
+  QString m_root;
+  std::unique_ptr<UeventSource> m_uevents;
+  std::vector<std::unique_ptr<Supply>> m_supplies;
+  std::unique_ptr<Backlight> m_backlight;
+  QTimer m_refresh;
+
+  BatteryModelRef m_batteryModel;
+  BacklightModelRef m_backlightModel;
+};
+
+} // namespace Power
+
+using PowerController = Power::Controller;
@@ -0,0 +1,152 @@
+#include "uevent.h"
+
+#include <cerrno>
+#include <cstring>
+#include <linux/netlink.h>
+#include <qdebug.h>
+#include <qfile.h>
+#include <qlogging.h>
+#include <qsocketnotifier.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <utility>
+#include <unistd.h>
+
+namespace Power {
+
+namespace {
+
+// Uevents are at most a few KiB, the kernel caps the environment at 2 KiB
+constexpr std::size_t kBufferSize = 8192;
+
+constexpr unsigned int kKernelGroup = 1;
+
+} // namespace
+
+QByteArray Uevent::name() const {
+  return devpath.mid(devpath.lastIndexOf('/') + 1);
+}
+
+UeventSource::UeventSource(QList<QByteArray> subsystems, QObject* parent)
+    : QObject{parent}, m_subsystems{std::move(subsystems)} {}
+
+UeventSource::~UeventSource() {
+  if (m_fd >= 0) {
+    ::close(m_fd);
+  }
+  if (!m_socketPath.isEmpty()) {
+    ::unlink(QFile::encodeName(m_socketPath).constData());
+  }
+}
+
+bool UeventSource::open(const QString& socketPath) {
+  if (socketPath.isEmpty()) {
+    m_fd = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                    NETLINK_KOBJECT_UEVENT);
+    if (m_fd < 0) {
+      qWarning() << "Power: no uevent socket -" << strerror(errno);
+      return false;
+    }
+
+    sockaddr_nl address = {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = kKernelGroup;
+
+    if (::bind(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) !=
+        0) {
+      qWarning() << "Power: cannot bind uevent socket -" << strerror(errno);
+      ::close(m_fd);
+      m_fd = -1;
+      return false;
+    }
+  } else {
+    const QByteArray path = QFile::encodeName(socketPath);
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (static_cast<std::size_t>(path.size()) >= sizeof(address.sun_path)) {
+      qWarning() << "Power: uevent socket path too long" << socketPath;
+      return false;
+    }
+    std::memcpy(address.sun_path, path.constData(), path.size());
+
+    m_fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    ::unlink(path.constData());
+
+    if (m_fd < 0 || ::bind(m_fd, reinterpret_cast<sockaddr*>(&address),
+                           sizeof(address)) != 0) {
+      qWarning() << "Power: cannot bind" << socketPath << "-"
+                 << strerror(errno);
+      if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+      }
+      return false;
+    }
+
+    m_socketPath = socketPath;
+  }
+
+  m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+  connect(m_notifier, &QSocketNotifier::activated, this,
+          &UeventSource::readDatagrams);
+
+  return true;
+}
+
+void UeventSource::readDatagrams() {
+  char buffer[kBufferSize];
+
+  for (;;) {
+    const ssize_t length = ::recv(m_fd, buffer, sizeof(buffer), 0);
+    if (length <= 0) {
+      return;
+    }
+
+    Uevent event;
+    if (!parse(QByteArrayView(buffer, length), event) ||
+        !m_subsystems.contains(event.subsystem)) {
+      continue;
+    }
+
+    emit received(event);
+  }
+}
+
+bool UeventSource::parse(QByteArrayView datagram, Uevent& event) {
+  // Header "action@devpath", then NUL separated KEY=value pairs. Messages
+  // from udev (which start with "libudev") are not in this format.
+  qsizetype end = datagram.indexOf('\0');
+  if (end < 0) {
+    end = datagram.size();
+  }
+
+  const QByteArrayView header = datagram.first(end);
+  const qsizetype at = header.indexOf('@');
+  if (at <= 0) {
+    return false;
+  }
+
+  event.action = header.first(at).toByteArray();
+  event.devpath = header.sliced(at + 1).toByteArray();
+
+  while (end < datagram.size()) {
+    datagram = datagram.sliced(end + 1);
+    end = datagram.indexOf('\0');
+    if (end < 0) {
+      end = datagram.size();
+    }
+
+    const QByteArrayView pair = datagram.first(end);
+    const qsizetype equals = pair.indexOf('=');
+    if (equals > 0) {
+      event.properties.insert(pair.first(equals).toByteArray(),
+                              pair.sliced(equals + 1).toByteArray());
+    }
+  }
+
+  event.subsystem = event.properties.value("SUBSYSTEM");
+  return true;
+}
+
+} // namespace Power
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtmetamacros.h>
+
+class QSocketNotifier;
+
+namespace Power {
+
+struct Uevent {
+  QByteArray action;    ///< add, remove, change, ...
+  QByteArray subsystem; ///< power_supply, backlight, ...
+  QByteArray devpath;   ///< Relative to the sysfs root
+  QHash<QByteArray, QByteArray> properties;
+
+  /// Last component of devpath, the device name under /sys/class
+  [[nodiscard]] QByteArray name() const;
+};
+
+/**
+ * @class UeventSource
+ * @brief Kernel uevents for the subsystems of interest, without udev.
+ *
+ * By default listens on a NETLINK_KOBJECT_UEVENT socket for the kernel's own
+ * broadcasts. Alternatively binds a Unix datagram socket at a path, to which
+ * a test can send datagrams in the kernel format
+ * ("action@devpath\0KEY=value\0...").
+ */
+class UeventSource final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit UeventSource(QList<QByteArray> subsystems,
+                        QObject* parent = nullptr);
+  ~UeventSource() override;
+
+  /// @param socketPath Empty for the kernel netlink socket
+  bool open(const QString& socketPath = QString());
+
+  [[nodiscard]] static bool parse(QByteArrayView datagram, Uevent& event);
+
+signals:
+  void received(const Power::Uevent& event);
+
+private:
+  void readDatagrams();
+
+  QList<QByteArray> m_subsystems;
+  int m_fd = -1;
+  QString m_socketPath;
+  QSocketNotifier* m_notifier = nullptr;
+};
+
+} // namespace Power
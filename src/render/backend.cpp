@@ -0,0 +1,172 @@
+#include "backend.h"
+
+#include <cstdlib>
+#include <qcoreapplication.h>
+#include <qdebug.h>
+#include <qlogging.h>
+#include <qprocess.h>
+#include <qquickwindow.h>
+#include <qtguiglobal.h>
+
+#if QT_CONFIG(opengl)
+#include <qoffscreensurface.h>
+#include <qopenglcontext.h>
+#endif
+
+#if QT_CONFIG(vulkan)
+#include <qvulkaninstance.h>
+#endif
+
+namespace Render {
+
+Backend fromString(const QString& name) {
+  const QString lower = name.trimmed().toLower();
+
+  if (lower == "vulkan") {
+    return Backend::Vulkan;
+  }
+  if (lower == "opengl" || lower == "gl") {
+    return Backend::OpenGL;
+  }
+  if (lower == "software" || lower == "sw") {
+    return Backend::Software;
+  }
+
+  if (lower != "auto" && !lower.isEmpty()) {
+    qWarning() << "Unknown render backend" << name << "- using auto";
+  }
+  return Backend::Auto;
+}
+
+QString toString(const Backend backend) {
+  switch (backend) {
+  case Backend::Vulkan:
+    return "vulkan";
+  case Backend::OpenGL:
+    return "opengl";
+  case Backend::Software:
+    return "software";
+  case Backend::Auto:
+    break;
+  }
+  return "auto";
+}
+
+bool isAvailable(const Backend backend) {
+  switch (backend) {
+  case Backend::Vulkan: {
+#if QT_CONFIG(vulkan)
+    QVulkanInstance instance;
+    return instance.create();
+#else
+    return false;
+#endif
+  }
+  case Backend::OpenGL: {
+#if QT_CONFIG(opengl)
+    QOpenGLContext context;
+    if (!context.create()) {
+      return false;
+    }
+
+    QOffscreenSurface surface;
+    surface.setFormat(context.format());
+    surface.create();
+
+    const bool ok = context.makeCurrent(&surface);
+    context.doneCurrent();
+    return ok;
+#else
+    return false;
+#endif
+  }
+  case Backend::Software:
+    return true;
+  case Backend::Auto:
+    break;
+  }
+  return false;
+}
+
+Backend fallbackAfter(const Backend failed) {
+  switch (failed) {
+  case Backend::Auto:
+  case Backend::Vulkan:
+    return Backend::OpenGL;
+  case Backend::OpenGL:
+    return Backend::Software;
+  case Backend::Software:
+    break;
+  }
+  return Backend::Auto;
+}
+
+Backend select(const Settings& settings) {
+  Backend candidate = settings.backend;
+
+  if (candidate == Backend::Auto) {
+    candidate = settings.lowMemory ? Backend::Software : Backend::Vulkan;
+  }
+
+  while (candidate != Backend::Auto) {
+    if (isAvailable(candidate)) {
+      return candidate;
+    }
+
+    qWarning() << "Render backend" << toString(candidate)
+               << "is not available";
+    candidate = fallbackAfter(candidate);
+  }
+
+  return Backend::Software;
+}
+
+void apply(const Backend backend) {
+  switch (backend) {
+  case Backend::Vulkan:
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::VulkanRhi);
+    break;
+  case Backend::OpenGL:
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::OpenGLRhi);
+    break;
+  case Backend::Software:
+  case Backend::Auto:
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    break;
+  }
+}
+
+void relaunchWithFallback(const Backend failed, const QString& reason) {
+  const Backend next = fallbackAfter(failed);
+  if (next == Backend::Auto) {
+    qFatal("Render backend %s failed and no fallback is left: %s",
+           qPrintable(toString(failed)), qPrintable(reason));
+  }
+
+  qWarning() << "Render backend" << toString(failed) << "failed:" << reason;
+  qWarning() << "Relaunching with" << toString(next);
+
+  QStringList arguments = QCoreApplication::arguments();
+  const QString program = arguments.takeFirst();
+
+  // Drop any previous --backend so the fallback wins
+  for (qsizetype i = 0; i < arguments.size();) {
+    const QString& argument = arguments.at(i);
+    if (argument == "--backend" || argument == "-b") {
+      arguments.remove(i, qMin<qsizetype>(2, arguments.size() - i));
+    } else if (argument.startsWith("--backend=")) {
+      arguments.remove(i);
+    } else {
+      i++;
+    }
+  }
+  arguments << "--backend" << toString(next);
+
+  if (!QProcess::startDetached(program, arguments)) {
+    qFatal("Failed to relaunch %s", qPrintable(program));
+  }
+
+  std::exit(EXIT_SUCCESS);
+}
+
+} // namespace Render
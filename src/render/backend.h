@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <qsgrendererinterface.h>
+#include <qstring.h>
+
+namespace Render {
+
+/**
+ * @brief Graphics backends the bar can render with.
+ *
+ * Auto resolves to the first available backend in the order Vulkan, OpenGL,
+ * Software (or straight to Software in low-memory mode).
+ */
+enum class Backend : uint8_t {
+  Auto = 0,
+  Vulkan,
+  OpenGL,
+  Software,
+};
+
+struct Settings {
+  Backend backend = Backend::Auto;
+  bool lowMemory = false;
+};
+
+[[nodiscard]] Backend fromString(const QString& name);
+[[nodiscard]] QString toString(Backend backend);
+
+/**
+ * @brief Checks whether a backend can be initialized on this machine.
+ *
+ * Vulkan and OpenGL are probed by creating (and immediately destroying) an
+ * instance or context, so this must run after QGuiApplication exists and
+ * before any window is created.
+ */
+[[nodiscard]] bool isAvailable(Backend backend);
+
+/**
+ * @brief Resolves the requested backend to one that is usable.
+ *
+ * Falls back along Vulkan -> OpenGL -> Software when the requested backend is
+ * unavailable. Software is always available.
+ */
+[[nodiscard]] Backend select(const Settings& settings);
+
+/**
+ * @brief Returns the backend to try after @p failed stopped working, or
+ * Backend::Auto if there is nothing left to fall back to.
+ */
+[[nodiscard]] Backend fallbackAfter(Backend failed);
+
+/**
+ * @brief Makes @p backend the graphics API for every window created after
+ * this call.
+ */
+void apply(Backend backend);
+
+/**
+ * @brief Restarts the process with the next backend in the fallback chain.
+ *
+ * Qt Quick cannot switch graphics API once a window exists, so a scene graph
+ * initialization failure is recovered by relaunching with --backend set to
+ * the fallback. Exits the application; aborts if no fallback is left.
+ */
+[[noreturn]] void relaunchWithFallback(Backend failed, const QString& reason);
+
+} // namespace Render
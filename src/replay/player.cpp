@@ -0,0 +1,208 @@
+#include "replay/player.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <qdebug.h>
+
+#include "allocations.h"
+#include "cputime.h"
+
+namespace Replay {
+
+namespace {
+
+/// Time left for the frames of the last events before reporting
+constexpr int kSettleMs = 1000;
+/// An update without a frame for this long is not counted as latency
+constexpr qint64 kStaleNs = 1000000000;
+
+double toMs(const qint64 ns) { return static_cast<double>(ns) / 1e6; }
+
+/// Nearest-rank percentile of the sorted @p values
+qint64 percentile(const QList<qint64>& values, const double fraction) {
+  if (values.isEmpty()) {
+    return 0;
+  }
+  const auto rank = static_cast<qsizetype>(
+      std::ceil(fraction * static_cast<double>(values.size())));
+  return values.at(std::clamp<qsizetype>(rank - 1, 0, values.size() - 1));
+}
+
+} // namespace
+
+Player::Player(QObject* parent) : QObject{parent} {
+  m_clock.start();
+
+  m_timer.setSingleShot(true);
+  m_timer.setTimerType(Qt::PreciseTimer);
+  connect(&m_timer, &QTimer::timeout, this, &Player::step);
+}
+
+Player::~Player() = default;
+
+bool Player::load(const QString& path) {
+  if (!readTrace(path, m_events)) {
+    qWarning() << "Replay: cannot read trace" << path;
+    return false;
+  }
+
+  qDebug() << "Replay:" << m_events.size() << "events from" << path;
+  return true;
+}
+
+void Player::setSpeed(const double speed) { m_speed = std::max(0.0, speed); }
+
+void Player::watch(QQuickWindow* window) {
+  m_windows++;
+
+  // Both on the window's render thread, which has the GUI thread blocked
+  // while synchronizing. Events applied before the sync are in the frame.
+  auto syncNs = std::make_shared<std::atomic<qint64>>(0);
+  connect(
+      window, &QQuickWindow::beforeSynchronizing, this,
+      [this, syncNs]() {
+        syncNs->store(m_clock.nsecsElapsed(), std::memory_order_relaxed);
+      },
+      Qt::DirectConnection);
+  connect(
+      window, &QQuickWindow::frameSwapped, this,
+      [this, syncNs]() {
+        const qint64 swap = m_clock.nsecsElapsed();
+        const qint64 sync = syncNs->load(std::memory_order_relaxed);
+        m_frames.fetch_add(1, std::memory_order_relaxed);
+        QMetaObject::invokeMethod(
+            this, [this, sync, swap]() { onFrame(sync, swap); },
+            Qt::QueuedConnection);
+      },
+      Qt::DirectConnection);
+}
+
+void Player::start(const Models& models) {
+  m_models = models;
+  m_next = 0;
+
+  m_startCpuUs = Metrics::cpuTimeUs();
+  m_startAllocations = Metrics::Allocations::process().allocations;
+  m_startFrames = m_frames.load(std::memory_order_relaxed);
+  m_startNs = m_clock.nsecsElapsed();
+
+  step();
+}
+
+qint64 Player::dueNs(const Event& event) const {
+  if (m_speed <= 0) {
+    return m_startNs;
+  }
+  return m_startNs + static_cast<qint64>(
+                         static_cast<double>(event.time -
+                                             m_events.first().time) /
+                         m_speed);
+}
+
+void Player::step() {
+  while (m_next < m_events.size()) {
+    const Event& event = m_events.at(m_next);
+    const qint64 due = dueNs(event);
+    const qint64 now = m_clock.nsecsElapsed();
+    if (due > now) {
+      break;
+    }
+    if (m_speed > 0) {
+      m_maxLagNs = std::max(m_maxLagNs, now - due);
+    }
+
+    if (apply(m_models, event)) {
+      m_pendingNs.append(m_clock.nsecsElapsed());
+    } else {
+      m_unknown++;
+    }
+    m_next++;
+
+    // Unpaced, one event per pass so frames get their turn in between
+    if (m_speed <= 0) {
+      break;
+    }
+  }
+
+  if (m_next < m_events.size()) {
+    const qint64 wait = dueNs(m_events.at(m_next)) - m_clock.nsecsElapsed();
+    m_timer.start(wait > 0 ? static_cast<int>((wait + 999999) / 1000000) : 0);
+    return;
+  }
+
+  m_replayNs = m_clock.nsecsElapsed() - m_startNs;
+  QTimer::singleShot(kSettleMs, this, &Player::report);
+}
+
+void Player::onFrame(const qint64 syncNs, const qint64 swapNs) {
+  while (!m_pendingNs.isEmpty() && m_pendingNs.first() <= syncNs) {
+    const qint64 latency = swapNs - m_pendingNs.takeFirst();
+    if (latency > kStaleNs) {
+      m_withoutFrame++;
+    } else {
+      m_latenciesNs.append(latency);
+    }
+  }
+}
+
+void Player::report() {
+  const qint64 wallNs = m_clock.nsecsElapsed() - m_startNs;
+  const qint64 cpuUs = Metrics::cpuTimeUs() - m_startCpuUs;
+  const int64_t frames =
+      m_frames.load(std::memory_order_relaxed) - m_startFrames;
+  const qint64 traceNs =
+      m_events.isEmpty() ? 0 : m_events.last().time - m_events.first().time;
+
+  m_withoutFrame += m_pendingNs.size();
+  m_pendingNs.clear();
+  std::sort(m_latenciesNs.begin(), m_latenciesNs.end());
+
+  const double wallS = static_cast<double>(wallNs) / 1e9;
+  std::printf("Replay: %lld events (%lld unknown), %.1f ms of trace replayed "
+              "in %.1f ms at speed %g\n",
+              static_cast<long long>(m_events.size()),
+              static_cast<long long>(m_unknown), toMs(traceNs),
+              toMs(m_replayNs), m_speed);
+  std::printf("  cpu        %.1f ms, %.1f%% of one core over %.1f ms\n",
+              static_cast<double>(cpuUs) / 1e3,
+              wallNs > 0 ? 100.0 * static_cast<double>(cpuUs) * 1e3 /
+                               static_cast<double>(wallNs)
+                         : 0.0,
+              toMs(wallNs));
+  std::printf("  frames     %lld, %.1f/s over %d window(s)\n",
+              static_cast<long long>(frames),
+              wallS > 0 ? static_cast<double>(frames) / wallS : 0.0,
+              m_windows);
+
+  if (Metrics::Allocations::enabled()) {
+    const uint64_t allocations =
+        Metrics::Allocations::process().allocations - m_startAllocations;
+    std::printf("  allocs     %llu, %.1f per event\n",
+                static_cast<unsigned long long>(allocations),
+                m_events.isEmpty() ? 0.0
+                                   : static_cast<double>(allocations) /
+                                         static_cast<double>(m_events.size()));
+  } else {
+    std::printf("  allocs     not counted, needs SIMBAR_COUNT_ALLOCATIONS\n");
+  }
+
+  std::printf("  latency    p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f "
+              "ms over %lld updates, %lld without a frame\n",
+              toMs(percentile(m_latenciesNs, 0.50)),
+              toMs(percentile(m_latenciesNs, 0.95)),
+              toMs(percentile(m_latenciesNs, 0.99)),
+              toMs(m_latenciesNs.isEmpty() ? 0 : m_latenciesNs.last()),
+              static_cast<long long>(m_latenciesNs.size()),
+              static_cast<long long>(m_withoutFrame));
+  if (m_speed > 0) {
+    std::printf("  lag        max %.2f ms behind the trace\n",
+                toMs(m_maxLagNs));
+  }
+  std::fflush(stdout);
+
+  emit finished();
+}
+
+} // namespace Replay
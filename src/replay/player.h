@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <qelapsedtimer.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qquickwindow.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+#include "src/replay/taps.h"
+#include "src/replay/trace.h"
+
+namespace Replay {
+
+/**
+ * @class Player
+ * @brief Feeds a recorded trace back into the models and reports its cost.
+ *
+ * Events are applied on the GUI thread at their recorded time divided by
+ * the speed, through one precise timer armed for the next due event. Once
+ * the trace is done and the last frames are out, a report is printed to
+ * stdout:
+ * - CPU time of the process (getrusage), also relative to wall time
+ * - frames swapped by the watched windows
+ * - heap allocations, in builds with SIMBAR_COUNT_ALLOCATIONS
+ * - update latency, from applying an event to the swap of the first frame
+ *   of any watched window synchronized after it
+ * - scheduling lag, how late events were applied compared to the trace
+ *
+ * An update that changes nothing on screen is counted against the next
+ * frame. Updates that see no frame within a second are reported as such
+ * instead.
+ */
+class Player final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit Player(QObject* parent = nullptr);
+  ~Player() override;
+
+  /// @return false if @p path is not a readable trace
+  bool load(const QString& path);
+
+  /// 1 replays at the recorded pace, 0 as fast as the event loop allows
+  void setSpeed(double speed);
+
+  /// Counts the frames of @p window and measures latency against them,
+  /// call once per window of the bar
+  void watch(QQuickWindow* window);
+
+  void start(const Models& models);
+
+signals:
+  /// After the report
+  void finished();
+
+private:
+  void step();
+  [[nodiscard]] qint64 dueNs(const Event& event) const;
+  void onFrame(qint64 syncNs, qint64 swapNs);
+  void report();
+
+  QList<Event> m_events;
+  qsizetype m_next = 0;
+  double m_speed = 1.0;
+  Models m_models;
+
+  QTimer m_timer;
+  QElapsedTimer m_clock;
+  int m_windows = 0;
+
+  // Counted on the render threads
+  std::atomic<int64_t> m_frames{0};
+
+  /// Apply times of events still waiting for a frame, in order
+  QList<qint64> m_pendingNs;
+  QList<qint64> m_latenciesNs;
+  qint64 m_withoutFrame = 0;
+  qint64 m_unknown = 0;
+  qint64 m_maxLagNs = 0;
+
+  qint64 m_startCpuUs = 0;
+  uint64_t m_startAllocations = 0;
+  int64_t m_startFrames = 0;
+  qint64 m_startNs = 0;
+  qint64 m_replayNs = 0;
+};
+
+} // namespace Replay
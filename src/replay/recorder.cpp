@@ -0,0 +1,50 @@
+#include "replay/recorder.h"
+
+#include <qcoreapplication.h>
+#include <qdebug.h>
+#include <utility>
+
+namespace Replay {
+
+Recorder::Recorder(QObject* parent) : QObject{parent} {}
+
+Recorder::~Recorder() { stop(); }
+
+bool Recorder::start(const QString& path, const Models& models) {
+  stop();
+
+  if (!m_writer.open(path)) {
+    qWarning() << "Replay: cannot write trace" << path;
+    return false;
+  }
+
+  m_count = 0;
+  m_clock.start();
+  m_taps = std::make_unique<QObject>();
+  tap(models, m_taps.get(),
+      [this](Event event) { record(std::move(event)); });
+
+  connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+          m_taps.get(), [this]() { m_writer.flush(); });
+
+  qDebug() << "Replay: recording to" << path;
+  return true;
+}
+
+void Recorder::stop() {
+  if (!m_writer.isOpen()) {
+    return;
+  }
+
+  m_taps.reset();
+  m_writer.close();
+  qDebug() << "Replay: recorded" << m_count << "events";
+}
+
+void Recorder::record(Event event) {
+  event.time = m_clock.nsecsElapsed();
+  m_writer.write(event);
+  m_count++;
+}
+
+} // namespace Replay
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <qelapsedtimer.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtmetamacros.h>
+
+#include "src/replay/taps.h"
+#include "src/replay/trace.h"
+
+namespace Replay {
+
+/**
+ * @class Recorder
+ * @brief Writes the updates going into the models to a trace file.
+ *
+ * Every event is stamped with the monotonic time since start(), so a replay
+ * reproduces bursts, storms and flapping with their original spacing. The
+ * file is flushed when the application quits and whenever the QFile buffer
+ * fills up.
+ */
+class Recorder final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit Recorder(QObject* parent = nullptr);
+  ~Recorder() override;
+
+  /// Truncates @p path and records the updates of @p models into it
+  bool start(const QString& path, const Models& models);
+  /// Disconnects from the models and closes the trace
+  void stop();
+
+  [[nodiscard]] qint64 count() const { return m_count; }
+
+private:
+  void record(Event event);
+
+  TraceWriter m_writer;
+  QElapsedTimer m_clock;
+  qint64 m_count = 0;
+  /// Receiver of every tap, deleting it disconnects them all
+  std::unique_ptr<QObject> m_taps;
+};
+
+} // namespace Replay
@@ -0,0 +1,305 @@
+#include "taps.h"
+
+#include <qabstractitemmodel.h>
+#include <qvariant.h>
+#include <utility>
+
+namespace Replay {
+
+namespace {
+
+QVariantMap toVariant(const Compositor::Workspace& workspace) {
+  return {
+      {"id", workspace.id},
+      {"number", workspace.number},
+      {"name", workspace.name},
+      {"focused", workspace.focused},
+      {"urgent", workspace.urgent},
+  };
+}
+
+Compositor::Workspace toWorkspace(const QVariantMap& map) {
+  return {
+      .id = map.value("id").toLongLong(),
+      .number = map.value("number").toInt(),
+      .name = map.value("name").toString(),
+      .focused = map.value("focused").toBool(),
+      .urgent = map.value("urgent").toBool(),
+  };
+}
+
+QVariantMap toVariant(const Notify::Notification& notification,
+                      const uint32_t replacesId) {
+  const Notify::RawImage& image = notification.image;
+  return {
+      {"replacesId", replacesId},
+      {"appName", notification.appName},
+      {"summary", notification.summary},
+      {"body", notification.body},
+      {"actions", notification.actions},
+      {"urgency", static_cast<int>(notification.urgency)},
+      {"expireTimeout", notification.expireTimeout},
+      {"imagePath", notification.imagePath},
+      {"imageWidth", image.width},
+      {"imageHeight", image.height},
+      {"imageRowStride", image.rowStride},
+      {"imageHasAlpha", image.hasAlpha},
+      {"imageBitsPerSample", image.bitsPerSample},
+      {"imageChannels", image.channels},
+      {"imageData", image.data},
+  };
+}
+
+Notify::Notification toNotification(const QVariantMap& map) {
+  Notify::Notification notification;
+  notification.appName = map.value("appName").toString();
+  notification.summary = map.value("summary").toString();
+  notification.body = map.value("body").toString();
+  notification.actions = map.value("actions").toStringList();
+  notification.urgency =
+      static_cast<Notify::Urgency>(map.value("urgency").toInt());
+  notification.expireTimeout = map.value("expireTimeout").toInt();
+  notification.imagePath = map.value("imagePath").toString();
+
+  Notify::RawImage& image = notification.image;
+  image.width = map.value("imageWidth").toInt();
+  image.height = map.value("imageHeight").toInt();
+  image.rowStride = map.value("imageRowStride").toInt();
+  image.hasAlpha = map.value("imageHasAlpha").toBool();
+  image.bitsPerSample = map.value("imageBitsPerSample").toInt();
+  image.channels = map.value("imageChannels").toInt();
+  image.data = map.value("imageData").toByteArray();
+
+  return notification;
+}
+
+void tapWorkspaces(Compositor::WorkspaceModel* model, QObject* context,
+                   const Sink& sink) {
+  auto upsertRows = [model, sink](const int first, const int last) {
+    for (int row = first; row <= last; row++) {
+      sink({.source = "workspaces",
+            .key = "upsert",
+            .value = toVariant(model->workspaces().at(row))});
+    }
+  };
+
+  QObject::connect(model, &QAbstractItemModel::rowsInserted, context,
+                   [upsertRows](const QModelIndex& /*unused*/,
+                                const int first, const int last) {
+                     upsertRows(first, last);
+                   });
+  QObject::connect(model, &QAbstractItemModel::dataChanged, context,
+                   [upsertRows](const QModelIndex& topLeft,
+                                const QModelIndex& bottomRight) {
+                     upsertRows(topLeft.row(), bottomRight.row());
+                   });
+  QObject::connect(
+      model, &QAbstractItemModel::rowsAboutToBeRemoved, context,
+      [model, sink](const QModelIndex& /*unused*/, const int first,
+                    const int last) {
+        for (int row = first; row <= last; row++) {
+          sink({.source = "workspaces",
+                .key = "remove",
+                .value = model->workspaces().at(row).id});
+        }
+      });
+  QObject::connect(model, &QAbstractItemModel::modelReset, context,
+                   [model, sink]() {
+                     QVariantList workspaces;
+                     for (const auto& workspace : model->workspaces()) {
+                       workspaces.append(toVariant(workspace));
+                     }
+                     sink({.source = "workspaces",
+                           .key = "reset",
+                           .value = workspaces});
+                   });
+}
+
+void tapBattery(Power::BatteryModel* model, QObject* context,
+                const Sink& sink) {
+  using Power::BatteryModel;
+  QObject::connect(model, &BatteryModel::presentChanged, context,
+                   [model, sink]() {
+                     sink({.source = "battery",
+                           .key = "present",
+                           .value = model->present()});
+                   });
+  QObject::connect(model, &BatteryModel::percentChanged, context,
+                   [model, sink]() {
+                     sink({.source = "battery",
+                           .key = "percent",
+                           .value = model->percent()});
+                   });
+  QObject::connect(model, &BatteryModel::statusChanged, context,
+                   [model, sink]() {
+                     sink({.source = "battery",
+                           .key = "status",
+                           .value = static_cast<int>(model->status())});
+                   });
+  QObject::connect(model, &BatteryModel::onAcChanged, context,
+                   [model, sink]() {
+                     sink({.source = "battery",
+                           .key = "onAc",
+                           .value = model->onAc()});
+                   });
+  QObject::connect(model, &BatteryModel::minutesLeftChanged, context,
+                   [model, sink]() {
+                     sink({.source = "battery",
+                           .key = "minutesLeft",
+                           .value = model->minutesLeft()});
+                   });
+}
+
+void tapBacklight(Power::BacklightModel* model, QObject* context,
+                  const Sink& sink) {
+  using Power::BacklightModel;
+  QObject::connect(model, &BacklightModel::presentChanged, context,
+                   [model, sink]() {
+                     sink({.source = "backlight",
+                           .key = "present",
+                           .value = model->present()});
+                   });
+
+  // Both come from one setter, the second event replays as a no-op
+  auto brightness = [model, sink]() {
+    sink({.source = "backlight",
+          .key = "brightness",
+          .value = QVariantList{model->brightness(), model->maxBrightness()}});
+  };
+  QObject::connect(model, &BacklightModel::brightnessChanged, context,
+                   brightness);
+  QObject::connect(model, &BacklightModel::maxBrightnessChanged, context,
+                   brightness);
+}
+
+bool applyWorkspaces(Compositor::WorkspaceModel* model, const Event& event) {
+  if (event.key == "upsert") {
+    model->upsert(toWorkspace(event.value.toMap()));
+  } else if (event.key == "remove") {
+    model->remove(event.value.toLongLong());
+  } else if (event.key == "reset") {
+    QList<Compositor::Workspace> workspaces;
+    for (const auto& workspace : event.value.toList()) {
+      workspaces.append(toWorkspace(workspace.toMap()));
+    }
+    model->reset(std::move(workspaces));
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool applyBattery(Power::BatteryModel* model, const Event& event) {
+  if (event.key == "present") {
+    model->setPresent(event.value.toBool());
+  } else if (event.key == "percent") {
+    model->setPercent(event.value.toInt());
+  } else if (event.key == "status") {
+    model->setStatus(static_cast<Power::BatteryStatus>(event.value.toInt()));
+  } else if (event.key == "onAc") {
+    model->setOnAc(event.value.toBool());
+  } else if (event.key == "minutesLeft") {
+    model->setMinutesLeft(event.value.toInt());
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool applyBacklight(Power::BacklightModel* model, const Event& event) {
+  if (event.key == "present") {
+    model->setPresent(event.value.toBool());
+  } else if (event.key == "brightness") {
+    const QVariantList values = event.value.toList();
+    if (values.size() != 2) {
+      return false;
+    }
+    model->setBrightness(values.at(0).toInt(), values.at(1).toInt());
+  } else {
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+void tap(const Models& models, QObject* context, const Sink& sink) {
+  if (auto* model = models.bluetooth.get()) {
+    QObject::connect(model, &Bluetooth::Model::stateChanged, context,
+                     [sink](const Bluetooth::State state) {
+                       sink({.source = "bluetooth",
+                             .key = "state",
+                             .value = static_cast<int>(state)});
+                     });
+  }
+
+  if (auto* model = models.workspaces.get()) {
+    tapWorkspaces(model, context, sink);
+  }
+
+  if (auto* model = models.title.get()) {
+    QObject::connect(model, &Compositor::TitleModel::titleChanged, context,
+                     [model, sink]() {
+                       sink({.source = "title",
+                             .key = "title",
+                             .value = model->title()});
+                     });
+  }
+
+  if (auto* model = models.battery.get()) {
+    tapBattery(model, context, sink);
+  }
+
+  if (auto* model = models.backlight.get()) {
+    tapBacklight(model, context, sink);
+  }
+
+  if (auto* queue = models.notifications) {
+    QObject::connect(queue, &Notify::Queue::received, context,
+                     [sink](const Notify::Notification& notification,
+                            const uint32_t replacesId) {
+                       sink({.source = "notifications",
+                             .key = "notify",
+                             .value = toVariant(notification, replacesId)});
+                     });
+  }
+}
+
+bool apply(const Models& models, const Event& event) {
+  if (event.source == "bluetooth" && models.bluetooth && event.key == "state") {
+    models.bluetooth->setState(
+        static_cast<Bluetooth::State>(event.value.toInt()));
+    return true;
+  }
+
+  if (event.source == "workspaces" && models.workspaces) {
+    return applyWorkspaces(models.workspaces.get(), event);
+  }
+
+  if (event.source == "title" && models.title && event.key == "title") {
+    models.title->setTitle(event.value.toString());
+    return true;
+  }
+
+  if (event.source == "battery" && models.battery) {
+    return applyBattery(models.battery.get(), event);
+  }
+
+  if (event.source == "backlight" && models.backlight) {
+    return applyBacklight(models.backlight.get(), event);
+  }
+
+  // Ids are handed out in arrival order, so a trace recorded from startup
+  // replaces the same notifications again
+  if (event.source == "notifications" && models.notifications != nullptr &&
+      event.key == "notify") {
+    const QVariantMap map = event.value.toMap();
+    models.notifications->notify(toNotification(map),
+                                 map.value("replacesId").toUInt());
+    return true;
+  }
+
+  return false;
+}
+
+} // namespace Replay
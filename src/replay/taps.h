@@ -0,0 +1,47 @@
+#pragma once
+
+#include <functional>
+#include <qobject.h>
+
+#include "src/bluetooth/model.h"
+#include "src/compositor/titlemodel.h"
+#include "src/compositor/workspacemodel.h"
+#include "src/notify/queue.h"
+#include "src/power/backlightmodel.h"
+#include "src/power/batterymodel.h"
+#include "src/replay/trace.h"
+
+namespace Replay {
+
+/// The models a trace is recorded from and replayed into, any may be null
+struct Models {
+  BluetoothModelRef bluetooth;
+  WorkspaceModelRef workspaces;
+  TitleModelRef title;
+  BatteryModelRef battery;
+  BacklightModelRef backlight;
+  Notify::Queue* notifications = nullptr;
+};
+
+/// Receives an event without its time, the recorder stamps it
+using Sink = std::function<void(Event)>;
+
+/**
+ * @brief Connects the update signals of @p models to @p sink.
+ *
+ * Properties are recorded with their new value, workspaces per row as the
+ * upsert or remove that changed them and notifications as they arrive at
+ * the queue, before any merging. Connections go through @p context and end
+ * with it.
+ */
+void tap(const Models& models, QObject* context, const Sink& sink);
+
+/**
+ * @brief Feeds @p event into @p models through the setters the providers
+ * use, so the models emit what they emitted while recording.
+ *
+ * @return false if the event is for an unknown or absent model.
+ */
+bool apply(const Models& models, const Event& event);
+
+} // namespace Replay
@@ -0,0 +1,85 @@
+#include "trace.h"
+
+#include <utility>
+
+namespace Replay {
+
+namespace {
+
+constexpr quint32 kMagic = 0x534d4254; // "SMBT"
+constexpr quint32 kVersion = 1;
+
+constexpr auto kStreamVersion = QDataStream::Qt_6_0;
+
+} // namespace
+
+TraceWriter::~TraceWriter() { close(); }
+
+bool TraceWriter::open(const QString& path) {
+  close();
+
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    return false;
+  }
+
+  m_stream.setDevice(&m_file);
+  m_stream.setVersion(kStreamVersion);
+  m_stream << kMagic << kVersion;
+  return m_stream.status() == QDataStream::Ok;
+}
+
+void TraceWriter::close() {
+  if (!m_file.isOpen()) {
+    return;
+  }
+
+  m_stream.setDevice(nullptr);
+  m_file.close();
+}
+
+void TraceWriter::write(const Event& event) {
+  if (!m_file.isOpen()) {
+    return;
+  }
+
+  m_stream << event.time << event.source << event.key << event.value;
+}
+
+void TraceWriter::flush() {
+  if (m_file.isOpen()) {
+    m_file.flush();
+  }
+}
+
+bool readTrace(const QString& path, QList<Event>& events) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(kStreamVersion);
+
+  quint32 magic = 0;
+  quint32 version = 0;
+  stream >> magic >> version;
+  if (stream.status() != QDataStream::Ok || magic != kMagic ||
+      version != kVersion) {
+    return false;
+  }
+
+  events.clear();
+  while (!stream.atEnd()) {
+    Event event;
+    stream >> event.time >> event.source >> event.key >> event.value;
+    if (stream.status() != QDataStream::Ok) {
+      break;
+    }
+    events.append(std::move(event));
+  }
+
+  return true;
+}
+
+} // namespace Replay
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qdatastream.h>
+#include <qfile.h>
+#include <qlist.h>
+#include <qstring.h>
+#include <qtypes.h>
+#include <qvariant.h>
+
+namespace Replay {
+
+/// One update that went into a model
+struct Event {
+  /// ns since the recording started
+  qint64 time = 0;
+  /// The model, e.g. "bluetooth" or "workspaces", see taps.h
+  QByteArray source;
+  /// The property or operation on it
+  QByteArray key;
+  QVariant value;
+};
+
+/**
+ * @class TraceWriter
+ * @brief Appends events to a trace file.
+ *
+ * A header, then one QDataStream record per event. Writes go through the
+ * QFile buffer, flush() pushes them to the file.
+ */
+class TraceWriter {
+public:
+  TraceWriter() = default;
+  ~TraceWriter();
+
+  TraceWriter(const TraceWriter&) = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+
+  /// Truncates @p path and writes the header
+  bool open(const QString& path);
+  void close();
+  [[nodiscard]] bool isOpen() const { return m_file.isOpen(); }
+
+  void write(const Event& event);
+  void flush();
+
+private:
+  QFile m_file;
+  QDataStream m_stream;
+};
+
+/**
+ * @brief Reads every event of the trace at @p path.
+ *
+ * A truncated last record, as left by a recording that was killed, is
+ * dropped.
+ *
+ * @return false if the file is missing, foreign or of another version.
+ */
+bool readTrace(const QString& path, QList<Event>& events);
+
+} // namespace Replay
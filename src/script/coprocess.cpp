@@ -0,0 +1,299 @@
+#include "coprocess.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <qdebug.h>
+#include <qlogging.h>
+#include <spawn.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+extern char** environ; // NOLINT(readability-redundant-declaration)
+
+namespace Script {
+
+namespace {
+
+constexpr int kInitialBackoffMs = 1000;
+constexpr int kMaxBackoffMs = 60 * 1000;
+constexpr qint64 kStableRunMs = 30 * 1000;
+constexpr qsizetype kReadChunk = 4096;
+constexpr qsizetype kMaxLineLength = 64 * 1024;
+/// How long a process that was told to go, or closed stdout, may linger
+constexpr int kKillDelayMs = 1000;
+/// Exit polling interval where pidfd_open() is not available
+constexpr int kPollIntervalMs = 100;
+
+/**
+ * @class Reaper
+ * @brief Collects one child process without blocking the GUI thread.
+ *
+ * The exit is watched through a pidfd, or polled on kernels without one, and
+ * the child is SIGKILLed if it is still around after kKillDelayMs. Deletes
+ * itself once the child is collected.
+ */
+class Reaper final : public QObject {
+public:
+  static void watch(const pid_t pid) { new Reaper(pid); }
+
+private:
+  explicit Reaper(const pid_t pid) : m_pid{pid} {
+#ifdef SYS_pidfd_open
+    m_pidFd = static_cast<int>(::syscall(SYS_pidfd_open, m_pid, 0));
+#endif
+    if (m_pidFd >= 0) {
+      m_notifier = new QSocketNotifier(m_pidFd, QSocketNotifier::Read, this);
+      connect(m_notifier, &QSocketNotifier::activated, this, &Reaper::collect);
+    } else {
+      m_poll.setInterval(kPollIntervalMs);
+      connect(&m_poll, &QTimer::timeout, this, &Reaper::collect);
+      m_poll.start();
+    }
+
+    m_kill.setSingleShot(true);
+    connect(&m_kill, &QTimer::timeout, this,
+            [this]() { ::kill(m_pid, SIGKILL); });
+    m_kill.start(kKillDelayMs);
+
+    // It may be gone already
+    collect();
+  }
+
+  ~Reaper() override {
+    delete m_notifier;
+    if (m_pidFd >= 0) {
+      ::close(m_pidFd);
+    }
+  }
+
+  void collect() {
+    if (m_collected || ::waitpid(m_pid, nullptr, WNOHANG) == 0) {
+      return;
+    }
+
+    // The pid may be reused from here on, never signal it again
+    m_collected = true;
+    m_kill.stop();
+    m_poll.stop();
+    if (m_notifier != nullptr) {
+      m_notifier->setEnabled(false);
+    }
+    deleteLater();
+  }
+
+  pid_t m_pid;
+  int m_pidFd = -1;
+  QSocketNotifier* m_notifier = nullptr;
+  QTimer m_poll;
+  QTimer m_kill;
+  bool m_collected = false;
+};
+
+} // namespace
+
+Coprocess::Coprocess(QObject* parent)
+    : QObject{parent}, m_backoffMs{kInitialBackoffMs} {
+  m_restartTimer.setSingleShot(true);
+  connect(&m_restartTimer, &QTimer::timeout, this, [this]() {
+    if (!spawn()) {
+      scheduleRestart();
+    }
+  });
+}
+
+Coprocess::~Coprocess() {
+  // Same as stop(), but the receivers are being destroyed, nothing is emitted
+  m_restartTimer.stop();
+  closePipe();
+  terminate();
+}
+
+void Coprocess::start(const QStringList& command) {
+  stop();
+
+  m_command = command;
+  m_backoffMs = kInitialBackoffMs;
+
+  if (!m_command.isEmpty() && !spawn()) {
+    scheduleRestart();
+  }
+}
+
+void Coprocess::stop() {
+  m_restartTimer.stop();
+  closePipe();
+
+  if (m_pid > 0) {
+    terminate();
+    emit runningChanged(false);
+  }
+}
+
+void Coprocess::terminate() {
+  if (m_pid > 0) {
+    ::kill(m_pid, SIGTERM);
+    Reaper::watch(std::exchange(m_pid, -1));
+  }
+}
+
+bool Coprocess::spawn() {
+  int fds[2];
+  if (::pipe2(fds, O_CLOEXEC | O_NONBLOCK) != 0) {
+    qWarning() << "Script: pipe failed:" << std::strerror(errno);
+    return false;
+  }
+
+  // The child's end must be blocking, scripts do not expect EAGAIN on stdout
+  ::fcntl(fds[1], F_SETFL, ::fcntl(fds[1], F_GETFL) & ~O_NONBLOCK);
+
+  QByteArrayList arguments;
+  std::vector<char*> argv;
+  arguments.reserve(m_command.size());
+  argv.reserve(m_command.size() + 1);
+  for (const auto& argument : std::as_const(m_command)) {
+    arguments.append(argument.toLocal8Bit());
+    argv.push_back(arguments.last().data());
+  }
+  argv.push_back(nullptr);
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null",
+                                   O_RDONLY, 0);
+  posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+
+  const int error =
+      ::posix_spawnp(&m_pid, argv.front(), &actions, nullptr, argv.data(),
+                     environ);
+  posix_spawn_file_actions_destroy(&actions);
+  ::close(fds[1]);
+
+  if (error != 0) {
+    qWarning() << "Script: cannot start" << m_command.first() << "-"
+               << std::strerror(error);
+    ::close(fds[0]);
+    m_pid = -1;
+    return false;
+  }
+
+  m_readFd = fds[0];
+  m_notifier = new QSocketNotifier(m_readFd, QSocketNotifier::Read, this);
+  connect(m_notifier, &QSocketNotifier::activated, this,
+          &Coprocess::onReadable);
+
+  m_uptime.start();
+  emit runningChanged(true);
+  return true;
+}
+
+void Coprocess::onReadable() {
+  bool closed = false;
+
+  for (;;) {
+    const qsizetype used = m_buffer.size();
+    m_buffer.resize(used + kReadChunk);
+
+    const ssize_t count = ::read(m_readFd, m_buffer.data() + used, kReadChunk);
+    m_buffer.resize(used + qMax<ssize_t>(count, 0));
+
+    if (count > 0) {
+      continue;
+    }
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count < 0 && errno == EAGAIN) {
+      break;
+    }
+
+    // EOF or a real error, the process is gone or stopped talking
+    closed = true;
+    break;
+  }
+
+  // Hand out every complete line as a view into the buffer. It is taken out
+  // of m_buffer first, a receiver calling start() or stop() clears that.
+  QByteArray received = std::exchange(m_buffer, {});
+  const QByteArrayView data(received);
+  const uint64_t pipe = m_pipe;
+  qsizetype start = 0;
+  for (;;) {
+    const qsizetype end = data.indexOf('\n', start);
+    if (end < 0) {
+      break;
+    }
+    emit lineReceived(data.sliced(start, end - start));
+    start = end + 1;
+
+    // The rest belongs to a process the receiver just stopped
+    if (m_pipe != pipe) {
+      return;
+    }
+  }
+
+  received.remove(0, start);
+  m_buffer = std::move(received);
+
+  if (m_buffer.size() > kMaxLineLength) {
+    qWarning() << "Script:" << m_command.first()
+               << "sent an overlong line, discarding it";
+    m_buffer.clear();
+  }
+
+  if (closed) {
+    reap();
+  }
+}
+
+void Coprocess::reap() {
+  closePipe();
+
+  if (m_pid > 0) {
+    // stdout is closed, it is most likely exiting on its own. It is collected
+    // in the background and only forced if it lingers.
+    Reaper::watch(std::exchange(m_pid, -1));
+    emit runningChanged(false);
+  }
+
+  if (m_uptime.isValid() && m_uptime.elapsed() >= kStableRunMs) {
+    m_backoffMs = kInitialBackoffMs;
+  }
+
+  scheduleRestart();
+}
+
+void Coprocess::scheduleRestart() {
+  if (m_command.isEmpty()) {
+    return;
+  }
+
+  qWarning() << "Script:" << m_command.first() << "exited, restarting in"
+             << m_backoffMs << "ms";
+
+  m_restartTimer.start(m_backoffMs);
+  m_backoffMs = qMin(m_backoffMs * 2, kMaxBackoffMs);
+}
+
+void Coprocess::closePipe() {
+  // May run from inside the notifier's own activation
+  if (m_notifier != nullptr) {
+    m_notifier->setEnabled(false);
+    m_notifier->deleteLater();
+    m_notifier = nullptr;
+  }
+
+  if (m_readFd >= 0) {
+    ::close(m_readFd);
+    m_readFd = -1;
+  }
+
+  m_buffer.clear();
+  m_pipe++;
+}
+
+} // namespace Script
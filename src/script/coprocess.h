@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <qbytearray.h>
+#include <qbytearrayview.h>
+#include <qelapsedtimer.h>
+#include <qobject.h>
+#include <qsocketnotifier.h>
+#include <qstringlist.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <sys/types.h>
+
+namespace Script {
+
+/**
+ * @class Coprocess
+ * @brief Keeps one long-running process alive and streams its stdout lines.
+ *
+ * The process is spawned once and its stdout is read through a non-blocking
+ * pipe watched by a QSocketNotifier. Complete lines are handed out as views
+ * into the receive buffer; they are only valid during the lineReceived()
+ * emission, so receivers must be direct connections that copy what they keep.
+ * A receiver may call start() or stop(), the lines still pending from the
+ * old process are then dropped.
+ *
+ * When the process exits (or closes stdout) it is restarted after a delay
+ * that doubles on each quick failure, up to a minute, and resets once a run
+ * lasted long enough.
+ *
+ * Nothing waits for a process to exit. A stopped one gets SIGTERM, one that
+ * closed stdout gets nothing, and both are collected in the background and
+ * SIGKILLed if they are still there a second later.
+ */
+class Coprocess final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit Coprocess(QObject* parent = nullptr);
+  ~Coprocess() override;
+
+  void start(const QStringList& command);
+  void stop();
+
+  [[nodiscard]] bool isRunning() const { return m_pid > 0; }
+
+signals:
+  void lineReceived(QByteArrayView line);
+  void runningChanged(bool running);
+
+private:
+  bool spawn();
+  void onReadable();
+  /// Sends SIGTERM and hands the process to the background reaper
+  void terminate();
+  void reap();
+  void scheduleRestart();
+  void closePipe();
+
+  QStringList m_command;
+  pid_t m_pid = -1;
+  int m_readFd = -1;
+
+  QSocketNotifier* m_notifier = nullptr;
+  QByteArray m_buffer;
+  /// Counts closed pipes, tells onReadable() a receiver replaced its pipe
+  uint64_t m_pipe = 0;
+
+  QTimer m_restartTimer;
+  QElapsedTimer m_uptime;
+  int m_backoffMs;
+};
+
+} // namespace Script
@@ -0,0 +1,96 @@
+#include "model.h"
+
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+
+namespace Script {
+
+Model::Model(QObject* parent) : QObject{parent} {
+  connect(&m_coprocess, &Coprocess::lineReceived, this, &Model::onLine,
+          Qt::DirectConnection);
+  connect(&m_coprocess, &Coprocess::runningChanged, this,
+          &Model::runningChanged);
+}
+
+Model::~Model() = default;
+
+void Model::setCommand(const QStringList& command) {
+  if (m_command == command) {
+    return;
+  }
+
+  m_command = command;
+  emit commandChanged();
+
+  if (m_completed) {
+    m_coprocess.start(m_command);
+  }
+}
+
+void Model::componentComplete() {
+  m_completed = true;
+  m_coprocess.start(m_command);
+}
+
+void Model::onLine(QByteArrayView line) {
+  if (line.endsWith('\r')) {
+    line.chop(1);
+  }
+
+  if (line.startsWith('{')) {
+    parseJson(line);
+    return;
+  }
+
+  setText(QString::fromUtf8(line));
+}
+
+void Model::parseJson(QByteArrayView line) {
+  // Wrap the line in place, the view is only valid during this call
+  const QByteArray raw = QByteArray::fromRawData(line.data(), line.size());
+
+  QJsonParseError error{};
+  const QJsonDocument document = QJsonDocument::fromJson(raw, &error);
+  if (error.error != QJsonParseError::NoError || !document.isObject()) {
+    setText(QString::fromUtf8(line));
+    return;
+  }
+
+  const QJsonObject object = document.object();
+
+  if (const auto value = object.value("text"); value.isString()) {
+    setText(value.toString());
+  }
+  if (const auto value = object.value("color"); value.isString()) {
+    setColor(QColor::fromString(value.toString()));
+  }
+  if (const auto value = object.value("visible"); value.isBool()) {
+    setVisible(value.toBool());
+  }
+}
+
+void Model::setText(const QString& text) {
+  if (m_text == text) {
+    return;
+  }
+  m_text = text;
+  emit textChanged();
+}
+
+void Model::setColor(const QColor& color) {
+  if (m_color == color) {
+    return;
+  }
+  m_color = color;
+  emit colorChanged();
+}
+
+void Model::setVisible(const bool visible) {
+  if (m_visible == visible) {
+    return;
+  }
+  m_visible = visible;
+  emit visibleChanged();
+}
+
+} // namespace Script
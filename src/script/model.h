@@ -0,0 +1,76 @@
+#pragma once
+
+#include <qcolor.h>
+#include <qobject.h>
+#include <qqmlintegration.h>
+#include <qqmlparserstatus.h>
+#include <qstringlist.h>
+#include <qtmetamacros.h>
+
+#include "src/script/coprocess.h"
+
+namespace Script {
+
+/**
+ * @class Model
+ * @brief Widget state fed by a persistent script.
+ *
+ * Starts @c command once as a Coprocess and updates its properties from every
+ * line the script prints. A line starting with '{' is read as a JSON object
+ * with optional "text", "color" and "visible" members, any other line is the
+ * new text as-is.
+ */
+class Model : public QObject, public QQmlParserStatus {
+  Q_OBJECT
+  QML_NAMED_ELEMENT(ScriptModel)
+  Q_INTERFACES(QQmlParserStatus)
+
+  Q_PROPERTY(QStringList command READ command WRITE setCommand NOTIFY
+                 commandChanged)
+  Q_PROPERTY(bool running READ running NOTIFY runningChanged)
+  Q_PROPERTY(QString text READ text NOTIFY textChanged)
+  Q_PROPERTY(QColor color READ color NOTIFY colorChanged)
+  Q_PROPERTY(bool hasColor READ hasColor NOTIFY colorChanged)
+  Q_PROPERTY(bool visible READ visible NOTIFY visibleChanged)
+
+public:
+  explicit Model(QObject* parent = nullptr);
+  ~Model() override;
+
+  [[nodiscard]] QStringList command() const { return m_command; }
+  void setCommand(const QStringList& command);
+
+  [[nodiscard]] bool running() const { return m_coprocess.isRunning(); }
+  [[nodiscard]] QString text() const { return m_text; }
+  [[nodiscard]] QColor color() const { return m_color; }
+  [[nodiscard]] bool hasColor() const { return m_color.isValid(); }
+  [[nodiscard]] bool visible() const { return m_visible; }
+
+  void classBegin() override {}
+  void componentComplete() override;
+
+signals:
+  void commandChanged();
+  void runningChanged();
+  void textChanged();
+  void colorChanged();
+  void visibleChanged();
+
+private:
+  void onLine(QByteArrayView line);
+  void parseJson(QByteArrayView line);
+
+  void setText(const QString& text);
+  void setColor(const QColor& color);
+  void setVisible(bool visible);
+
+  Coprocess m_coprocess;
+  QStringList m_command;
+  bool m_completed = false;
+
+  QString m_text;
+  QColor m_color;
+  bool m_visible = true;
+};
+
+} // namespace Script
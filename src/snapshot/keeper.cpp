@@ -0,0 +1,152 @@
+#include "keeper.h"
+
+#include <qcoreapplication.h>
+#include <qdebug.h>
+#include <qelapsedtimer.h>
+#include <qlogging.h>
+#include <qquickitem.h>
+
+namespace Snapshot {
+
+namespace {
+
+/// Longest the splash may hold up startup waiting for its first paint
+constexpr int kPresentTimeoutMs = 50;
+
+} // namespace
+
+Keeper::Keeper(QObject* parent) : QObject{parent} {
+  m_timer.setTimerType(Qt::VeryCoarseTimer);
+  connect(&m_timer, &QTimer::timeout, this, &Keeper::save);
+  connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this,
+          &Keeper::save);
+}
+
+Keeper::~Keeper() = default;
+
+void Keeper::setInterval(const int32_t msec) {
+  if (msec <= 0) {
+    m_timer.stop();
+    return;
+  }
+  m_timer.start(msec);
+}
+
+void Keeper::setTarget(const int width, const int height, const qreal ratio,
+                       const QString& theme) {
+  m_fingerprint = fingerprint(width, height, ratio, theme);
+  m_ratio = ratio;
+}
+
+void Keeper::showSplash() {
+  QElapsedTimer elapsed;
+  elapsed.start();
+
+  if (!m_file.open(m_path)) {
+    return;
+  }
+  if (m_file.frame().isNull() || m_file.state().fingerprint != m_fingerprint) {
+    return;
+  }
+
+  QImage frame = m_file.frame();
+  frame.setDevicePixelRatio(m_ratio);
+
+  m_splash = std::make_unique<Splash>(std::move(frame));
+  m_splash->present(kPresentTimeoutMs);
+  qDebug() << "Snapshot: cached frame on screen after" << elapsed.elapsed()
+           << "ms";
+}
+
+void Keeper::attach(const ApplicationViewPtr& appView) {
+  if (appView == nullptr) {
+    qWarning() << "Snapshot: no view to attach to";
+    closeSplash();
+    return;
+  }
+
+  m_view = appView;
+
+  restore(&appView->asView());
+  for (auto* regionView : appView->regionViews()) {
+    restore(regionView);
+  }
+
+  // frameSwapped comes from the render thread, this queues it to ours
+  connect(&appView->asView(), &QQuickWindow::frameSwapped, this,
+          &Keeper::closeSplash, Qt::SingleShotConnection);
+}
+
+void Keeper::save() {
+  const ApplicationViewPtr appView = m_view.lock();
+  if (appView == nullptr || m_path.isEmpty()) {
+    return;
+  }
+
+  State state;
+  state.fingerprint = m_fingerprint;
+  collectTexts(&appView->asView(), state.texts);
+  for (auto* regionView : appView->regionViews()) {
+    collectTexts(regionView, state.texts);
+  }
+
+  // Region subsurfaces are not part of the grab, keep only the state then
+  const QImage frame = appView->regionViews().isEmpty()
+                           ? appView->asView().grabWindow()
+                           : QImage();
+
+  // The splash may still show the mapping being replaced
+  closeSplash();
+  m_file.close();
+
+  if (!write(m_path, state, frame)) {
+    qWarning() << "Snapshot: cannot write" << m_path;
+  }
+}
+
+void Keeper::restore(QQuickView* view) {
+  const auto& texts = m_file.state().texts;
+  if (texts.isEmpty() || view->rootObject() == nullptr) {
+    return;
+  }
+
+  // Only widgets no provider has filled yet, live values always win
+  const auto items = view->rootObject()->findChildren<QQuickItem*>();
+  for (QQuickItem* item : items) {
+    const auto text = texts.constFind(item->objectName());
+    if (text == texts.cend() || !item->property("contentText").isValid() ||
+        !item->property("contentText").toString().isEmpty()) {
+      continue;
+    }
+    QMetaObject::invokeMethod(item, "instantUpdateText",
+                              Q_ARG(QVariant, QVariant(*text)));
+  }
+}
+
+void Keeper::collectTexts(QQuickView* view,
+                          QHash<QString, QString>& texts) const {
+  if (view->rootObject() == nullptr) {
+    return;
+  }
+
+  const auto items = view->rootObject()->findChildren<QQuickItem*>();
+  for (QQuickItem* item : items) {
+    if (item->objectName().isEmpty()) {
+      continue;
+    }
+    const QVariant text = item->property("contentText");
+    if (text.isValid()) {
+      texts.insert(item->objectName(), text.toString());
+    }
+  }
+}
+
+void Keeper::closeSplash() {
+  if (m_splash == nullptr) {
+    return;
+  }
+  m_splash->close();
+  m_splash.reset();
+}
+
+} // namespace Snapshot
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <qobject.h>
+#include <qquickview.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+#include "appview.h"
+#include "src/snapshot/snapshotfile.h"
+#include "src/snapshot/splash.h"
+
+namespace Snapshot {
+
+/**
+ * @class Keeper
+ * @brief Instant-on: keeps the last frame and widget state across restarts.
+ *
+ * At startup the cached frame is put on screen by a Splash before the
+ * graphics API and QML engine are up. Once the bar is loaded, widgets that
+ * no provider has filled yet get their cached text, so the first live frame
+ * looks like the splash and the switch is invisible. The splash closes on
+ * that first frame.
+ *
+ * The snapshot is written on quit and every interval.
+ */
+class Keeper final : public QObject {
+  Q_OBJECT
+
+public:
+  explicit Keeper(QObject* parent = nullptr);
+  ~Keeper() override;
+
+  void setPath(const QString& path) { m_path = path; }
+  /// What the bar renders with, a frame of anything else is not shown
+  void setTarget(int width, int height, qreal ratio, const QString& theme);
+  /// @param msec Interval of periodic saves, 0 for only on quit
+  void setInterval(int32_t msec);
+
+  /// Reads the snapshot and shows its frame, if it fits
+  void showSplash();
+  /// Restores the cached widget state into @p appView and keeps its snapshot.
+  /// A null view only closes the splash.
+  void attach(const ApplicationViewPtr& appView);
+
+  void save();
+
+private:
+  void restore(QQuickView* view);
+  void collectTexts(QQuickView* view, QHash<QString, QString>& texts) const;
+  void closeSplash();
+
+  QString m_path;
+  QString m_fingerprint;
+  qreal m_ratio = 1.0;
+  File m_file;
+  std::unique_ptr<Splash> m_splash;
+
+  std::weak_ptr<ApplicationView> m_view;
+  QTimer m_timer;
+};
+
+} // namespace Snapshot
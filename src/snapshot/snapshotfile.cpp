@@ -0,0 +1,138 @@
+#include "snapshotfile.h"
+
+#include <qdatastream.h>
+#include <qdir.h>
+#include <qfileinfo.h>
+#include <qsavefile.h>
+#include <qstandardpaths.h>
+
+namespace Snapshot {
+
+namespace {
+
+constexpr quint32 kMagic = 0x534d4253; // "SMBS"
+constexpr quint32 kVersion = 1;
+/// Pixels start at a multiple of this, for aligned scanlines
+constexpr qint64 kPixelAlignment = 64;
+constexpr QImage::Format kFormat = QImage::Format_ARGB32_Premultiplied;
+
+constexpr auto kStreamVersion = QDataStream::Qt_6_0;
+
+} // namespace
+
+File::~File() { close(); }
+
+bool File::open(const QString& path) {
+  close();
+
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  const qint64 size = m_file.size();
+  m_map = m_file.map(0, size);
+  if (m_map == nullptr) {
+    m_file.close();
+    return false;
+  }
+
+  const QByteArray data = QByteArray::fromRawData(
+      reinterpret_cast<const char*>(m_map), static_cast<qsizetype>(size));
+  QDataStream stream(data);
+  stream.setVersion(kStreamVersion);
+
+  quint32 magic = 0;
+  quint32 version = 0;
+  stream >> magic >> version;
+  if (magic != kMagic || version != kVersion) {
+    close();
+    return false;
+  }
+
+  qint32 width = 0;
+  qint32 height = 0;
+  qint32 bytesPerLine = 0;
+  qint64 pixelOffset = 0;
+  stream >> m_state.fingerprint >> m_state.texts >> width >> height >>
+      bytesPerLine >> pixelOffset;
+  if (stream.status() != QDataStream::Ok) {
+    close();
+    return false;
+  }
+
+  // A zero offset means the file holds the state only
+  if (pixelOffset == 0) {
+    return true;
+  }
+
+  // The QImage is built right over the mapping, every scanline it reads has
+  // to lie inside the file
+  const qint64 minBytesPerLine = static_cast<qint64>(width) * 4;
+  const qint64 pixelBytes = static_cast<qint64>(bytesPerLine) * height;
+  if (width <= 0 || height <= 0 || bytesPerLine < minBytesPerLine ||
+      pixelOffset < stream.device()->pos() || pixelOffset > size ||
+      pixelBytes > size - pixelOffset) {
+    close();
+    return false;
+  }
+
+  m_frame = QImage(m_map + pixelOffset, width, height, bytesPerLine, kFormat);
+  return true;
+}
+
+void File::close() {
+  m_frame = QImage();
+  m_state = State();
+  if (m_map != nullptr) {
+    m_file.unmap(m_map);
+    m_map = nullptr;
+  }
+  m_file.close();
+}
+
+bool write(const QString& path, const State& state, const QImage& frame) {
+  const QImage pixels =
+      frame.format() == kFormat ? frame : frame.convertToFormat(kFormat);
+
+  QByteArray header;
+  QDataStream stream(&header, QIODevice::WriteOnly);
+  stream.setVersion(kStreamVersion);
+  stream << kMagic << kVersion << state.fingerprint << state.texts
+         << static_cast<qint32>(pixels.width())
+         << static_cast<qint32>(pixels.height())
+         << static_cast<qint32>(pixels.bytesPerLine());
+
+  // The offset is part of the header, account for its own 8 bytes
+  const qint64 headerSize = header.size() + qint64(sizeof(qint64));
+  const qint64 pixelOffset =
+      pixels.isNull() ? 0
+                      : (headerSize + kPixelAlignment - 1) / kPixelAlignment *
+                            kPixelAlignment;
+  stream << pixelOffset;
+
+  QDir().mkpath(QFileInfo(path).absolutePath());
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+  file.write(header);
+  if (!pixels.isNull()) {
+    file.write(QByteArray(pixelOffset - header.size(), '\0'));
+    file.write(reinterpret_cast<const char*>(pixels.constBits()),
+               pixels.sizeInBytes());
+  }
+  return file.commit();
+}
+
+QString defaultPath() {
+  return QDir(QStandardPaths::writableLocation(
+                  QStandardPaths::GenericCacheLocation))
+      .filePath("simbar/snapshot");
+}
+
+QString fingerprint(const int width, const int height, const qreal ratio,
+                    const QString& theme) {
+  return QString("%1x%2@%3/%4").arg(width).arg(height).arg(ratio).arg(theme);
+}
+
+} // namespace Snapshot
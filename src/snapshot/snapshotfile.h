@@ -0,0 +1,65 @@
+#pragma once
+
+#include <qfile.h>
+#include <qhash.h>
+#include <qimage.h>
+#include <qstring.h>
+
+namespace Snapshot {
+
+/// Widget state restored before any provider reports in
+struct State {
+  /// Settings the frame was rendered with, see fingerprint()
+  QString fingerprint;
+  /// contentText of every TextBaseWidget, by objectName
+  QHash<QString, QString> texts;
+};
+
+/**
+ * @class File
+ * @brief A snapshot file mapped read-only.
+ *
+ * The header and state are parsed with QDataStream, the pixels follow at an
+ * aligned offset and frame() points right into the mapping. Showing the last
+ * frame needs no decoding and no copy.
+ */
+class File {
+public:
+  File() = default;
+  ~File();
+
+  File(const File&) = delete;
+  File& operator=(const File&) = delete;
+
+  /// @return false if the file is missing, foreign, of another version or
+  ///         describes a frame that does not fit in it
+  bool open(const QString& path);
+  /// Unmaps the file, frame() becomes null
+  void close();
+
+  [[nodiscard]] const State& state() const { return m_state; }
+  /// Null if the file holds no frame
+  [[nodiscard]] const QImage& frame() const { return m_frame; }
+
+private:
+  QFile m_file;
+  uchar* m_map = nullptr;
+  State m_state;
+  QImage m_frame;
+};
+
+/**
+ * @brief Writes @p state and @p frame to @p path atomically.
+ *
+ * @p frame may be null to keep only the state.
+ */
+bool write(const QString& path, const State& state, const QImage& frame);
+
+/// Default location, $XDG_CACHE_HOME/simbar/snapshot
+[[nodiscard]] QString defaultPath();
+
+/// Identifies what a frame depends on, a frame of another one is not shown
+[[nodiscard]] QString fingerprint(int width, int height, qreal ratio,
+                                  const QString& theme);
+
+} // namespace Snapshot
@@ -0,0 +1,40 @@
+#include "splash.h"
+
+#include <LayerShellQt/window.h>
+#include <qcoreapplication.h>
+#include <qdeadlinetimer.h>
+#include <qpainter.h>
+
+namespace Snapshot {
+
+Splash::Splash(QImage frame) : m_frame{std::move(frame)} {
+  auto* layerWindow = LayerShellQt::Window::get(this);
+  layerWindow->setLayer(LayerShellQt::Window::LayerOverlay);
+  layerWindow->setAnchors(LayerShellQt::Window::AnchorTop);
+  layerWindow->setKeyboardInteractivity(
+      LayerShellQt::Window::KeyboardInteractivityNone);
+
+  const QSize size = m_frame.deviceIndependentSize().toSize();
+  setGeometry(0, 0, size.width(), size.height());
+}
+
+Splash::~Splash() = default;
+
+void Splash::present(const int timeoutMs) {
+  show();
+
+  const QDeadlineTimer deadline(timeoutMs);
+  while (!m_painted && !deadline.hasExpired()) {
+    QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents,
+                                    static_cast<int>(deadline.remainingTime()));
+  }
+}
+
+void Splash::paintEvent(QPaintEvent* /*event*/) {
+  QPainter painter(this);
+  painter.setCompositionMode(QPainter::CompositionMode_Source);
+  painter.drawImage(QPointF(0, 0), m_frame);
+  m_painted = true;
+}
+
+} // namespace Snapshot
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <qimage.h>
+#include <qrasterwindow.h>
+
+namespace Snapshot {
+
+/**
+ * @class Splash
+ * @brief Shows a cached frame in the bar's place until the bar draws.
+ *
+ * A plain shared-memory window: no graphics API, no QML engine, so it is on
+ * screen a few milliseconds after startup. It sits on the overlay layer at
+ * the bar's anchor, without an exclusive zone, and is closed once the real
+ * bar has swapped its first frame underneath.
+ */
+class Splash final : public QRasterWindow {
+public:
+  explicit Splash(QImage frame);
+  ~Splash() override;
+
+  /**
+   * Shows the frame and processes events until it is painted, at most for
+   * @p timeoutMs, so it is on screen before the caller blocks on startup.
+   */
+  void present(int timeoutMs);
+
+protected:
+  void paintEvent(QPaintEvent* event) override;
+
+private:
+  QImage m_frame;
+  bool m_painted = false;
+};
+
+} // namespace Snapshot
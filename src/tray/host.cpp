@@ -0,0 +1,147 @@
+#include "host.h"
+
+#include <qcoreapplication.h>
+#include <qdbusconnection.h>
+#include <qdbusmessage.h>
+#include <qdbuspendingcall.h>
+#include <qdbuspendingreply.h>
+#include <qdbusvariant.h>
+#include <qdebug.h>
+#include <qlogging.h>
+#include <utility>
+
+namespace Tray {
+
+namespace {
+
+constexpr auto kWatcherService = "org.kde.StatusNotifierWatcher";
+constexpr auto kWatcherPath = "/StatusNotifierWatcher";
+constexpr auto kWatcherInterface = "org.kde.StatusNotifierWatcher";
+
+constexpr int kAtlasSize = 512;
+
+} // namespace
+
+Host::Host(QObject* parent)
+    : QObject{parent}, m_atlas{QSize(kAtlasSize, kAtlasSize)} {}
+
+Host::~Host() = default;
+
+void Host::start(const int iconSize) {
+  m_iconSize = iconSize;
+
+  QDBusConnection bus = QDBusConnection::sessionBus();
+  if (!bus.isConnected()) {
+    qWarning() << "Tray: no session bus";
+    return;
+  }
+
+  m_watcher.registerOnBus();
+
+  const QString hostService =
+      QString("org.kde.StatusNotifierHost-%1").arg(QCoreApplication::applicationPid());
+  bus.registerService(hostService);
+
+  bus.connect(kWatcherService, kWatcherPath, kWatcherInterface,
+              "StatusNotifierItemRegistered", this,
+              SLOT(onItemRegistered(QString)));
+  bus.connect(kWatcherService, kWatcherPath, kWatcherInterface,
+              "StatusNotifierItemUnregistered", this,
+              SLOT(onItemUnregistered(QString)));
+
+  QDBusMessage registerHost = QDBusMessage::createMethodCall(
+      kWatcherService, kWatcherPath, kWatcherInterface,
+      "RegisterStatusNotifierHost");
+  registerHost << hostService;
+  bus.asyncCall(registerHost);
+
+  registerWithWatcher();
+}
+
+void Host::registerWithWatcher() {
+  QDBusMessage message = QDBusMessage::createMethodCall(
+      kWatcherService, kWatcherPath, "org.freedesktop.DBus.Properties", "Get");
+  message << QString(kWatcherInterface)
+          << QString("RegisteredStatusNotifierItems");
+
+  auto* watcher = new QDBusPendingCallWatcher(
+      QDBusConnection::sessionBus().asyncCall(message), this);
+
+  connect(watcher, &QDBusPendingCallWatcher::finished, this,
+          [this](QDBusPendingCallWatcher* call) {
+            const QDBusPendingReply<QDBusVariant> reply = *call;
+            call->deleteLater();
+
+            if (reply.isError()) {
+              qWarning() << "Tray: watcher unavailable -"
+                         << reply.error().message();
+              return;
+            }
+
+            for (const auto& id : reply.value().variant().toStringList()) {
+              onItemRegistered(id);
+            }
+          });
+}
+
+void Host::onItemRegistered(const QString& id) {
+  for (const auto& entry : std::as_const(m_entries)) {
+    if (entry.item->id() == id) {
+      return;
+    }
+  }
+
+  const qsizetype slash = id.indexOf('/');
+  if (slash <= 0) {
+    return;
+  }
+
+  auto* item = new Item(id.left(slash), id.mid(slash), m_iconSize, this);
+  connect(item, &Item::iconChanged, this,
+          [this, item]() { onIconChanged(item); });
+
+  m_entries.append({item, 0});
+  emit entriesChanged();
+}
+
+void Host::onItemUnregistered(const QString& id) {
+  for (qsizetype i = 0; i < m_entries.size(); i++) {
+    const Entry entry = m_entries.at(i);
+    if (entry.item->id() != id) {
+      continue;
+    }
+
+    m_atlas.release(entry.iconKey);
+    entry.item->deleteLater();
+    m_entries.remove(i);
+
+    emit entriesChanged();
+    return;
+  }
+}
+
+void Host::onIconChanged(Item* item) {
+  for (auto& entry : m_entries) {
+    if (entry.item != item) {
+      continue;
+    }
+
+    const QImage& icon = item->icon();
+    const uint64_t key = icon.isNull() ? 0 : UI::TextureAtlas::contentKey(icon);
+    if (key == entry.iconKey) {
+      return;
+    }
+
+    if (key != 0 && m_atlas.acquire(key, icon).isNull()) {
+      qWarning() << "Tray: icon atlas is full, dropping icon of"
+                 << item->id();
+    }
+    m_atlas.release(entry.iconKey);
+    entry.iconKey = m_atlas.contains(key) ? key : 0;
+
+    emit iconsChanged();
+    return;
+  }
+}
+
+} // namespace Tray
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <qhash.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qqmlintegration.h>
+#include <qtmetamacros.h>
+
+#include "src/tray/item.h"
+#include "src/tray/watcher.h"
+#include "src/ui/textureatlas.h"
+
+namespace Tray {
+
+/**
+ * @class Host
+ * @brief StatusNotifierHost that keeps every tray icon in one shared atlas.
+ *
+ * Icons are keyed by content hash, so identical icons share a slot and an
+ * item re-announcing an unchanged icon costs nothing. Only a new or changed
+ * icon writes to the atlas, and each window's AtlasTexture then uploads just
+ * that region.
+ *
+ * Uses the session bus as given by $DBUS_SESSION_BUS_ADDRESS, which makes it
+ * possible to run against a private dbus-daemon with fake items.
+ */
+class Host final : public QObject {
+  Q_OBJECT
+  QML_NAMED_ELEMENT(TrayHost)
+  QML_UNCREATABLE("Provided by the engine as trayHost")
+
+public:
+  struct Entry {
+    Item* item;
+    uint64_t iconKey;
+  };
+
+  explicit Host(QObject* parent = nullptr);
+  ~Host() override;
+
+  /// Icons are rendered at @p iconSize pixels
+  void start(int iconSize);
+
+  [[nodiscard]] const QList<Entry>& entries() const { return m_entries; }
+  [[nodiscard]] const UI::TextureAtlas& atlas() const { return m_atlas; }
+  [[nodiscard]] int iconSize() const { return m_iconSize; }
+
+signals:
+  /// Items were added or removed
+  void entriesChanged();
+  /// An icon changed, entries() keeps its order
+  void iconsChanged();
+
+private slots:
+  void onItemRegistered(const QString& id);
+  void onItemUnregistered(const QString& id);
+
+private:
+  void registerWithWatcher();
+  void onIconChanged(Item* item);
+
+  int m_iconSize = 0;
+  Watcher m_watcher;
+  UI::TextureAtlas m_atlas;
+  QList<Entry> m_entries;
+};
+
+} // namespace Tray
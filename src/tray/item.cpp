@@ -0,0 +1,198 @@
+#include "item.h"
+
+#include <qdbusconnection.h>
+#include <qdbusmessage.h>
+#include <qdbuspendingcall.h>
+#include <qdbuspendingreply.h>
+#include <qdbusvariant.h>
+#include <qendian.h>
+#include <qicon.h>
+
+namespace Tray {
+
+namespace {
+
+constexpr auto kItemInterface = "org.kde.StatusNotifierItem";
+constexpr auto kPropertiesInterface = "org.freedesktop.DBus.Properties";
+
+} // namespace
+
+Item::Item(QString service, QString path, const int iconSize, QObject* parent)
+    : QObject{parent}, m_service{std::move(service)}, m_path{std::move(path)},
+      m_iconSize{iconSize} {
+  QDBusConnection bus = QDBusConnection::sessionBus();
+  bus.connect(m_service, m_path, kItemInterface, "NewIcon", this,
+              SLOT(onNewIcon()));
+  bus.connect(m_service, m_path, kItemInterface, "NewTitle", this,
+              SLOT(onNewTitle()));
+  bus.connect(m_service, m_path, kItemInterface, "NewStatus", this,
+              SLOT(onNewStatus()));
+
+  getAll();
+}
+
+Item::~Item() = default;
+
+void Item::activate(const QPoint& position) const {
+  call("Activate", position);
+}
+
+void Item::secondaryActivate(const QPoint& position) const {
+  call("SecondaryActivate", position);
+}
+
+void Item::contextMenu(const QPoint& position) const {
+  call("ContextMenu", position);
+}
+
+void Item::onNewIcon() {
+  get("IconPixmap");
+  get("IconName");
+}
+
+void Item::onNewTitle() { get("Title"); }
+
+void Item::onNewStatus() { get("Status"); }
+
+void Item::getAll() {
+  QDBusMessage message = QDBusMessage::createMethodCall(
+      m_service, m_path, kPropertiesInterface, "GetAll");
+  message << QString(kItemInterface);
+
+  auto* watcher = new QDBusPendingCallWatcher(
+      QDBusConnection::sessionBus().asyncCall(message), this);
+
+  connect(watcher, &QDBusPendingCallWatcher::finished, this,
+          [this](QDBusPendingCallWatcher* call) {
+            const QDBusPendingReply<QVariantMap> reply = *call;
+            call->deleteLater();
+
+            if (reply.isError()) {
+              return;
+            }
+
+            const QVariantMap properties = reply.value();
+            for (auto it = properties.cbegin(); it != properties.cend();
+                 ++it) {
+              applyProperty(it.key(), it.value());
+            }
+            updateIcon();
+            emit changed();
+          });
+}
+
+void Item::get(const QString& property) {
+  QDBusMessage message = QDBusMessage::createMethodCall(
+      m_service, m_path, kPropertiesInterface, "Get");
+  message << QString(kItemInterface) << property;
+
+  auto* watcher = new QDBusPendingCallWatcher(
+      QDBusConnection::sessionBus().asyncCall(message), this);
+
+  connect(watcher, &QDBusPendingCallWatcher::finished, this,
+          [this, property](QDBusPendingCallWatcher* call) {
+            const QDBusPendingReply<QDBusVariant> reply = *call;
+            call->deleteLater();
+
+            if (reply.isError()) {
+              return;
+            }
+
+            applyProperty(property, reply.value().variant());
+            if (property.startsWith("Icon")) {
+              updateIcon();
+            } else {
+              emit changed();
+            }
+          });
+}
+
+void Item::applyProperty(const QString& name, const QVariant& value) {
+  if (name == "Title") {
+    m_title = value.toString();
+  } else if (name == "Status") {
+    m_status = value.toString();
+  } else if (name == "IconName") {
+    m_iconName = value.toString();
+  } else if (name == "IconPixmap") {
+    m_pixmap = pixmapFromArgument(value.value<QDBusArgument>());
+  }
+}
+
+void Item::call(const QString& method, const QPoint& position) const {
+  QDBusMessage message =
+      QDBusMessage::createMethodCall(m_service, m_path, kItemInterface, method);
+  message << position.x() << position.y();
+  QDBusConnection::sessionBus().asyncCall(message);
+}
+
+/**
+ * IconPixmap is a(iiay): ARGB32 images in network byte order, possibly several
+ * sizes. The smallest one at least as large as the icon size wins, otherwise
+ * the largest.
+ */
+QImage Item::pixmapFromArgument(const QDBusArgument& argument) const {
+  QImage best;
+
+  argument.beginArray();
+  while (!argument.atEnd()) {
+    int width = 0;
+    int height = 0;
+    QByteArray data;
+
+    argument.beginStructure();
+    argument >> width >> height >> data;
+    argument.endStructure();
+
+    if (width <= 0 || height <= 0 ||
+        data.size() < static_cast<qsizetype>(width) * height * 4) {
+      continue;
+    }
+
+    const bool bestFits = !best.isNull() && best.width() >= m_iconSize;
+    const bool fits = width >= m_iconSize;
+    const bool better = best.isNull() || (fits && !bestFits) ||
+                        (fits && width < best.width()) ||
+                        (!fits && !bestFits && width > best.width());
+    if (!better) {
+      continue;
+    }
+
+    QImage image(width, height, QImage::Format_ARGB32);
+    const auto* source = reinterpret_cast<const uint32_t*>(data.constData());
+    for (int y = 0; y < height; y++) {
+      auto* line = reinterpret_cast<uint32_t*>(image.scanLine(y));
+      for (int x = 0; x < width; x++) {
+        line[x] = qFromBigEndian(source[y * width + x]);
+      }
+    }
+    best = image;
+  }
+  argument.endArray();
+
+  return best;
+}
+
+void Item::updateIcon() {
+  QImage icon = m_pixmap;
+  if (icon.isNull() && !m_iconName.isEmpty()) {
+    icon = QIcon::fromTheme(m_iconName)
+               .pixmap(m_iconSize, m_iconSize)
+               .toImage();
+  }
+
+  if (!icon.isNull() && icon.size() != QSize(m_iconSize, m_iconSize)) {
+    icon = icon.scaled(m_iconSize, m_iconSize, Qt::KeepAspectRatio,
+                       Qt::SmoothTransformation);
+  }
+
+  icon = icon.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+  if (icon == m_icon) {
+    return;
+  }
+
+  m_icon = icon;
+  emit iconChanged();
+}
+
+} // namespace Tray
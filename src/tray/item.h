@@ -0,0 +1,67 @@
+#pragma once
+
+#include <qdbusargument.h>
+#include <qimage.h>
+#include <qobject.h>
+#include <qpoint.h>
+#include <qstring.h>
+#include <qtmetamacros.h>
+#include <qvariant.h>
+
+namespace Tray {
+
+/**
+ * @class Item
+ * @brief Client-side proxy of one org.kde.StatusNotifierItem.
+ *
+ * Reads all properties once, then only re-reads the icon (or title, status)
+ * when the item signals that it changed. Every call is asynchronous.
+ */
+class Item final : public QObject {
+  Q_OBJECT
+
+public:
+  Item(QString service, QString path, int iconSize, QObject* parent = nullptr);
+  ~Item() override;
+
+  /// "service/path", as listed by the watcher
+  [[nodiscard]] QString id() const { return m_service + m_path; }
+
+  [[nodiscard]] const QImage& icon() const { return m_icon; }
+  [[nodiscard]] const QString& title() const { return m_title; }
+  [[nodiscard]] const QString& status() const { return m_status; }
+
+  void activate(const QPoint& position) const;
+  void secondaryActivate(const QPoint& position) const;
+  void contextMenu(const QPoint& position) const;
+
+signals:
+  void iconChanged();
+  void changed();
+
+private slots:
+  void onNewIcon();
+  void onNewTitle();
+  void onNewStatus();
+
+private:
+  void getAll();
+  void get(const QString& property);
+  void applyProperty(const QString& name, const QVariant& value);
+  void call(const QString& method, const QPoint& position) const;
+
+  [[nodiscard]] QImage pixmapFromArgument(const QDBusArgument& argument) const;
+  void updateIcon();
+
+  QString m_service;
+  QString m_path;
+  int m_iconSize;
+
+  QString m_title;
+  QString m_status;
+  QString m_iconName;
+  QImage m_pixmap;
+  QImage m_icon;
+};
+
+} // namespace Tray
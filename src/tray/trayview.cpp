@@ -0,0 +1,257 @@
+#include "trayview.h"
+
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <QSGTextureMaterial>
+#include <qevent.h>
+#include <qquickwindow.h>
+#include <qsgrendererinterface.h>
+
+#include "src/ui/atlastexture.h"
+
+namespace Tray {
+
+View::View(QQuickItem* parent) : QQuickItem{parent} {
+  setFlag(ItemHasContents, true);
+  setAcceptedMouseButtons(Qt::LeftButton | Qt::MiddleButton | Qt::RightButton);
+}
+
+void View::setHost(Host* host) {
+  if (m_host == host) {
+    return;
+  }
+
+  if (m_host != nullptr) {
+    disconnect(m_host, nullptr, this, nullptr);
+  }
+
+  m_host = host;
+
+  if (m_host != nullptr) {
+    connect(m_host, &Host::entriesChanged, this, &View::onEntriesChanged);
+    connect(m_host, &Host::iconsChanged, this, &View::markDirty);
+  }
+
+  onEntriesChanged();
+  emit hostChanged();
+}
+
+void View::setIconSize(const int iconSize) {
+  if (m_iconSize == iconSize) {
+    return;
+  }
+
+  m_iconSize = iconSize;
+  onEntriesChanged();
+  emit iconSizeChanged();
+}
+
+void View::setSpacing(const int spacing) {
+  if (m_spacing == spacing) {
+    return;
+  }
+
+  m_spacing = spacing;
+  onEntriesChanged();
+  emit spacingChanged();
+}
+
+void View::onEntriesChanged() {
+  const qsizetype count = m_host != nullptr ? m_host->entries().size() : 0;
+
+  setImplicitWidth(count > 0 ? (count * m_iconSize) + ((count - 1) * m_spacing)
+                             : 0);
+  setImplicitHeight(m_iconSize);
+  markDirty();
+}
+
+void View::markDirty() {
+  m_geometryDirty = true;
+  update();
+}
+
+void View::geometryChange(const QRectF& newGeometry,
+                          const QRectF& oldGeometry) {
+  if (newGeometry.size() != oldGeometry.size()) {
+    markDirty();
+  }
+
+  QQuickItem::geometryChange(newGeometry, oldGeometry);
+}
+
+QRectF View::iconRect(const qsizetype index) const {
+  const qreal x = static_cast<qreal>(index) * (m_iconSize + m_spacing);
+  const qreal y = (height() - m_iconSize) / 2.0;
+  return {x, y, static_cast<qreal>(m_iconSize), static_cast<qreal>(m_iconSize)};
+}
+
+qsizetype View::indexAt(const QPointF& position) const {
+  if (m_host == nullptr || position.x() < 0) {
+    return -1;
+  }
+
+  const auto index =
+      static_cast<qsizetype>(position.x() / (m_iconSize + m_spacing));
+  if (index >= m_host->entries().size() ||
+      !iconRect(index).contains(position)) {
+    return -1;
+  }
+
+  return index;
+}
+
+void View::mousePressEvent(QMouseEvent* event) {
+  const qsizetype index = indexAt(event->position());
+  if (index < 0) {
+    event->ignore();
+    return;
+  }
+
+  const Item* item = m_host->entries().at(index).item;
+  const QPoint position = mapToGlobal(event->position()).toPoint();
+
+  switch (event->button()) {
+  case Qt::LeftButton:
+    item->activate(position);
+    break;
+  case Qt::MiddleButton:
+    item->secondaryActivate(position);
+    break;
+  case Qt::RightButton:
+    item->contextMenu(position);
+    break;
+  default:
+    event->ignore();
+    return;
+  }
+
+  event->accept();
+}
+
+QSGNode* View::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) {
+  Q_UNUSED(data)
+
+  if (m_host == nullptr || m_host->entries().isEmpty() || width() <= 0 ||
+      height() <= 0) {
+    delete oldNode;
+    return nullptr;
+  }
+
+  if (window()->rendererInterface()->graphicsApi() ==
+      QSGRendererInterface::Software) {
+    return updateSoftwareNode(oldNode);
+  }
+
+  return updateBatchedNode(oldNode);
+}
+
+QSGNode* View::updateBatchedNode(QSGNode* oldNode) {
+  auto* node = static_cast<QSGGeometryNode*>(oldNode);
+  auto* texture = UI::AtlasTexture::forWindow(window(), &m_host->atlas());
+  texture->sync();
+
+  if (node == nullptr) {
+    node = new QSGGeometryNode;
+
+    auto* geometry =
+        new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+
+    auto* material = new QSGTextureMaterial;
+    material->setFiltering(QSGTexture::Linear);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+
+    m_geometryDirty = true;
+  }
+
+  auto* material = static_cast<QSGTextureMaterial*>(node->material());
+  if (material->texture() != texture) {
+    material->setTexture(texture);
+    node->markDirty(QSGNode::DirtyMaterial);
+  }
+
+  if (!m_geometryDirty) {
+    return node;
+  }
+  m_geometryDirty = false;
+
+  const auto& entries = m_host->entries();
+  const auto& atlas = m_host->atlas();
+
+  // Items without an icon yet keep their slot but draw nothing. A repack can
+  // leave a key known to the atlas without a rect, which is treated the same.
+  int quads = 0;
+  for (const auto& entry : entries) {
+    quads += atlas.find(entry.iconKey).isNull() ? 0 : 1;
+  }
+
+  QSGGeometry* geometry = node->geometry();
+  geometry->allocate(quads * 6);
+  QSGGeometry::TexturedPoint2D* vertices =
+      geometry->vertexDataAsTexturedPoint2D();
+
+  int used = 0;
+  for (qsizetype i = 0; i < entries.size(); i++) {
+    const QRect source = atlas.find(entries.at(i).iconKey);
+    if (source.isNull()) {
+      continue;
+    }
+
+    const QRectF target = iconRect(i);
+    const QRectF uv = texture->normalizedRect(source);
+
+    const float l = static_cast<float>(target.left());
+    const float r = static_cast<float>(target.right());
+    const float t = static_cast<float>(target.top());
+    const float b = static_cast<float>(target.bottom());
+    const float u0 = static_cast<float>(uv.left());
+    const float u1 = static_cast<float>(uv.left() + uv.width());
+    const float v0 = static_cast<float>(uv.top());
+    const float v1 = static_cast<float>(uv.top() + uv.height());
+
+    QSGGeometry::TexturedPoint2D* quad = vertices + used;
+    quad[0].set(l, t, u0, v0);
+    quad[1].set(r, t, u1, v0);
+    quad[2].set(l, b, u0, v1);
+    quad[3].set(r, t, u1, v0);
+    quad[4].set(r, b, u1, v1);
+    quad[5].set(l, b, u0, v1);
+    used += 6;
+  }
+
+  node->markDirty(QSGNode::DirtyGeometry);
+
+  return node;
+}
+
+QSGNode* View::updateSoftwareNode(QSGNode* oldNode) {
+  if (oldNode != nullptr && !m_geometryDirty) {
+    return oldNode;
+  }
+  m_geometryDirty = false;
+
+  delete oldNode;
+  auto* root = new QSGNode;
+
+  const auto& entries = m_host->entries();
+  for (qsizetype i = 0; i < entries.size(); i++) {
+    const QImage& icon = entries.at(i).item->icon();
+    if (icon.isNull()) {
+      continue;
+    }
+
+    QSGImageNode* image = window()->createImageNode();
+    image->setTexture(window()->createTextureFromImage(icon));
+    image->setOwnsTexture(true);
+    image->setFiltering(QSGTexture::Linear);
+    image->setRect(iconRect(i));
+    root->appendChildNode(image);
+  }
+
+  return root;
+}
+
+} // namespace Tray
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <qpointer.h>
+#include <qqmlintegration.h>
+#include <qquickitem.h>
+#include <qtmetamacros.h>
+
+#include "src/tray/host.h"
+
+namespace Tray {
+
+/**
+ * @class View
+ * @brief Draws every tray icon of a Host in a single batched node.
+ *
+ * All icons are textured quads in one geometry node sampling the host's shared
+ * atlas, so the whole tray is one draw call. The geometry is only rebuilt when
+ * items come and go, move or change icon; a changed icon additionally uploads
+ * just its atlas region.
+ *
+ * With the software renderer, which has no custom materials, each icon is an
+ * image node of its own.
+ *
+ * @property host The tray host to display.
+ * @property iconSize Edge length of one icon in pixels.
+ * @property spacing Gap between two icons in pixels.
+ */
+class View final : public QQuickItem {
+  Q_OBJECT
+  QML_NAMED_ELEMENT(TrayView)
+
+  Q_PROPERTY(Tray::Host* host READ host WRITE setHost NOTIFY hostChanged)
+  Q_PROPERTY(int iconSize READ iconSize WRITE setIconSize NOTIFY iconSizeChanged)
+  Q_PROPERTY(int spacing READ spacing WRITE setSpacing NOTIFY spacingChanged)
+
+public:
+  explicit View(QQuickItem* parent = nullptr);
+
+  [[nodiscard]] Host* host() const { return m_host; }
+  void setHost(Host* host);
+
+  [[nodiscard]] int iconSize() const { return m_iconSize; }
+  void setIconSize(int iconSize);
+
+  [[nodiscard]] int spacing() const { return m_spacing; }
+  void setSpacing(int spacing);
+
+  QSGNode* updatePaintNode(QSGNode* oldNode,
+                           UpdatePaintNodeData* data) override;
+
+signals:
+  void hostChanged();
+  void iconSizeChanged();
+  void spacingChanged();
+
+protected:
+  void geometryChange(const QRectF& newGeometry,
+                      const QRectF& oldGeometry) override;
+  void mousePressEvent(QMouseEvent* event) override;
+
+private:
+  void onEntriesChanged();
+  void markDirty();
+
+  [[nodiscard]] QRectF iconRect(qsizetype index) const;
+  [[nodiscard]] qsizetype indexAt(const QPointF& position) const;
+
+  QSGNode* updateBatchedNode(QSGNode* oldNode);
+  QSGNode* updateSoftwareNode(QSGNode* oldNode);
+
+  QPointer<Host> m_host;
+  int m_iconSize = 22;
+  int m_spacing = 6;
+  bool m_geometryDirty = true;
+};
+
+} // namespace Tray
@@ -0,0 +1,92 @@
+#include "watcher.h"
+
+#include <qdbusconnection.h>
+#include <qdbusconnectioninterface.h>
+#include <qdebug.h>
+#include <qlogging.h>
+
+namespace Tray {
+
+namespace {
+
+constexpr auto kWatcherService = "org.kde.StatusNotifierWatcher";
+constexpr auto kWatcherPath = "/StatusNotifierWatcher";
+constexpr auto kDefaultItemPath = "/StatusNotifierItem";
+
+} // namespace
+
+Watcher::Watcher(QObject* parent) : QObject{parent} {
+  m_serviceWatcher.setConnection(QDBusConnection::sessionBus());
+  m_serviceWatcher.setWatchMode(QDBusServiceWatcher::WatchForUnregistration);
+
+  connect(&m_serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this,
+          &Watcher::onServiceUnregistered);
+}
+
+Watcher::~Watcher() = default;
+
+bool Watcher::registerOnBus() {
+  QDBusConnection bus = QDBusConnection::sessionBus();
+
+  if (!bus.registerObject(kWatcherPath, this,
+                          QDBusConnection::ExportAllSlots |
+                              QDBusConnection::ExportAllSignals |
+                              QDBusConnection::ExportAllProperties)) {
+    return false;
+  }
+
+  if (!bus.registerService(kWatcherService)) {
+    bus.unregisterObject(kWatcherPath);
+    return false;
+  }
+
+  qDebug() << "Tray: acting as StatusNotifierWatcher";
+  return true;
+}
+
+void Watcher::RegisterStatusNotifierItem(const QString& serviceOrPath) {
+  // Some clients send their object path and expect the sender's name
+  QString service = serviceOrPath;
+  QString path = kDefaultItemPath;
+  if (serviceOrPath.startsWith('/')) {
+    service = message().service();
+    path = serviceOrPath;
+  }
+
+  const QString item = service + path;
+  if (m_items.contains(item)) {
+    return;
+  }
+
+  m_items.append(item);
+  m_serviceWatcher.addWatchedService(service);
+  emit StatusNotifierItemRegistered(item);
+}
+
+void Watcher::RegisterStatusNotifierHost(const QString& service) {
+  if (m_hosts.contains(service)) {
+    return;
+  }
+
+  m_hosts.append(service);
+  m_serviceWatcher.addWatchedService(service);
+  emit StatusNotifierHostRegistered();
+}
+
+void Watcher::onServiceUnregistered(const QString& service) {
+  for (qsizetype i = m_items.size() - 1; i >= 0; i--) {
+    const QString item = m_items.at(i);
+    if (item.startsWith(service + '/')) {
+      m_items.remove(i);
+      emit StatusNotifierItemUnregistered(item);
+    }
+  }
+
+  if (m_hosts.removeAll(service) > 0 && m_hosts.isEmpty()) {
+    emit StatusNotifierHostUnregistered();
+  }
+
+  m_serviceWatcher.removeWatchedService(service);
+}
+
+} // namespace Tray
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <qdbuscontext.h>
+#include <qdbusservicewatcher.h>
+#include <qobject.h>
+#include <qstringlist.h>
+#include <qtmetamacros.h>
+
+namespace Tray {
+
+/**
+ * @class Watcher
+ * @brief org.kde.StatusNotifierWatcher, for sessions that lack one.
+ *
+ * Only exported when the well-known name is free; otherwise the Host talks to
+ * the existing watcher. Registrations disappear with their bus connection.
+ */
+class Watcher final : public QObject, protected QDBusContext {
+  Q_OBJECT
+  Q_CLASSINFO("D-Bus Interface", "org.kde.StatusNotifierWatcher")
+
+  Q_PROPERTY(QStringList RegisteredStatusNotifierItems READ registeredItems)
+  Q_PROPERTY(bool IsStatusNotifierHostRegistered READ isHostRegistered)
+  Q_PROPERTY(int ProtocolVersion READ protocolVersion)
+
+public:
+  explicit Watcher(QObject* parent = nullptr);
+  ~Watcher() override;
+
+  /// Claims the watcher name on the session bus, false if taken
+  bool registerOnBus();
+
+  [[nodiscard]] QStringList registeredItems() const { return m_items; }
+  [[nodiscard]] bool isHostRegistered() const { return !m_hosts.isEmpty(); }
+  [[nodiscard]] int protocolVersion() const { return 0; }
+
+public slots:
+  void RegisterStatusNotifierItem(const QString& serviceOrPath);
+  void RegisterStatusNotifierHost(const QString& service);
+
+signals:
+  void StatusNotifierItemRegistered(const QString& item);
+  void StatusNotifierItemUnregistered(const QString& item);
+  void StatusNotifierHostRegistered();
+  void StatusNotifierHostUnregistered();
+
+private:
+  void onServiceUnregistered(const QString& service);
+
+  QDBusServiceWatcher m_serviceWatcher;
+  QStringList m_items;
+  QStringList m_hosts;
+};
+
+} // namespace Tray
@@ -0,0 +1,119 @@
+#include "atlastexture.h"
+
+#include <qhash.h>
+#include <qmutex.h>
+#include <qvarlengtharray.h>
+#include <rhi/qrhi.h>
+
+namespace UI {
+
+namespace {
+
+using RegistryKey = std::pair<QQuickWindow*, const TextureAtlas*>;
+
+QMutex g_registryMutex;
+QHash<RegistryKey, AtlasTexture*> g_registry;
+
+} // namespace
+
+AtlasTexture* AtlasTexture::forWindow(QQuickWindow* window,
+                                      const TextureAtlas* atlas) {
+  QMutexLocker locker(&g_registryMutex);
+
+  const RegistryKey key{window, atlas};
+  if (auto* texture = g_registry.value(key)) {
+    return texture;
+  }
+
+  auto* texture = new AtlasTexture(atlas);
+  g_registry.insert(key, texture);
+
+  // Emitted on the render thread while the RHI is still alive
+  QObject::connect(
+      window, &QQuickWindow::sceneGraphInvalidated, texture,
+      [key]() {
+        QMutexLocker locker(&g_registryMutex);
+        delete g_registry.take(key);
+      },
+      Qt::DirectConnection);
+
+  return texture;
+}
+
+qint64 AtlasTexture::bytesForWindow(const QQuickWindow* window) {
+  QMutexLocker locker(&g_registryMutex);
+
+  qint64 bytes = 0;
+  for (auto it = g_registry.cbegin(); it != g_registry.cend(); ++it) {
+    if (it.key().first == window && it.value()->m_texture != nullptr) {
+      const QSize size = it.value()->m_size;
+      bytes += static_cast<qint64>(size.width()) * size.height() * 4;
+    }
+  }
+  return bytes;
+}
+
+AtlasTexture::AtlasTexture(const TextureAtlas* atlas)
+    : m_atlas{atlas}, m_size{atlas->size()} {
+  setFiltering(QSGTexture::Linear);
+  setHorizontalWrapMode(QSGTexture::ClampToEdge);
+  setVerticalWrapMode(QSGTexture::ClampToEdge);
+}
+
+AtlasTexture::~AtlasTexture() { delete m_texture; }
+
+void AtlasTexture::sync() {
+  if (!m_synced) {
+    m_pending = {{QPoint(0, 0), m_atlas->image().copy()}};
+    m_synced = true;
+  } else {
+    m_pending.append(m_atlas->changesSince(m_generation));
+  }
+
+  m_generation = m_atlas->generation();
+}
+
+QRectF AtlasTexture::normalizedRect(const QRect& rect) const {
+  return {static_cast<qreal>(rect.x()) / m_size.width(),
+          static_cast<qreal>(rect.y()) / m_size.height(),
+          static_cast<qreal>(rect.width()) / m_size.width(),
+          static_cast<qreal>(rect.height()) / m_size.height()};
+}
+
+qint64 AtlasTexture::comparisonKey() const {
+  return static_cast<qint64>(reinterpret_cast<quintptr>(this));
+}
+
+void AtlasTexture::commitTextureOperations(
+    QRhi* rhi, QRhiResourceUpdateBatch* resourceUpdates) {
+  if (m_texture == nullptr) {
+    QRhiTexture* texture = rhi->newTexture(QRhiTexture::RGBA8, m_size);
+    if (!texture->create()) {
+      delete texture;
+      return;
+    }
+
+    // bytesForWindow() reads it from the GUI thread under the same lock
+    QMutexLocker locker(&g_registryMutex);
+    m_texture = texture;
+  }
+
+  if (m_pending.isEmpty()) {
+    return;
+  }
+
+  QVarLengthArray<QRhiTextureUploadEntry, 8> entries;
+  for (const auto& upload : std::as_const(m_pending)) {
+    QRhiTextureSubresourceUploadDescription description(upload.image);
+    description.setDestinationTopLeft(upload.topLeft);
+    entries.append(QRhiTextureUploadEntry(0, 0, description));
+  }
+
+  QRhiTextureUploadDescription description;
+  description.setEntries(entries.cbegin(), entries.cend());
+  resourceUpdates->uploadTexture(m_texture, description);
+
+  m_pending.clear();
+}
+
+} // namespace UI
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <qlist.h>
+#include <qquickwindow.h>
+#include <qsgtexture.h>
+
+#include "src/ui/textureatlas.h"
+
+class QRhiTexture;
+
+namespace UI {
+
+/**
+ * @class AtlasTexture
+ * @brief GPU side of a TextureAtlas for one window.
+ *
+ * There is one AtlasTexture per (window, atlas) pair, shared by every item in
+ * that window drawing from the atlas, so their nodes batch together. sync()
+ * copies the regions written since the last sync, commitTextureOperations()
+ * uploads only those sub-rectangles.
+ *
+ * Textures are owned by the registry and destroyed when their window's scene
+ * graph is invalidated. Requires an RHI backend; with the software renderer
+ * use QQuickWindow::createTextureFromImage() on the atlas image instead.
+ */
+class AtlasTexture final : public QSGTexture {
+  Q_OBJECT
+
+public:
+  /// Render thread, during updatePaintNode()
+  static AtlasTexture* forWindow(QQuickWindow* window,
+                                 const TextureAtlas* atlas);
+
+  ~AtlasTexture() override;
+
+  /// GPU memory of every atlas texture created for @p window
+  [[nodiscard]] static qint64 bytesForWindow(const QQuickWindow* window);
+
+  /// Pulls pending changes from the atlas, call during the sync phase
+  void sync();
+
+  [[nodiscard]] QRectF normalizedRect(const QRect& rect) const;
+
+  [[nodiscard]] qint64 comparisonKey() const override;
+  [[nodiscard]] QRhiTexture* rhiTexture() const override { return m_texture; }
+  [[nodiscard]] QSize textureSize() const override { return m_size; }
+  [[nodiscard]] bool hasAlphaChannel() const override { return true; }
+  [[nodiscard]] bool hasMipmaps() const override { return false; }
+
+  void commitTextureOperations(QRhi* rhi,
+                               QRhiResourceUpdateBatch* resourceUpdates) override;
+
+private:
+  explicit AtlasTexture(const TextureAtlas* atlas);
+
+  const TextureAtlas* m_atlas;
+  QSize m_size;
+  QRhiTexture* m_texture = nullptr;
+
+  bool m_synced = false;
+  uint64_t m_generation = 0;
+  QList<TextureAtlas::Upload> m_pending;
+};
+
+} // namespace UI
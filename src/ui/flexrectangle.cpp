@@ -3,6 +3,7 @@
 #include <QSGGeometry>
 #include <QSGVertexColorMaterial>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <functional>
@@ -13,8 +14,14 @@
 #include <qsggeometry.h>
 #include <qtpreprocessorsupport.h>
 #include <qvariant.h>
+#include <qquickwindow.h>
+#include <qsgrendererinterface.h>
 #include <vector>
 
+#include "config.h"
+#include "palette.h"
+#include "palettematerial.h"
+
 namespace UI {
 
 /**
@@ -89,7 +96,16 @@ void FlexRectangle::CornerRadii::clampRadius(const float& width,
 /**
  * @brief Constructs a FlexRectangle with default properties.
  */
-FlexRectangle::FlexRectangle() { this->setFlag(ItemHasContents, true); }
+FlexRectangle::FlexRectangle() {
+  this->setFlag(ItemHasContents, true);
+
+  // Palette nodes fade in the shader, software nodes take the new color
+  connect(&Palette::instance(), &Palette::changed, this, [this]() {
+    if (m_paletteRole >= 0 && !m_nodeUsesPalette) {
+      update();
+    }
+  });
+}
 
 /**
  * @brief Sets the fill color of the rectangle.
@@ -135,6 +151,24 @@ void FlexRectangle::setSegments(uint32_t newSegments) {
   update();
 }
 
+/**
+ * @brief Sets the palette role used as fill color.
+ */
+void FlexRectangle::setPaletteRole(int role) {
+  if (role >= static_cast<int>(COLOR_ROLE_COUNT)) {
+    role = -1;
+  }
+
+  if (m_paletteRole == role) {
+    return;
+  }
+
+  m_paletteRole = qMax(-1, role);
+  m_geometryDirty = true;
+  emit paletteRoleChanged();
+  update();
+}
+
 /**
  * @brief Updates the scene graph node for rendering.
  */
@@ -147,19 +181,36 @@ QSGNode* FlexRectangle::updatePaintNode(QSGNode* oldNode,
 
   if (width <= 0 || height <= 0) {
     delete oldNode;
+    m_geometryBytes = 0;
     return nullptr;
   }
 
   auto* node = static_cast<QSGGeometryNode*>(oldNode);
 
+  // Without a window (the benchmark) there is no renderer to ask
+  const bool usePalette = m_paletteRole >= 0 && window() != nullptr &&
+                          window()->rendererInterface()->graphicsApi() !=
+                              QSGRendererInterface::Software;
+
+  // Material and vertex layout both change, start over with a new node
+  if (node != nullptr && usePalette != m_nodeUsesPalette) {
+    delete node;
+    node = nullptr;
+  }
+
   if (node == nullptr) {
     node = new QSGGeometryNode;
     node->setFlag(QSGNode::OwnsGeometry);
     node->setFlag(QSGNode::OwnsMaterial);
 
-    auto* material = new QSGFlatColorMaterial;
-    material->setColor(m_color);
-    node->setMaterial(material);
+    if (usePalette) {
+      node->setMaterial(new PaletteMaterial);
+    } else {
+      node->setMaterial(new QSGFlatColorMaterial);
+    }
+
+    m_nodeUsesPalette = usePalette;
+    m_geometryDirty = true;
   }
 
   // Check if geometry needs update (shape changed or first creation)
@@ -169,42 +220,36 @@ QSGNode* FlexRectangle::updatePaintNode(QSGNode* oldNode,
     radii.clampRadius(width, height);
 
     auto* geometry = generateGeometry(radii);
-    node->setGeometry(geometry);
+    node->setGeometry(usePalette ? toPaletteGeometry(geometry, m_paletteRole)
+                                 : geometry);
     m_geometryDirty = false;
+
+    m_geometryBytes = static_cast<qsizetype>(node->geometry()->vertexCount()) *
+                      node->geometry()->sizeOfVertex();
+  }
+
+  // The palette material reads its colors from Palette while rendering
+  if (usePalette) {
+    return node;
+  }
+
+  // The software renderer fills a palette role from the published theme,
+  // read once here instead of racing the GUI thread through Config
+  QColor color = m_color;
+  if (m_paletteRole >= 0 &&
+      static_cast<std::size_t>(m_paletteRole) < COLOR_ROLE_COUNT) {
+    if (const auto snapshot = Config::snapshot()) {
+      color = snapshot->color(static_cast<ColorRole>(m_paletteRole));
+    }
   }
 
   // Check if color changed
   auto* material = static_cast<QSGFlatColorMaterial*>(node->material());
-  if (material->color() != m_color) {
-    material->setColor(m_color);
+  if (material->color() != color) {
+    material->setColor(color);
     node->markDirty(QSGNode::DirtyMaterial);
   }
 
-  // if ((node == nullptr) || m_geometryDirty) {
-  //
-  //   CornerRadii radii;
-  //   radii.fromQVariantList(m_radius);
-  //   radii.clampRadius(width, height);
-  //
-  //   auto* geometry = generateGeometry(radii);
-  //
-  //   node->setGeometry(geometry);
-  //   node->setFlag(QSGNode::OwnsGeometry);
-  //
-  //   auto* material = new QSGFlatColorMaterial;
-  //   material->setColor(m_color);
-  //   node->setMaterial(material);
-  //   node->setFlag(QSGNode::OwnsMaterial);
-  //
-  //   m_geometryDirty = false;
-  // } else {
-  //   auto* material = static_cast<QSGFlatColorMaterial*>(node->material());
-  //   if (material->color() != m_color) {
-  //     material->setColor(m_color);
-  //     node->markDirty(QSGNode::DirtyMaterial);
-  //   }
-  // }
-
   return node;
 }
 
@@ -220,6 +265,17 @@ void FlexRectangle::geometryChange(const QRectF& newGeometry,
   QQuickItem::geometryChange(newGeometry, oldGeometry);
 }
 
+/**
+ * @brief Registers the window with the palette to animate transitions.
+ */
+void FlexRectangle::itemChange(ItemChange change,
+                               const ItemChangeData& value) {
+  if (change == ItemSceneChange && value.window != nullptr) {
+    Palette::instance().track(value.window);
+  }
+  QQuickItem::itemChange(change, value);
+}
+
 /**
  * @brief Generates the geometry for a rounded rectangle.
  *
@@ -316,6 +372,27 @@ QSGGeometry* FlexRectangle::generateGeometry(const CornerRadii& radii) const {
   return geometry;
 }
 
+/**
+ * @brief Copies a Point2D geometry into the palette vertex layout.
+ */
+QSGGeometry* FlexRectangle::toPaletteGeometry(QSGGeometry* geometry,
+                                              const int role) {
+  auto* converted = new QSGGeometry(PaletteMaterial::attributes(),
+                                    geometry->vertexCount());
+  converted->setDrawingMode(geometry->drawingMode());
+
+  const auto* source = geometry->vertexDataAsPoint2D();
+  auto* target = static_cast<PaletteMaterial::Vertex*>(converted->vertexData());
+  const auto roleValue = static_cast<float>(role);
+
+  for (int i = 0; i < geometry->vertexCount(); i++) {
+    target[i] = {.x = source[i].x, .y = source[i].y, .role = roleValue};
+  }
+
+  delete geometry;
+  return converted;
+}
+
 void FlexRectangle::generateCornerVertices(
     std::vector<QSGGeometry::Point2D>& vertices, const float& radius,
     const std::function<QSGGeometry::Point2D(float, float)>& equation) const {
@@ -2,6 +2,7 @@
 
 #include <QSGFlatColorMaterial>
 #include <QSGGeometryNode>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <qcontainerfwd.h>
@@ -30,6 +31,9 @@ namespace UI {
  * bottomLeft].
  * @property segments The number of segments used to approximate each rounded
  * corner.
+ * @property paletteRole A ColorRole to fill with instead of color, or -1.
+ * The color then comes from the GPU palette and follows theme transitions
+ * without any binding updates.
  */
 class FlexRectangle : public QQuickItem {
   Q_OBJECT
@@ -40,6 +44,8 @@ class FlexRectangle : public QQuickItem {
       QVariantList radius READ radius WRITE setRadius NOTIFY radiusChanged)
   Q_PROPERTY(
       uint32_t segments READ segments WRITE setSegments NOTIFY segmentsChanged)
+  Q_PROPERTY(int paletteRole READ paletteRole WRITE setPaletteRole NOTIFY
+                 paletteRoleChanged)
 
 public:
   /**
@@ -102,6 +108,36 @@ public:
    */
   void setSegments(uint32_t newSegments);
 
+  /**
+   * @brief Gets the palette role used as fill color.
+   * @return The ColorRole as int, or -1 if color is used.
+   */
+  [[nodiscard]] int paletteRole() const { return m_paletteRole; }
+
+  /**
+   * @brief Fills the rectangle with a palette entry instead of color.
+   *
+   * Switches to the shared palette material, which batches with every other
+   * palette-colored FlexRectangle. The software renderer instead takes the
+   * role's color from the latest Config snapshot, or color before the first
+   * one, and repaints whenever the palette changes, so no color binding is
+   * needed next to the role. Marks the geometry as dirty since the role is
+   * stored per vertex.
+   *
+   * @param role A ColorRole value, or -1 to use color.
+   */
+  void setPaletteRole(int role);
+
+  /**
+   * @brief Gets the size of the vertex data of the current geometry.
+   *
+   * Written by the render thread during sync, safe to read from any thread.
+   * Used by the memory report.
+   *
+   * @return The vertex data size in bytes, 0 if nothing is drawn.
+   */
+  [[nodiscard]] qsizetype geometryBytes() const { return m_geometryBytes; }
+
   /**
    * @brief Updates the scene graph node for rendering the rectangle.
    *
@@ -128,10 +164,16 @@ protected:
   void geometryChange(const QRectF& newGeometry,
                       const QRectF& oldGeometry) override;
 
+  /**
+   * @brief Registers the window with the palette to animate transitions.
+   */
+  void itemChange(ItemChange change, const ItemChangeData& value) override;
+
 signals:
   void colorChanged();    ///< Emitted when the color property changes.
   void radiusChanged();   ///< Emitted when the radius property changes.
   void segmentsChanged(); ///< Emitted when the segments property changes.
+  void paletteRoleChanged(); ///< Emitted when the paletteRole property changes.
 
 private:
   /**
@@ -181,14 +223,29 @@ private:
    */
   [[nodiscard]] QSGGeometry* generateGeometry(const CornerRadii& radii) const;
 
+  /**
+   * @brief Copies a Point2D geometry into the palette vertex layout.
+   *
+   * @param geometry The geometry from generateGeometry(), deleted here.
+   * @param role The palette role written to every vertex.
+   * @return A QSGGeometry with PaletteMaterial::attributes().
+   */
+  [[nodiscard]] static QSGGeometry* toPaletteGeometry(QSGGeometry* geometry,
+                                                      int role);
+
   void generateCornerVertices(
       std::vector<QSGGeometry::Point2D>& vertices, const float& radius,
       const std::function<QSGGeometry::Point2D(float, float)>& equation) const;
 
   bool m_geometryDirty = true;
+  bool m_nodeUsesPalette = false;
+  std::atomic<qsizetype> m_geometryBytes{0};
+  int m_paletteRole = -1;
   uint32_t m_segments = 8;
   QColor m_color = Qt::white;
   QVariantList m_radius = {4, 4, 4, 4};
+
+  friend class FlexRectangleBenchmark; ///< See bench/flexrectangle_bench.cpp
 };
 
 } // namespace UI
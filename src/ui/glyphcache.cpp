@@ -0,0 +1,286 @@
+#include "glyphcache.h"
+
+#include <qcoreapplication.h>
+#include <qdatastream.h>
+#include <qdebug.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qfont.h>
+#include <qfontinfo.h>
+#include <qfontmetrics.h>
+#include <qlogging.h>
+#include <qpainter.h>
+#include <qsavefile.h>
+#include <qstandardpaths.h>
+#include <qstringlist.h>
+#include <utility>
+
+namespace UI {
+
+namespace {
+
+constexpr quint32 kCacheMagic = 0x53474c59; // "SGLY"
+constexpr quint16 kCacheVersion = 1;
+
+constexpr int kAtlasSize = 512;
+
+/// Misses come in bursts when a view is loaded, save once they settle
+constexpr int kSaveDelayMs = 2000;
+
+QFont iconFont(const QString& family, const int pixelSize) {
+  QFont font(family);
+  font.setPixelSize(pixelSize);
+  return font;
+}
+
+/// Splits into code points, Nerd Font icons live outside the BMP
+QStringList codePoints(const QString& glyphs) {
+  QStringList result;
+  for (const char32_t codePoint : glyphs.toUcs4()) {
+    if (!QChar::isSpace(codePoint)) {
+      result.append(QString::fromUcs4(&codePoint, 1));
+    }
+  }
+  return result;
+}
+
+/// White premultiplied by the coverage, the atlas format
+QImage whiteMask(const QImage& alpha) {
+  QImage white(alpha.size(), QImage::Format_RGBA8888_Premultiplied);
+  white.fill(Qt::white);
+
+  QPainter painter(&white);
+  painter.setCompositionMode(QPainter::CompositionMode_DestinationIn);
+  painter.drawImage(0, 0, alpha);
+  painter.end();
+
+  return white;
+}
+
+} // namespace
+
+GlyphCache& GlyphCache::instance() {
+  static GlyphCache cache;
+  return cache;
+}
+
+GlyphCache::GlyphCache() : m_atlas{QSize(kAtlasSize, kAtlasSize)} {
+  m_saveTimer.setSingleShot(true);
+  m_saveTimer.setInterval(kSaveDelayMs);
+  connect(&m_saveTimer, &QTimer::timeout, this, &GlyphCache::saveDirty);
+
+  // Whatever is still pending when the bar quits
+  if (auto* app = QCoreApplication::instance()) {
+    connect(app, &QCoreApplication::aboutToQuit, this, &GlyphCache::saveDirty);
+  }
+}
+
+void GlyphCache::prebake(const QString& family, const int pixelSize,
+                         const QString& glyphs) {
+  loadFromDisk(family, pixelSize);
+
+  bool added = false;
+  for (const auto& glyph : codePoints(glyphs)) {
+    const QString key = maskKey(family, pixelSize, glyph);
+    if (!m_masks.contains(key)) {
+      m_masks.insert(key, rasterize(family, pixelSize, glyph));
+      added = true;
+    }
+  }
+
+  if (added) {
+    m_dirty.remove({family, pixelSize});
+    saveToDisk(family, pixelSize);
+  }
+}
+
+uint64_t GlyphCache::acquire(const QString& family, const int pixelSize,
+                             const QString& glyph) {
+  const uint64_t key = atlasKey(family, pixelSize, glyph);
+
+  // Every further item showing the glyph is only another reference
+  if (m_atlas.contains(key)) {
+    m_atlas.acquire(key, {});
+    return key;
+  }
+
+  const QImage& alpha = mask(family, pixelSize, glyph);
+  if (alpha.isNull()) {
+    return 0;
+  }
+
+  const uint64_t layout = m_atlas.layoutGeneration();
+
+  if (m_atlas.acquire(key, whiteMask(alpha)).isNull()) {
+    qWarning() << "GlyphCache: atlas is full, cannot place" << glyph;
+    return 0;
+  }
+
+  if (m_atlas.layoutGeneration() != layout) {
+    emit atlasRepacked();
+  }
+
+  return key;
+}
+
+void GlyphCache::release(const uint64_t key) { m_atlas.release(key); }
+
+const QImage& GlyphCache::mask(const QString& family, const int pixelSize,
+                               const QString& glyph) {
+  const QString key = maskKey(family, pixelSize, glyph);
+
+  auto it = m_masks.find(key);
+  if (it == m_masks.end()) {
+    // Not prebaked, costs one rasterization and is cached from now on
+    it = m_masks.insert(key, rasterize(family, pixelSize, glyph));
+    m_dirty.insert({family, pixelSize});
+    m_saveTimer.start();
+  }
+
+  return *it;
+}
+
+QString GlyphCache::maskKey(const QString& family, const int pixelSize,
+                            const QString& glyph) {
+  return QString("%1/%2/%3").arg(family).arg(pixelSize).arg(glyph);
+}
+
+uint64_t GlyphCache::atlasKey(const QString& family, const int pixelSize,
+                              const QString& glyph) {
+  const uint64_t key = qHashMulti(0, family, pixelSize, glyph);
+  // 0 is what acquire() returns for no glyph
+  return key != 0 ? key : 1;
+}
+
+QString GlyphCache::cacheFilePath(const QString& family, const int pixelSize) {
+  const QString name =
+      QString("glyphs-%1-%2.bin")
+          .arg(qHash(family), 16, 16, QChar('0'))
+          .arg(pixelSize);
+
+  return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+      .filePath(name);
+}
+
+QImage GlyphCache::rasterize(const QString& family, const int pixelSize,
+                             const QString& glyph) {
+  const QFont font = iconFont(family, pixelSize);
+  const QFontMetrics metrics(font);
+
+  // Same box a Text item would get, so the icon centers the same way
+  const QSize size(qMax(metrics.horizontalAdvance(glyph), 1),
+                   qMax(metrics.height(), 1));
+
+  QImage image(size, QImage::Format_Alpha8);
+  image.fill(Qt::transparent);
+
+  QPainter painter(&image);
+  painter.setFont(font);
+  painter.setPen(Qt::white);
+  painter.drawText(QPoint(0, metrics.ascent()), glyph);
+  painter.end();
+
+  return image;
+}
+
+bool GlyphCache::loadFromDisk(const QString& family, const int pixelSize) {
+  QFile file(cacheFilePath(family, pixelSize));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QDataStream stream(&file);
+
+  quint32 magic = 0;
+  quint16 version = 0;
+  QString resolvedFamily;
+  qint32 size = 0;
+  quint32 count = 0;
+  stream >> magic >> version >> resolvedFamily >> size >> count;
+
+  // A font update or fallback to another family invalidates the cache
+  if (magic != kCacheMagic || version != kCacheVersion || size != pixelSize ||
+      resolvedFamily != QFontInfo(iconFont(family, pixelSize)).family()) {
+    return false;
+  }
+
+  // Only a file read to the end is used, a truncated one adds nothing
+  QHash<QString, QImage> masks;
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+    QString glyph;
+    qint32 width = 0;
+    qint32 height = 0;
+    stream >> glyph >> width >> height;
+
+    if (width <= 0 || height <= 0 || width > kAtlasSize ||
+        height > kAtlasSize) {
+      return false;
+    }
+
+    QImage image(width, height, QImage::Format_Alpha8);
+    for (int y = 0; y < height; y++) {
+      if (stream.readRawData(reinterpret_cast<char*>(image.scanLine(y)),
+                             width) != width) {
+        return false;
+      }
+    }
+
+    masks.insert(maskKey(family, pixelSize, glyph), image);
+  }
+
+  if (stream.status() != QDataStream::Ok) {
+    return false;
+  }
+
+  m_masks.insert(masks);
+  return true;
+}
+
+void GlyphCache::saveDirty() {
+  m_saveTimer.stop();
+
+  const auto dirty = std::exchange(m_dirty, {});
+  for (const auto& [family, pixelSize] : dirty) {
+    saveToDisk(family, pixelSize);
+  }
+}
+
+void GlyphCache::saveToDisk(const QString& family, const int pixelSize) const {
+  const QString path = cacheFilePath(family, pixelSize);
+  QDir().mkpath(QFileInfo(path).absolutePath());
+
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << "GlyphCache: cannot write" << path;
+    return;
+  }
+
+  const QString prefix = maskKey(family, pixelSize, QString());
+
+  QList<QPair<QString, QImage>> masks;
+  for (auto it = m_masks.cbegin(); it != m_masks.cend(); ++it) {
+    if (it.key().startsWith(prefix) && !it.value().isNull()) {
+      masks.append({it.key().mid(prefix.size()), it.value()});
+    }
+  }
+
+  QDataStream stream(&file);
+  stream << kCacheMagic << kCacheVersion
+         << QFontInfo(iconFont(family, pixelSize)).family()
+         << static_cast<qint32>(pixelSize)
+         << static_cast<quint32>(masks.size());
+
+  for (const auto& [glyph, image] : std::as_const(masks)) {
+    stream << glyph << static_cast<qint32>(image.width())
+           << static_cast<qint32>(image.height());
+    for (int y = 0; y < image.height(); y++) {
+      stream.writeRawData(reinterpret_cast<const char*>(image.constScanLine(y)),
+                          image.width());
+    }
+  }
+
+  file.commit();
+}
+
+} // namespace UI
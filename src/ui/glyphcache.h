@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <qhash.h>
+#include <qimage.h>
+#include <qobject.h>
+#include <qset.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+#include "src/ui/textureatlas.h"
+
+namespace UI {
+
+/**
+ * @class GlyphCache
+ * @brief Process-wide cache of rasterized icon glyphs in one TextureAtlas.
+ *
+ * Glyphs are rasterized once per (family, pixel size) into alpha masks, which
+ * prebake() loads from or writes to a file in the cache directory. A warm
+ * start only resolves the family, to notice a font update or fallback, and
+ * does no shaping or rasterization at all. The atlas holds the untinted
+ * masks keyed by family, size and glyph, so an icon is stored once for every
+ * IconGlyph in every view whatever color it is drawn in; the tint is applied
+ * when drawing. Only the first acquire() of a glyph converts its mask, every
+ * later one is a hash lookup.
+ *
+ * GUI thread only, like TextureAtlas.
+ */
+class GlyphCache final : public QObject {
+  Q_OBJECT
+
+public:
+  static GlyphCache& instance();
+
+  /**
+   * @brief Makes sure every glyph in @p glyphs has a mask at @p pixelSize.
+   *
+   * Reads the disk cache for this font and size, rasterizes whatever is still
+   * missing and writes the cache back if anything was added.
+   */
+  void prebake(const QString& family, int pixelSize, const QString& glyphs);
+
+  /**
+   * @brief Adds a reference to the mask of @p glyph.
+   *
+   * The mask is white with the glyph's coverage as alpha, tint it by
+   * multiplying with the color to draw in.
+   *
+   * @return Its key in atlas(), 0 if it could not be rasterized or placed.
+   */
+  uint64_t acquire(const QString& family, int pixelSize, const QString& glyph);
+  void release(uint64_t key);
+
+  [[nodiscard]] const TextureAtlas& atlas() const { return m_atlas; }
+
+signals:
+  /// Existing glyphs moved inside the atlas, quads have to be rebuilt
+  void atlasRepacked();
+
+private:
+  GlyphCache();
+
+  [[nodiscard]] static QString maskKey(const QString& family, int pixelSize,
+                                       const QString& glyph);
+  [[nodiscard]] static uint64_t atlasKey(const QString& family, int pixelSize,
+                                         const QString& glyph);
+  [[nodiscard]] static QString cacheFilePath(const QString& family,
+                                             int pixelSize);
+  [[nodiscard]] static QImage rasterize(const QString& family, int pixelSize,
+                                        const QString& glyph);
+
+  const QImage& mask(const QString& family, int pixelSize,
+                     const QString& glyph);
+  bool loadFromDisk(const QString& family, int pixelSize);
+  void saveToDisk(const QString& family, int pixelSize) const;
+  /// Writes every cache file that gained masks since the last save
+  void saveDirty();
+
+  TextureAtlas m_atlas;
+  QHash<QString, QImage> m_masks;
+
+  /// Masks rasterized on a miss are saved together, a while after the last
+  QSet<QPair<QString, int>> m_dirty;
+  QTimer m_saveTimer;
+};
+
+} // namespace UI
@@ -0,0 +1,250 @@
+#include "iconglyph.h"
+
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <qpainter.h>
+#include <qquickwindow.h>
+#include <qsgrendererinterface.h>
+
+#include "atlastexture.h"
+#include "config.h"
+#include "glyphcache.h"
+#include "palette.h"
+#include "palettematerial.h"
+
+namespace UI {
+
+IconGlyph::IconGlyph(QQuickItem* parent) : QQuickItem{parent} {
+  setFlag(ItemHasContents, true);
+
+  connect(&GlyphCache::instance(), &GlyphCache::atlasRepacked, this,
+          &IconGlyph::markDirty);
+
+  // The GPU palette fades on its own, the software renderer re-tints
+  connect(&Palette::instance(), &Palette::changed, this, [this]() {
+    if (m_paletteRole >= 0 && window() != nullptr &&
+        window()->rendererInterface()->graphicsApi() ==
+            QSGRendererInterface::Software) {
+      markDirty();
+    }
+  });
+}
+
+IconGlyph::~IconGlyph() { GlyphCache::instance().release(m_key); }
+
+void IconGlyph::setText(const QString& text) {
+  if (m_text == text) {
+    return;
+  }
+
+  m_text = text;
+  reacquire();
+  emit textChanged();
+}
+
+void IconGlyph::setColor(const QColor& color) {
+  if (m_color == color) {
+    return;
+  }
+
+  m_color = color;
+  markDirty();
+  emit colorChanged();
+}
+
+void IconGlyph::setPaletteRole(int role) {
+  if (role >= static_cast<int>(COLOR_ROLE_COUNT)) {
+    role = -1;
+  }
+  role = qMax(-1, role);
+
+  if (m_paletteRole == role) {
+    return;
+  }
+
+  m_paletteRole = role;
+  markDirty();
+  emit paletteRoleChanged();
+}
+
+void IconGlyph::setPixelSize(const int pixelSize) {
+  if (m_pixelSize == pixelSize) {
+    return;
+  }
+
+  m_pixelSize = pixelSize;
+  reacquire();
+  emit pixelSizeChanged();
+}
+
+void IconGlyph::setFamily(const QString& family) {
+  if (m_family == family) {
+    return;
+  }
+
+  m_family = family;
+  reacquire();
+  emit familyChanged();
+}
+
+void IconGlyph::componentComplete() {
+  QQuickItem::componentComplete();
+  reacquire();
+}
+
+void IconGlyph::itemChange(const ItemChange change,
+                           const ItemChangeData& value) {
+  if (change == ItemDevicePixelRatioHasChanged ||
+      (change == ItemSceneChange && value.window != nullptr)) {
+    reacquire();
+  }
+
+  if (change == ItemSceneChange && value.window != nullptr) {
+    Palette::instance().track(value.window);
+  }
+
+  QQuickItem::itemChange(change, value);
+}
+
+void IconGlyph::geometryChange(const QRectF& newGeometry,
+                               const QRectF& oldGeometry) {
+  if (newGeometry.size() != oldGeometry.size()) {
+    markDirty();
+  }
+
+  QQuickItem::geometryChange(newGeometry, oldGeometry);
+}
+
+qreal IconGlyph::devicePixelRatio() const {
+  return window() != nullptr ? window()->effectiveDevicePixelRatio() : 1.0;
+}
+
+void IconGlyph::reacquire() {
+  if (!isComponentComplete()) {
+    return;
+  }
+
+  GlyphCache& cache = GlyphCache::instance();
+  const qreal ratio = devicePixelRatio();
+
+  // Acquire first, an unchanged glyph keeps its slot
+  const uint64_t key =
+      m_text.isEmpty() || m_pixelSize <= 0
+          ? 0
+          : cache.acquire(m_family, qRound(m_pixelSize * ratio), m_text);
+  cache.release(m_key);
+  m_key = key;
+
+  const QSizeF size = QSizeF(cache.atlas().find(m_key).size()) / ratio;
+  setImplicitSize(size.width(), size.height());
+
+  markDirty();
+}
+
+QColor IconGlyph::resolvedColor() const {
+  if (m_paletteRole >= 0) {
+    if (const auto snapshot = Config::snapshot()) {
+      return snapshot->color(static_cast<ColorRole>(m_paletteRole));
+    }
+  }
+  return m_color;
+}
+
+void IconGlyph::markDirty() {
+  m_geometryDirty = true;
+  update();
+}
+
+QSGNode* IconGlyph::updatePaintNode(QSGNode* oldNode,
+                                    UpdatePaintNodeData* data) {
+  Q_UNUSED(data)
+
+  if (!GlyphCache::instance().atlas().contains(m_key) || width() <= 0 ||
+      height() <= 0) {
+    delete oldNode;
+    return nullptr;
+  }
+
+  if (window()->rendererInterface()->graphicsApi() ==
+      QSGRendererInterface::Software) {
+    return updateSoftwareNode(oldNode);
+  }
+
+  return updateBatchedNode(oldNode);
+}
+
+QSGNode* IconGlyph::updateBatchedNode(QSGNode* oldNode) {
+  const TextureAtlas& atlas = GlyphCache::instance().atlas();
+
+  auto* node = static_cast<QSGGeometryNode*>(oldNode);
+  auto* texture = AtlasTexture::forWindow(window(), &atlas);
+  texture->sync();
+
+  if (node == nullptr) {
+    node = new QSGGeometryNode;
+
+    auto* geometry = new QSGGeometry(PaletteTextureMaterial::attributes(), 4);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+
+    auto* material = new PaletteTextureMaterial;
+    material->setTexture(texture);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+
+    m_geometryDirty = true;
+  }
+
+  if (!m_geometryDirty) {
+    return node;
+  }
+  m_geometryDirty = false;
+
+  // Centered at its natural size, like a Text item with no wrapping
+  const QSizeF size = implicitSize();
+  const QRectF target(QPointF((width() - size.width()) / 2.0,
+                              (height() - size.height()) / 2.0),
+                      size);
+  const QRectF uv = texture->normalizedRect(atlas.find(m_key));
+
+  // Role and color are per vertex, a recolor keeps the node in its batch
+  PaletteTextureMaterial::updateRectGeometry(node->geometry(), target, uv,
+                                             m_paletteRole, m_color);
+  node->markDirty(QSGNode::DirtyGeometry);
+
+  return node;
+}
+
+QSGNode* IconGlyph::updateSoftwareNode(QSGNode* oldNode) {
+  if (oldNode != nullptr && !m_geometryDirty) {
+    return oldNode;
+  }
+  m_geometryDirty = false;
+
+  const TextureAtlas& atlas = GlyphCache::instance().atlas();
+
+  auto* node = static_cast<QSGImageNode*>(oldNode);
+  if (node == nullptr) {
+    node = window()->createImageNode();
+    node->setOwnsTexture(true);
+    node->setFiltering(QSGTexture::Linear);
+  }
+
+  // Tinted here, per node, the atlas only has the white masks
+  QImage image = atlas.image().copy(atlas.find(m_key));
+  QPainter painter(&image);
+  painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+  painter.fillRect(image.rect(), resolvedColor());
+  painter.end();
+
+  const QSizeF size = implicitSize();
+  node->setTexture(window()->createTextureFromImage(image));
+  node->setRect(QRectF(QPointF((width() - size.width()) / 2.0,
+                               (height() - size.height()) / 2.0),
+                       size));
+
+  return node;
+}
+
+} // namespace UI
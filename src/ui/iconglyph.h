@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <qcolor.h>
+#include <qqmlintegration.h>
+#include <qquickitem.h>
+#include <qtmetamacros.h>
+
+namespace UI {
+
+/**
+ * @class IconGlyph
+ * @brief Draws one icon glyph from the shared GlyphCache as a textured quad.
+ *
+ * A drop-in for a Text item that only ever shows a single icon. The glyph is
+ * taken from the process-wide atlas instead of being shaped and rasterized
+ * per item, and every IconGlyph in a window samples the same texture, so
+ * they batch into one draw call. The atlas holds untinted masks and the color
+ * is applied by the material, so recoloring an icon touches neither the atlas
+ * nor the batch.
+ *
+ * @property text The glyph to draw, one code point.
+ * @property color The fill color of the glyph, if paletteRole is -1.
+ * @property paletteRole A ColorRole to fill with instead of color, or -1.
+ * The color then comes from the GPU palette and follows theme transitions.
+ * @property pixelSize The font pixel size the glyph is rasterized at.
+ * @property family The font family the glyph is taken from.
+ */
+class IconGlyph : public QQuickItem {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QString text READ text WRITE setText NOTIFY textChanged)
+  Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+  Q_PROPERTY(int paletteRole READ paletteRole WRITE setPaletteRole NOTIFY
+                 paletteRoleChanged)
+  Q_PROPERTY(
+      int pixelSize READ pixelSize WRITE setPixelSize NOTIFY pixelSizeChanged)
+  Q_PROPERTY(QString family READ family WRITE setFamily NOTIFY familyChanged)
+
+public:
+  explicit IconGlyph(QQuickItem* parent = nullptr);
+  ~IconGlyph() override;
+
+  [[nodiscard]] QString text() const { return m_text; }
+  void setText(const QString& text);
+
+  [[nodiscard]] QColor color() const { return m_color; }
+  void setColor(const QColor& color);
+
+  [[nodiscard]] int paletteRole() const { return m_paletteRole; }
+  void setPaletteRole(int role);
+
+  [[nodiscard]] int pixelSize() const { return m_pixelSize; }
+  void setPixelSize(int pixelSize);
+
+  [[nodiscard]] QString family() const { return m_family; }
+  void setFamily(const QString& family);
+
+  QSGNode* updatePaintNode(QSGNode* oldNode,
+                           UpdatePaintNodeData* data) override;
+
+signals:
+  void textChanged();
+  void colorChanged();
+  void paletteRoleChanged();
+  void pixelSizeChanged();
+  void familyChanged();
+
+protected:
+  void componentComplete() override;
+  void itemChange(ItemChange change, const ItemChangeData& value) override;
+  void geometryChange(const QRectF& newGeometry,
+                      const QRectF& oldGeometry) override;
+
+private:
+  /// Swaps the atlas reference for the current properties
+  void reacquire();
+  void markDirty();
+
+  [[nodiscard]] qreal devicePixelRatio() const;
+  /// The color drawn in by the software renderer
+  [[nodiscard]] QColor resolvedColor() const;
+
+  QSGNode* updateBatchedNode(QSGNode* oldNode);
+  QSGNode* updateSoftwareNode(QSGNode* oldNode);
+
+  QString m_text;
+  QColor m_color = Qt::white;
+  int m_paletteRole = -1;
+  int m_pixelSize = 16;
+  QString m_family;
+
+  uint64_t m_key = 0;
+  bool m_geometryDirty = true;
+};
+
+} // namespace UI
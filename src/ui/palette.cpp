@@ -0,0 +1,151 @@
+#include "palette.h"
+
+#include <chrono>
+#include <qcolor.h>
+#include <utility>
+
+namespace UI {
+
+namespace {
+
+// Keep rendering a little past the end, so a frame with the final colors is
+// drawn even if the last one inside the transition was slightly early
+constexpr int64_t kSettleNs = 50000000;
+constexpr int kSettleMs = static_cast<int>(kSettleNs / 1000000);
+
+} // namespace
+
+Palette& Palette::instance() {
+  static Palette palette;
+  return palette;
+}
+
+Palette* Palette::create(QQmlEngine* /*unused*/, QJSEngine* /*unused*/) {
+  return &instance();
+}
+
+Palette::Palette() {
+  m_fadeTimer.setSingleShot(true);
+  connect(&m_fadeTimer, &QTimer::timeout, this,
+          [this]() { setFading(false); });
+}
+
+void Palette::reset(const Theme& theme) {
+  {
+    QMutexLocker locker(&m_mutex);
+    m_from = premultiplied(theme);
+    m_to = m_from;
+    m_durationNs = 0;
+  }
+
+  m_fadeTimer.stop();
+  setFading(false);
+
+  scheduleFrames();
+  emit changed();
+}
+
+void Palette::transitionTo(const Theme& theme, const int durationMs) {
+  if (durationMs <= 0) {
+    reset(theme);
+    return;
+  }
+
+  {
+    QMutexLocker locker(&m_mutex);
+    const int64_t time = now();
+    const State current = stateAt(time);
+
+    // Interrupting a running fade starts the new one from what is on screen
+    for (std::size_t i = 0; i < COLOR_ROLE_COUNT; i++) {
+      m_from.at(i) = current.from.at(i) +
+                     ((current.to.at(i) - current.from.at(i)) *
+                      current.progress);
+    }
+    m_to = premultiplied(theme);
+    m_startNs = time;
+    m_durationNs = static_cast<int64_t>(durationMs) * 1000000;
+  }
+
+  // Ends with the settle time, after the last frame of the fade was drawn
+  m_fadeTimer.start(durationMs + kSettleMs);
+  setFading(true);
+
+  scheduleFrames();
+  emit changed();
+}
+
+Palette::State Palette::state() const {
+  QMutexLocker locker(&m_mutex);
+  return stateAt(now());
+}
+
+Palette::State Palette::stateAt(const int64_t time) const {
+  float progress = 1.0F;
+  if (m_durationNs > 0) {
+    const float linear = qBound(
+        0.0F,
+        static_cast<float>(time - m_startNs) / static_cast<float>(m_durationNs),
+        1.0F);
+    progress = linear * linear * (3.0F - (2.0F * linear));
+  }
+
+  return {m_from, m_to, progress};
+}
+
+bool Palette::transitioning() const {
+  QMutexLocker locker(&m_mutex);
+  return m_durationNs > 0 && now() - m_startNs < m_durationNs + kSettleNs;
+}
+
+void Palette::track(QQuickWindow* window) {
+  if (window == nullptr || m_windows.contains(window)) {
+    return;
+  }
+
+  m_windows.append(window);
+
+  // Emitted on the render thread, the update is requested on the GUI thread
+  connect(window, &QQuickWindow::frameSwapped, window, [this, window]() {
+    if (transitioning()) {
+      window->update();
+    }
+  });
+}
+
+void Palette::scheduleFrames() {
+  m_windows.removeAll(nullptr);
+  for (const auto& window : std::as_const(m_windows)) {
+    window->update();
+  }
+}
+
+void Palette::setFading(const bool fading) {
+  if (m_fading == fading) {
+    return;
+  }
+
+  m_fading = fading;
+  emit fadingChanged();
+}
+
+Palette::Colors Palette::premultiplied(const Theme& theme) {
+  Colors colors{};
+  for (std::size_t i = 0; i < COLOR_ROLE_COUNT; i++) {
+    const QColor color =
+        QColor::fromRgba(theme.color(static_cast<ColorRole>(i)));
+    const auto alpha = static_cast<float>(color.alphaF());
+    colors.at(i) = QVector4D(static_cast<float>(color.redF()) * alpha,
+                             static_cast<float>(color.greenF()) * alpha,
+                             static_cast<float>(color.blueF()) * alpha, alpha);
+  }
+  return colors;
+}
+
+int64_t Palette::now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace UI
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <qlist.h>
+#include <qmutex.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qqmlengine.h>
+#include <qqmlintegration.h>
+#include <qquickwindow.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qvectornd.h>
+
+#include "theme.h"
+
+namespace UI {
+
+/**
+ * @class Palette
+ * @brief Theme colors as seen by the GPU materials, with timed transitions.
+ *
+ * Holds the theme being faded from, the theme being faded to and when the
+ * fade started. Materials read it during rendering and interpolate there, so a
+ * transition costs one uniform block per batch and frame instead of 26 color
+ * properties re-evaluating their bindings on the GUI thread.
+ *
+ * Written on the GUI thread, read from render threads. QML sees it as the
+ * ThemePalette singleton, whose fading tells items that can only follow the
+ * palette through a layer (text) when they need one.
+ */
+class Palette final : public QObject {
+  Q_OBJECT
+  QML_NAMED_ELEMENT(ThemePalette)
+  QML_SINGLETON
+
+  /// A transition is running, set on the GUI thread for its whole duration
+  Q_PROPERTY(bool fading READ fading NOTIFY fadingChanged)
+
+public:
+  using Colors = std::array<QVector4D, COLOR_ROLE_COUNT>;
+
+  struct State {
+    Colors from;
+    Colors to;
+    float progress; ///< Eased, 0 shows from, 1 shows to
+  };
+
+  static Palette& instance();
+  static Palette* create(QQmlEngine* /*unused*/, QJSEngine* /*unused*/);
+
+  /// Jumps to @p theme without a transition
+  void reset(const Theme& theme);
+  /// Fades from whatever is on screen right now to @p theme
+  void transitionTo(const Theme& theme, int durationMs);
+
+  /// The palette at this moment, any thread
+  [[nodiscard]] State state() const;
+
+  /// Keeps @p window rendering while a transition runs
+  void track(QQuickWindow* window);
+
+  [[nodiscard]] bool fading() const { return m_fading; }
+
+signals:
+  void changed();
+  void fadingChanged();
+
+private:
+  Palette();
+
+  [[nodiscard]] static Colors premultiplied(const Theme& theme);
+  [[nodiscard]] static int64_t now();
+  [[nodiscard]] State stateAt(int64_t time) const;
+  [[nodiscard]] bool transitioning() const;
+
+  void scheduleFrames();
+  void setFading(bool fading);
+
+  mutable QMutex m_mutex;
+  Colors m_from{};
+  Colors m_to{};
+  int64_t m_startNs = 0;
+  int64_t m_durationNs = 0;
+
+  QList<QPointer<QQuickWindow>> m_windows;
+
+  bool m_fading = false;
+  QTimer m_fadeTimer;
+};
+
+} // namespace UI
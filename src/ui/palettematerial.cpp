@@ -0,0 +1,202 @@
+#include "palettematerial.h"
+
+#include <cstring>
+#include <qmatrix4x4.h>
+
+#include "palette.h"
+
+namespace UI {
+
+namespace {
+
+// std140 layout of the uniform block in shaders/palette.vert
+constexpr int kMatrixOffset = 0;
+constexpr int kOpacityOffset = 64;
+constexpr int kProgressOffset = 68;
+constexpr int kFromOffset = 80;
+constexpr int kToOffset =
+    kFromOffset + static_cast<int>(COLOR_ROLE_COUNT * sizeof(QVector4D));
+constexpr int kBlockSize =
+    kToOffset + static_cast<int>(COLOR_ROLE_COUNT * sizeof(QVector4D));
+
+/// The same block is shared by both shaders, see palettetexture.vert
+bool writeUniforms(QSGMaterialShader::RenderState& state) {
+  QByteArray* buffer = state.uniformData();
+  Q_ASSERT(buffer->size() >= kBlockSize);
+  char* data = buffer->data();
+
+  if (state.isMatrixDirty()) {
+    const QMatrix4x4 matrix = state.combinedMatrix();
+    memcpy(data + kMatrixOffset, matrix.constData(), 64);
+  }
+
+  if (state.isOpacityDirty()) {
+    const float opacity = state.opacity();
+    memcpy(data + kOpacityOffset, &opacity, sizeof(float));
+  }
+
+  // Every batch has its own buffer, so the palette is written for each one
+  const Palette::State palette = Palette::instance().state();
+  memcpy(data + kProgressOffset, &palette.progress, sizeof(float));
+  memcpy(data + kFromOffset, palette.from.data(),
+         COLOR_ROLE_COUNT * sizeof(QVector4D));
+  memcpy(data + kToOffset, palette.to.data(),
+         COLOR_ROLE_COUNT * sizeof(QVector4D));
+
+  return true;
+}
+
+} // namespace
+
+PaletteMaterial::PaletteMaterial() {
+  // Themes may have translucent colors, and they change at runtime
+  setFlag(Blending);
+}
+
+QSGMaterialType* PaletteMaterial::type() const {
+  static QSGMaterialType type;
+  return &type;
+}
+
+QSGMaterialShader* PaletteMaterial::createShader(
+    QSGRendererInterface::RenderMode /*unused*/) const {
+  return new PaletteShader;
+}
+
+int PaletteMaterial::compare(const QSGMaterial* /*unused*/) const {
+  return 0;
+}
+
+const QSGGeometry::AttributeSet& PaletteMaterial::attributes() {
+  static const QSGGeometry::Attribute data[] = {
+      QSGGeometry::Attribute::createWithAttributeType(
+          0, 2, QSGGeometry::FloatType, QSGGeometry::PositionAttribute),
+      QSGGeometry::Attribute::createWithAttributeType(
+          1, 1, QSGGeometry::FloatType, QSGGeometry::UnknownAttribute),
+  };
+  static const QSGGeometry::AttributeSet set = {2, sizeof(Vertex), data};
+  return set;
+}
+
+// ###################################################################################
+
+PaletteShader::PaletteShader() {
+  setShaderFileName(VertexStage, ":/simbar/shaders/palette.vert.qsb");
+  setShaderFileName(FragmentStage, ":/simbar/shaders/palette.frag.qsb");
+}
+
+bool PaletteShader::updateUniformData(RenderState& state,
+                                      QSGMaterial* /*newMaterial*/,
+                                      QSGMaterial* /*oldMaterial*/) {
+  return writeUniforms(state);
+}
+
+// ###################################################################################
+
+PaletteTextureMaterial::PaletteTextureMaterial() { setFlag(Blending); }
+
+QSGMaterialType* PaletteTextureMaterial::type() const {
+  static QSGMaterialType type;
+  return &type;
+}
+
+QSGMaterialShader* PaletteTextureMaterial::createShader(
+    QSGRendererInterface::RenderMode /*unused*/) const {
+  return new PaletteTextureShader;
+}
+
+int PaletteTextureMaterial::compare(const QSGMaterial* other) const {
+  const auto* material = static_cast<const PaletteTextureMaterial*>(other);
+  const qint64 key = m_texture != nullptr ? m_texture->comparisonKey() : 0;
+  const qint64 otherKey =
+      material->m_texture != nullptr ? material->m_texture->comparisonKey() : 0;
+  return key < otherKey ? -1 : (key > otherKey ? 1 : 0);
+}
+
+const QSGGeometry::AttributeSet& PaletteTextureMaterial::attributes() {
+  static const QSGGeometry::Attribute data[] = {
+      QSGGeometry::Attribute::createWithAttributeType(
+          0, 2, QSGGeometry::FloatType, QSGGeometry::PositionAttribute),
+      QSGGeometry::Attribute::createWithAttributeType(
+          1, 2, QSGGeometry::FloatType, QSGGeometry::TexCoordAttribute),
+      QSGGeometry::Attribute::createWithAttributeType(
+          2, 1, QSGGeometry::FloatType, QSGGeometry::UnknownAttribute),
+      QSGGeometry::Attribute::createWithAttributeType(
+          3, 4, QSGGeometry::UnsignedByteType, QSGGeometry::ColorAttribute),
+  };
+  static const QSGGeometry::AttributeSet set = {4, sizeof(Vertex), data};
+  return set;
+}
+
+void PaletteTextureMaterial::updateRectGeometry(QSGGeometry* geometry,
+                                                const QRectF& rect,
+                                                const QRectF& sourceRect,
+                                                const int role,
+                                                const QColor& color) {
+  Q_ASSERT(geometry->vertexCount() == 4);
+
+  const QColor premultiplied = QColor::fromRgba(qPremultiply(color.rgba()));
+  const auto r = static_cast<uint8_t>(premultiplied.red());
+  const auto g = static_cast<uint8_t>(premultiplied.green());
+  const auto b = static_cast<uint8_t>(premultiplied.blue());
+  const auto a = static_cast<uint8_t>(premultiplied.alpha());
+  const auto roleValue = static_cast<float>(role);
+
+  auto vertex = [&](const qreal x, const qreal y, const qreal tx,
+                    const qreal ty) -> Vertex {
+    return {.x = static_cast<float>(x),
+            .y = static_cast<float>(y),
+            .tx = static_cast<float>(tx),
+            .ty = static_cast<float>(ty),
+            .role = roleValue,
+            .r = r,
+            .g = g,
+            .b = b,
+            .a = a};
+  };
+
+  auto* vertices = static_cast<Vertex*>(geometry->vertexData());
+  vertices[0] = vertex(rect.left(), rect.top(), sourceRect.left(),
+                       sourceRect.top());
+  vertices[1] = vertex(rect.left(), rect.bottom(), sourceRect.left(),
+                       sourceRect.bottom());
+  vertices[2] = vertex(rect.right(), rect.top(), sourceRect.right(),
+                       sourceRect.top());
+  vertices[3] = vertex(rect.right(), rect.bottom(), sourceRect.right(),
+                       sourceRect.bottom());
+}
+
+// ###################################################################################
+
+PaletteTextureShader::PaletteTextureShader() {
+  setShaderFileName(VertexStage, ":/simbar/shaders/palettetexture.vert.qsb");
+  setShaderFileName(FragmentStage, ":/simbar/shaders/palettetexture.frag.qsb");
+}
+
+bool PaletteTextureShader::updateUniformData(RenderState& state,
+                                             QSGMaterial* /*newMaterial*/,
+                                             QSGMaterial* /*oldMaterial*/) {
+  return writeUniforms(state);
+}
+
+void PaletteTextureShader::updateSampledImage(RenderState& state,
+                                              const int binding,
+                                              QSGTexture** texture,
+                                              QSGMaterial* newMaterial,
+                                              QSGMaterial* /*oldMaterial*/) {
+  if (binding != 1) {
+    return;
+  }
+
+  QSGTexture* sampled =
+      static_cast<PaletteTextureMaterial*>(newMaterial)->texture();
+  if (sampled == nullptr) {
+    return;
+  }
+
+  sampled->setFiltering(QSGTexture::Linear);
+  sampled->commitTextureOperations(state.rhi(), state.resourceUpdateBatch());
+  *texture = sampled;
+}
+
+} // namespace UI
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <cstdint>
+#include <qcolor.h>
+#include <qrect.h>
+#include <qsggeometry.h>
+#include <qsgtexture.h>
+
+namespace UI {
+
+/**
+ * @class PaletteMaterial
+ * @brief Fills geometry with a theme color picked by a per-vertex role.
+ *
+ * The role is a vertex attribute rather than a material property, so every
+ * node using this material compares equal and batches together regardless of
+ * color. The colors come from Palette and are interpolated in the vertex
+ * shader, which is what makes theme transitions free of QML bindings.
+ */
+class PaletteMaterial final : public QSGMaterial {
+public:
+  PaletteMaterial();
+
+  [[nodiscard]] QSGMaterialType* type() const override;
+  [[nodiscard]] QSGMaterialShader* createShader(
+      QSGRendererInterface::RenderMode renderMode) const override;
+  [[nodiscard]] int compare(const QSGMaterial* other) const override;
+
+  /// Position (x, y) and palette role (as float) per vertex
+  [[nodiscard]] static const QSGGeometry::AttributeSet& attributes();
+
+  struct Vertex {
+    float x;
+    float y;
+    float role;
+  };
+};
+
+class PaletteShader final : public QSGMaterialShader {
+public:
+  PaletteShader();
+
+  bool updateUniformData(RenderState& state, QSGMaterial* newMaterial,
+                         QSGMaterial* oldMaterial) override;
+};
+
+// ###################################################################################
+
+/**
+ * @class PaletteTextureMaterial
+ * @brief Tints the alpha of a texture with a palette role or a plain color.
+ *
+ * Meant for coverage masks such as glyphs and text layers: only the alpha of
+ * the texture is used, the color comes from the role's palette entry, or from
+ * the vertex color where the role is negative. Like PaletteMaterial the role
+ * is per vertex, so nodes sampling the same texture batch together whatever
+ * they are tinted with, and follow theme transitions without being touched.
+ */
+class PaletteTextureMaterial final : public QSGMaterial {
+public:
+  PaletteTextureMaterial();
+
+  [[nodiscard]] QSGMaterialType* type() const override;
+  [[nodiscard]] QSGMaterialShader* createShader(
+      QSGRendererInterface::RenderMode renderMode) const override;
+  [[nodiscard]] int compare(const QSGMaterial* other) const override;
+
+  [[nodiscard]] QSGTexture* texture() const { return m_texture; }
+  void setTexture(QSGTexture* texture) { m_texture = texture; }
+
+  /// Position, texture coordinate, palette role and premultiplied color
+  [[nodiscard]] static const QSGGeometry::AttributeSet& attributes();
+
+  struct Vertex {
+    float x;
+    float y;
+    float tx;
+    float ty;
+    float role;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+  };
+
+  /**
+   * @brief Fills a four vertex triangle strip with a tinted quad.
+   *
+   * @param geometry A geometry with attributes() and four vertices.
+   * @param role The ColorRole to tint with, or -1 to tint with @p color.
+   */
+  static void updateRectGeometry(QSGGeometry* geometry, const QRectF& rect,
+                                 const QRectF& sourceRect, int role,
+                                 const QColor& color);
+
+private:
+  QSGTexture* m_texture = nullptr;
+};
+
+class PaletteTextureShader final : public QSGMaterialShader {
+public:
+  PaletteTextureShader();
+
+  bool updateUniformData(RenderState& state, QSGMaterial* newMaterial,
+                         QSGMaterial* oldMaterial) override;
+  void updateSampledImage(RenderState& state, int binding,
+                          QSGTexture** texture, QSGMaterial* newMaterial,
+                          QSGMaterial* oldMaterial) override;
+};
+
+} // namespace UI
@@ -0,0 +1,134 @@
+#include "palettetint.h"
+
+#include <QSGGeometryNode>
+#include <qsgtexture.h>
+
+#include "palette.h"
+#include "palettematerial.h"
+#include "theme.h"
+
+namespace UI {
+
+namespace {
+
+/// Renders a layer that changed before the node samples it
+class TintNode final : public QSGGeometryNode {
+public:
+  TintNode() {
+    auto* geometry = new QSGGeometry(PaletteTextureMaterial::attributes(), 4);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+    setGeometry(geometry);
+    setFlag(OwnsGeometry);
+
+    setMaterial(new PaletteTextureMaterial);
+    setFlag(OwnsMaterial);
+    setFlag(UsePreprocess);
+  }
+
+  [[nodiscard]] PaletteTextureMaterial* tint() const {
+    return static_cast<PaletteTextureMaterial*>(material());
+  }
+
+  void preprocess() override {
+    if (auto* layer = qobject_cast<QSGDynamicTexture*>(tint()->texture())) {
+      layer->updateTexture();
+    }
+  }
+};
+
+} // namespace
+
+PaletteTint::PaletteTint(QQuickItem* parent) : QQuickItem{parent} {
+  setFlag(ItemHasContents, true);
+}
+
+void PaletteTint::setSource(QQuickItem* source) {
+  if (m_source == source) {
+    return;
+  }
+
+  m_source = source;
+  m_geometryDirty = true;
+  emit sourceChanged();
+  update();
+}
+
+void PaletteTint::setPaletteRole(int role) {
+  role = qBound(0, role, static_cast<int>(COLOR_ROLE_COUNT) - 1);
+  if (m_paletteRole == role) {
+    return;
+  }
+
+  m_paletteRole = role;
+  m_geometryDirty = true;
+  emit paletteRoleChanged();
+  update();
+}
+
+void PaletteTint::geometryChange(const QRectF& newGeometry,
+                                 const QRectF& oldGeometry) {
+  if (newGeometry.size() != oldGeometry.size()) {
+    m_geometryDirty = true;
+    update();
+  }
+  QQuickItem::geometryChange(newGeometry, oldGeometry);
+}
+
+void PaletteTint::itemChange(const ItemChange change,
+                             const ItemChangeData& value) {
+  if (change == ItemSceneChange && value.window != nullptr) {
+    Palette::instance().track(value.window);
+  }
+  QQuickItem::itemChange(change, value);
+}
+
+QSGNode* PaletteTint::updatePaintNode(QSGNode* oldNode,
+                                      UpdatePaintNodeData* data) {
+  Q_UNUSED(data)
+
+  // Texture providers can only be asked for on the render thread
+  QSGTextureProvider* provider =
+      m_source != nullptr && m_source->isTextureProvider()
+          ? m_source->textureProvider()
+          : nullptr;
+  if (provider != m_provider) {
+    if (m_provider != nullptr) {
+      disconnect(m_provider, nullptr, this, nullptr);
+    }
+    m_provider = provider;
+    if (provider != nullptr) {
+      connect(provider, &QSGTextureProvider::textureChanged, this,
+              &QQuickItem::update, Qt::QueuedConnection);
+    }
+  }
+
+  QSGTexture* texture = provider != nullptr ? provider->texture() : nullptr;
+  if (texture == nullptr || width() <= 0 || height() <= 0) {
+    delete oldNode;
+    return nullptr;
+  }
+
+  auto* node = static_cast<TintNode*>(oldNode);
+  if (node == nullptr) {
+    node = new TintNode;
+    m_geometryDirty = true;
+  }
+
+  if (node->tint()->texture() != texture) {
+    node->tint()->setTexture(texture);
+    node->markDirty(QSGNode::DirtyMaterial);
+    m_geometryDirty = true;
+  }
+
+  if (m_geometryDirty) {
+    m_geometryDirty = false;
+    PaletteTextureMaterial::updateRectGeometry(
+        node->geometry(), QRectF(0, 0, width(), height()),
+        texture->normalizedTextureSubRect(), m_paletteRole, Qt::white);
+    node->markDirty(QSGNode::DirtyGeometry);
+  }
+
+  return node;
+}
+
+} // namespace UI
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <qpointer.h>
+#include <qqmlintegration.h>
+#include <qquickitem.h>
+#include <qsgtextureprovider.h>
+#include <qtmetamacros.h>
+
+namespace UI {
+
+/**
+ * @class PaletteTint
+ * @brief Draws the coverage of a texture provider in a palette color.
+ *
+ * Meant as a layer.effect: the item is rendered once into its layer and this
+ * fills the layer's alpha with the palette entry of paletteRole on the GPU.
+ * A theme switch then fades the color in the shader without re-rendering the
+ * layer or touching the item, which is what lets text follow transitions.
+ * A layer is a render target of its own, so BaseText only enables it while
+ * ThemePalette.fading. Needs an RHI backend, the software renderer has no
+ * custom materials.
+ *
+ * @property source The texture provider, set by the layer.
+ * @property paletteRole The ColorRole to draw in.
+ */
+class PaletteTint : public QQuickItem {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QQuickItem* source READ source WRITE setSource NOTIFY
+                 sourceChanged)
+  Q_PROPERTY(int paletteRole READ paletteRole WRITE setPaletteRole NOTIFY
+                 paletteRoleChanged)
+
+public:
+  explicit PaletteTint(QQuickItem* parent = nullptr);
+
+  [[nodiscard]] QQuickItem* source() const { return m_source; }
+  void setSource(QQuickItem* source);
+
+  [[nodiscard]] int paletteRole() const { return m_paletteRole; }
+  void setPaletteRole(int role);
+
+  QSGNode* updatePaintNode(QSGNode* oldNode,
+                           UpdatePaintNodeData* data) override;
+
+signals:
+  void sourceChanged();
+  void paletteRoleChanged();
+
+protected:
+  void geometryChange(const QRectF& newGeometry,
+                      const QRectF& oldGeometry) override;
+  void itemChange(ItemChange change, const ItemChangeData& value) override;
+
+private:
+  QPointer<QQuickItem> m_source;
+  /// Connected to from the render thread, only ever compared on it
+  QPointer<QSGTextureProvider> m_provider;
+  int m_paletteRole = 0;
+  bool m_geometryDirty = true;
+};
+
+} // namespace UI
@@ -0,0 +1,21 @@
+#version 440
+
+layout(location = 0) in vec4 vertex;
+layout(location = 1) in float role;
+
+layout(location = 0) out vec4 color;
+
+// Mirrored in palettematerial.cpp, 26 is COLOR_ROLE_COUNT
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    float progress;
+    vec4 from[26];
+    vec4 to[26];
+};
+
+void main() {
+    int index = int(role + 0.5);
+    color = mix(from[index], to[index], progress) * qt_Opacity;
+    gl_Position = qt_Matrix * vertex;
+}
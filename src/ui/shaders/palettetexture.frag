@@ -0,0 +1,13 @@
+#version 440
+
+layout(location = 0) in vec2 texCoord;
+layout(location = 1) in vec4 color;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(binding = 1) uniform sampler2D qt_Texture;
+
+void main() {
+    // Only the coverage of the texture is used, the color is the tint
+    fragColor = color * texture(qt_Texture, texCoord).a;
+}
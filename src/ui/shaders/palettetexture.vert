@@ -0,0 +1,28 @@
+#version 440
+
+layout(location = 0) in vec4 vertex;
+layout(location = 1) in vec2 texCoordIn;
+layout(location = 2) in float role;
+layout(location = 3) in vec4 vertexColor;
+
+layout(location = 0) out vec2 texCoord;
+layout(location = 1) out vec4 color;
+
+// Same block as palette.vert, mirrored in palettematerial.cpp
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    float progress;
+    vec4 from[26];
+    vec4 to[26];
+};
+
+void main() {
+    // A negative role tints with the vertex color instead
+    int index = int(max(role, 0.0) + 0.5);
+    vec4 tint = role < 0.0 ? vertexColor
+                           : mix(from[index], to[index], progress);
+    color = tint * qt_Opacity;
+    texCoord = texCoordIn;
+    gl_Position = qt_Matrix * vertex;
+}
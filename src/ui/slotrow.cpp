@@ -0,0 +1,334 @@
+#include "slotrow.h"
+
+#include <algorithm>
+#include <qmath.h>
+#include <qminmax.h>
+#include <qqml.h>
+
+namespace UI {
+
+namespace {
+
+constexpr qreal kEpsilon = 0.01;
+
+bool sameWidth(const qreal lhs, const qreal rhs) {
+  return qAbs(lhs - rhs) < kEpsilon;
+}
+
+} // namespace
+
+// ####################### SlotRowAttached #######################
+
+SlotRowAttached::SlotRowAttached(QObject* parent) : QObject{parent} {}
+
+void SlotRowAttached::setMinimumWidth(const qreal width) {
+  if (sameWidth(m_minimumWidth, width)) {
+    return;
+  }
+  m_minimumWidth = width;
+  emit minimumWidthChanged();
+  relayout();
+}
+
+void SlotRowAttached::setMaximumWidth(const qreal width) {
+  if (sameWidth(m_maximumWidth, width)) {
+    return;
+  }
+  m_maximumWidth = width;
+  emit maximumWidthChanged();
+  relayout();
+}
+
+void SlotRowAttached::setPreferredWidth(const qreal width) {
+  if (sameWidth(m_preferredWidth, width)) {
+    return;
+  }
+  m_preferredWidth = width;
+  emit preferredWidthChanged();
+  relayout();
+}
+
+void SlotRowAttached::setReservedWidth(const qreal width) {
+  if (sameWidth(m_reservedWidth, width)) {
+    return;
+  }
+  m_reservedWidth = width;
+  emit reservedWidthChanged();
+  relayout();
+}
+
+void SlotRowAttached::relayout() {
+  auto* item = qobject_cast<QQuickItem*>(parent());
+  if (item == nullptr) {
+    return;
+  }
+
+  // Slots live in the row's content item, relayoutSlot() ignores the rest
+  QQuickItem* content = item->parentItem();
+  if (auto* row = content != nullptr
+                      ? qobject_cast<SlotRow*>(content->parentItem())
+                      : nullptr) {
+    row->relayoutSlot(item);
+  }
+}
+
+// ####################### SlotRow #######################
+
+/// Parent of the slots, sitting on the aligned edge of the row
+class SlotRow::Content final : public QQuickItem {
+public:
+  explicit Content(SlotRow* row) : QQuickItem{row}, m_row{row} {}
+
+protected:
+  void itemChange(const ItemChange change,
+                  const ItemChangeData& value) override {
+    if (change == ItemChildAddedChange) {
+      m_row->track(value.item);
+      m_row->layout();
+    } else if (change == ItemChildRemovedChange) {
+      m_row->untrack(value.item);
+      m_row->layout();
+    }
+
+    QQuickItem::itemChange(change, value);
+  }
+
+private:
+  SlotRow* m_row;
+};
+
+SlotRow::SlotRow(QQuickItem* parent)
+    : QQuickItem{parent}, m_content{new Content(this)} {}
+
+SlotRow::~SlotRow() = default;
+
+SlotRowAttached* SlotRow::qmlAttachedProperties(QObject* object) {
+  return new SlotRowAttached(object);
+}
+
+void SlotRow::setSpacing(const qreal spacing) {
+  if (sameWidth(m_spacing, spacing)) {
+    return;
+  }
+  m_spacing = spacing;
+  emit spacingChanged();
+  layout();
+}
+
+qreal SlotRow::maximumSpacing() const {
+  return qMax(m_spacing, m_maximumSpacing);
+}
+
+void SlotRow::setMaximumSpacing(const qreal spacing) {
+  if (sameWidth(m_maximumSpacing, spacing)) {
+    return;
+  }
+  m_maximumSpacing = spacing;
+  emit maximumSpacingChanged();
+  layout();
+}
+
+void SlotRow::setAlignment(const Qt::Alignment alignment) {
+  if (m_alignment == alignment) {
+    return;
+  }
+  m_alignment = alignment;
+  emit alignmentChanged();
+  layout();
+}
+
+QQmlListProperty<QObject> SlotRow::contentData() {
+  return m_content->property("data").value<QQmlListProperty<QObject>>();
+}
+
+void SlotRow::componentComplete() {
+  QQuickItem::componentComplete();
+
+  m_completed = true;
+  layout();
+}
+
+void SlotRow::geometryChange(const QRectF& newGeometry,
+                             const QRectF& oldGeometry) {
+  QQuickItem::geometryChange(newGeometry, oldGeometry);
+
+  // Slots hang off the right edge, which just moved, and take it along
+  if (m_alignment.testFlag(Qt::AlignRight) &&
+      !sameWidth(newGeometry.width(), oldGeometry.width())) {
+    positionContent();
+  }
+
+  if (!sameWidth(newGeometry.height(), oldGeometry.height())) {
+    m_content->setHeight(newGeometry.height());
+    for (const auto& slot : std::as_const(m_slots)) {
+      positionVertically(slot.item);
+    }
+  }
+}
+
+void SlotRow::relayoutSlot(QQuickItem* item) {
+  if (!m_completed) {
+    return;
+  }
+
+  const qsizetype index = indexOf(item);
+  if (index < 0) {
+    return;
+  }
+
+  Slot& slot = m_slots[index];
+  const qreal newWidth = slotWidth(item);
+  item->setWidth(newWidth);
+
+  if (sameWidth(newWidth, slot.width)) {
+    return;
+  }
+
+  const qreal delta = newWidth - slot.width;
+  slot.width = newWidth;
+
+  // A gap only exists when a visible slot follows, let it absorb what it can
+  qreal remaining = delta;
+  if (slot.gapAfter > 0) {
+    const qreal gap =
+        qBound(m_spacing, slot.gapAfter - delta, maximumSpacing());
+    remaining = delta - (slot.gapAfter - gap);
+    slot.gapAfter = gap;
+  }
+
+  // When the gap absorbed everything the slots beyond keep their place and
+  // the row keeps its size
+  positionFrom(index);
+  if (!sameWidth(remaining, 0)) {
+    updateImplicitSize();
+  }
+}
+
+qreal SlotRow::slotWidth(QQuickItem* item) const {
+  if (item == nullptr || !item->isVisible()) {
+    return 0;
+  }
+
+  auto* hints = qobject_cast<SlotRowAttached*>(
+      qmlAttachedPropertiesObject<SlotRow>(item, false));
+  if (hints == nullptr) {
+    return item->implicitWidth();
+  }
+
+  qreal width = hints->preferredWidth() >= 0 ? hints->preferredWidth()
+                                              : item->implicitWidth();
+  width = qMax(width, hints->reservedWidth());
+  width = qMax(width, hints->minimumWidth());
+  if (hints->maximumWidth() >= 0) {
+    width = qMin(width, qMax(hints->maximumWidth(), hints->minimumWidth()));
+  }
+
+  return width;
+}
+
+qsizetype SlotRow::indexOf(const QQuickItem* item) const {
+  for (qsizetype i = 0; i < m_slots.size(); i++) {
+    if (m_slots.at(i).item == item) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void SlotRow::track(QQuickItem* item) {
+  connect(item, &QQuickItem::implicitWidthChanged, this,
+          [this, item]() { relayoutSlot(item); });
+  connect(item, &QQuickItem::implicitHeightChanged, this, [this, item]() {
+    positionVertically(item);
+    updateImplicitSize();
+  });
+  connect(item, &QQuickItem::visibleChanged, this, &SlotRow::layout);
+}
+
+void SlotRow::untrack(QQuickItem* item) {
+  disconnect(item, nullptr, this, nullptr);
+}
+
+void SlotRow::layout() {
+  if (!m_completed) {
+    return;
+  }
+
+  const QList<QQuickItem*> children = m_content->childItems();
+
+  m_slots.clear();
+  m_slots.reserve(children.size());
+
+  for (auto* child : children) {
+    const qreal width = slotWidth(child);
+    child->setWidth(width);
+    m_slots.append({child, width, 0});
+  }
+
+  if (m_alignment.testFlag(Qt::AlignRight)) {
+    std::reverse(m_slots.begin(), m_slots.end());
+  }
+
+  // Gaps only between visible slots
+  Slot* previousVisible = nullptr;
+  for (auto& slot : m_slots) {
+    if (!slot.item->isVisible()) {
+      continue;
+    }
+    if (previousVisible != nullptr) {
+      previousVisible->gapAfter = m_spacing;
+    }
+    previousVisible = &slot;
+  }
+
+  positionContent();
+  positionFrom(0);
+  for (const auto& slot : std::as_const(m_slots)) {
+    positionVertically(slot.item);
+  }
+  updateImplicitSize();
+}
+
+void SlotRow::positionContent() {
+  m_content->setX(m_alignment.testFlag(Qt::AlignRight) ? width() : 0);
+  m_content->setHeight(height());
+}
+
+void SlotRow::positionFrom(const qsizetype index) {
+  qreal offset = 0;
+  for (qsizetype i = 0; i < index; i++) {
+    offset += m_slots.at(i).width + m_slots.at(i).gapAfter;
+  }
+
+  const bool fromRight = m_alignment.testFlag(Qt::AlignRight);
+
+  for (qsizetype i = index; i < m_slots.size(); i++) {
+    const Slot& slot = m_slots.at(i);
+    if (slot.item != nullptr) {
+      slot.item->setX(fromRight ? -offset - slot.width : offset);
+    }
+    offset += slot.width + slot.gapAfter;
+  }
+}
+
+void SlotRow::positionVertically(QQuickItem* item) const {
+  if (item != nullptr) {
+    item->setY(qFloor((height() - item->height()) / 2));
+  }
+}
+
+void SlotRow::updateImplicitSize() {
+  qreal totalWidth = 0;
+  qreal maxHeight = 0;
+
+  for (const auto& slot : std::as_const(m_slots)) {
+    totalWidth += slot.width + slot.gapAfter;
+    if (slot.item != nullptr && slot.item->isVisible()) {
+      maxHeight = qMax(maxHeight, slot.item->implicitHeight());
+    }
+  }
+
+  setImplicitSize(totalWidth, maxHeight);
+}
+
+} // namespace UI
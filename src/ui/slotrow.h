@@ -0,0 +1,168 @@
+#pragma once
+
+#include <qlist.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qqmlintegration.h>
+#include <qqmllist.h>
+#include <qquickitem.h>
+#include <qtmetamacros.h>
+
+namespace UI {
+
+/**
+ * @class SlotRowAttached
+ * @brief Per-widget sizing hints for SlotRow, set as SlotRow.<property>.
+ *
+ * @property minimumWidth Smallest width of the slot.
+ * @property maximumWidth Largest width of the slot, or a negative value for
+ * no limit.
+ * @property preferredWidth Width of the slot when non-negative, otherwise the
+ * widget's implicit width is used.
+ * @property reservedWidth Width kept for the slot even when the widget asks
+ * for less. Reserving the widest expected text means content changes below it
+ * never relayout the row.
+ */
+class SlotRowAttached : public QObject {
+  Q_OBJECT
+  QML_ANONYMOUS
+
+  Q_PROPERTY(qreal minimumWidth READ minimumWidth WRITE setMinimumWidth NOTIFY
+                 minimumWidthChanged)
+  Q_PROPERTY(qreal maximumWidth READ maximumWidth WRITE setMaximumWidth NOTIFY
+                 maximumWidthChanged)
+  Q_PROPERTY(qreal preferredWidth READ preferredWidth WRITE setPreferredWidth
+                 NOTIFY preferredWidthChanged)
+  Q_PROPERTY(qreal reservedWidth READ reservedWidth WRITE setReservedWidth
+                 NOTIFY reservedWidthChanged)
+
+public:
+  explicit SlotRowAttached(QObject* parent);
+
+  [[nodiscard]] qreal minimumWidth() const { return m_minimumWidth; }
+  void setMinimumWidth(qreal width);
+
+  [[nodiscard]] qreal maximumWidth() const { return m_maximumWidth; }
+  void setMaximumWidth(qreal width);
+
+  [[nodiscard]] qreal preferredWidth() const { return m_preferredWidth; }
+  void setPreferredWidth(qreal width);
+
+  [[nodiscard]] qreal reservedWidth() const { return m_reservedWidth; }
+  void setReservedWidth(qreal width);
+
+signals:
+  void minimumWidthChanged();
+  void maximumWidthChanged();
+  void preferredWidthChanged();
+  void reservedWidthChanged();
+
+private:
+  void relayout();
+
+  qreal m_minimumWidth = 0;
+  qreal m_maximumWidth = -1;
+  qreal m_preferredWidth = -1;
+  qreal m_reservedWidth = 0;
+};
+
+/**
+ * @class SlotRow
+ * @brief A horizontal container that lays its children out in fixed slots
+ * and relayouts incrementally.
+ *
+ * Each visible child occupies one slot whose width is derived from its
+ * implicit width and its SlotRow attached hints. When a child's implicit width
+ * changes only that slot is recomputed; if the clamped width is unchanged
+ * nothing else happens. Otherwise the gap on the far side of the slot (away
+ * from the aligned edge) absorbs the difference between @c spacing and
+ * @c maximumSpacing, and only the remainder shifts the slots beyond it.
+ *
+ * Slots are packed against the left or right edge (@c alignment), so with
+ * Qt.AlignRight a change in the first widget never moves the widgets to its
+ * right. Children are kept in an internal content item pinned to that edge
+ * and positioned relative to it, so when the row itself is resized only the
+ * content item moves, not every slot.
+ *
+ * @property spacing Minimum gap between two slots.
+ * @property maximumSpacing Largest a gap may stretch to absorb a shrinking
+ * slot. Equal to spacing by default, which makes gaps rigid.
+ * @property alignment Qt.AlignLeft or Qt.AlignRight.
+ */
+class SlotRow : public QQuickItem {
+  Q_OBJECT
+  QML_ELEMENT
+  QML_ATTACHED(SlotRowAttached)
+  Q_CLASSINFO("DefaultProperty", "contentData")
+
+  Q_PROPERTY(
+      qreal spacing READ spacing WRITE setSpacing NOTIFY spacingChanged)
+  Q_PROPERTY(qreal maximumSpacing READ maximumSpacing WRITE setMaximumSpacing
+                 NOTIFY maximumSpacingChanged)
+  Q_PROPERTY(Qt::Alignment alignment READ alignment WRITE setAlignment NOTIFY
+                 alignmentChanged)
+  Q_PROPERTY(QQmlListProperty<QObject> contentData READ contentData)
+
+public:
+  explicit SlotRow(QQuickItem* parent = nullptr);
+  ~SlotRow() override;
+
+  static SlotRowAttached* qmlAttachedProperties(QObject* object);
+
+  [[nodiscard]] qreal spacing() const { return m_spacing; }
+  void setSpacing(qreal spacing);
+
+  [[nodiscard]] qreal maximumSpacing() const;
+  void setMaximumSpacing(qreal spacing);
+
+  [[nodiscard]] Qt::Alignment alignment() const { return m_alignment; }
+  void setAlignment(Qt::Alignment alignment);
+
+  /// Children declared in QML, items become slots of the content item
+  [[nodiscard]] QQmlListProperty<QObject> contentData();
+
+  /**
+   * @brief Recomputes the slot of @p item and moves only what must move.
+   */
+  void relayoutSlot(QQuickItem* item);
+
+signals:
+  void spacingChanged();
+  void maximumSpacingChanged();
+  void alignmentChanged();
+
+protected:
+  void componentComplete() override;
+  void geometryChange(const QRectF& newGeometry,
+                      const QRectF& oldGeometry) override;
+
+private:
+  class Content;
+
+  struct Slot {
+    QPointer<QQuickItem> item;
+    qreal width = 0;
+    qreal gapAfter = 0; ///< Gap on the far side, away from the aligned edge
+  };
+
+  [[nodiscard]] qreal slotWidth(QQuickItem* item) const;
+  [[nodiscard]] qsizetype indexOf(const QQuickItem* item) const;
+
+  void track(QQuickItem* item);
+  void untrack(QQuickItem* item);
+
+  void layout();
+  void positionContent();
+  void positionFrom(qsizetype index);
+  void positionVertically(QQuickItem* item) const;
+  void updateImplicitSize();
+
+  Content* m_content;
+  QList<Slot> m_slots; ///< In edge order, the first slot touches the edge
+  qreal m_spacing = 0;
+  qreal m_maximumSpacing = -1;
+  Qt::Alignment m_alignment = Qt::AlignLeft;
+  bool m_completed = false;
+};
+
+} // namespace UI
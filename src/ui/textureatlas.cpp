@@ -0,0 +1,156 @@
+#include "textureatlas.h"
+
+#include <qpainter.h>
+
+namespace UI {
+
+namespace {
+
+constexpr qsizetype kMaxHistory = 64;
+
+} // namespace
+
+TextureAtlas::TextureAtlas(const QSize& size, const int padding)
+    : m_image{size, QImage::Format_RGBA8888_Premultiplied},
+      m_padding{padding} {
+  m_image.fill(Qt::transparent);
+}
+
+QRect TextureAtlas::acquire(const uint64_t key, const QImage& image) {
+  if (auto it = m_entries.find(key); it != m_entries.end()) {
+    it->refs++;
+    return it->rect;
+  }
+
+  QRect rect = allocate(image.size());
+  if (rect.isNull()) {
+    repack();
+    rect = allocate(image.size());
+  }
+  if (rect.isNull()) {
+    return {};
+  }
+
+  m_entries.insert(key, {rect, 1});
+  m_sources.insert(key, image);
+  write(rect, image);
+
+  return rect;
+}
+
+void TextureAtlas::release(const uint64_t key) {
+  auto it = m_entries.find(key);
+  if (it == m_entries.end()) {
+    return;
+  }
+
+  if (--it->refs > 0) {
+    return;
+  }
+
+  // Pixels stay until the slot is reused, nobody samples them meanwhile
+  m_freeRects.append(it->rect);
+  m_entries.erase(it);
+  m_sources.remove(key);
+}
+
+QRect TextureAtlas::find(const uint64_t key) const {
+  return m_entries.value(key).rect;
+}
+
+QList<TextureAtlas::Upload>
+TextureAtlas::changesSince(const uint64_t since) const {
+  if (since >= m_generation) {
+    return {};
+  }
+
+  if (since < m_fullSince) {
+    return {{QPoint(0, 0), m_image.copy()}};
+  }
+
+  QList<Upload> uploads;
+  for (const auto& [generation, rect] : m_history) {
+    if (generation > since) {
+      uploads.append({rect.topLeft(), m_image.copy(rect)});
+    }
+  }
+  return uploads;
+}
+
+uint64_t TextureAtlas::contentKey(const QImage& image) {
+  const QImage normalized =
+      image.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+  const QByteArrayView bytes(normalized.constBits(), normalized.sizeInBytes());
+
+  return qHashMulti(0, bytes, normalized.width(), normalized.height());
+}
+
+QRect TextureAtlas::allocate(const QSize& size) {
+  const QSize padded = size + QSize(m_padding, m_padding);
+
+  // Icons mostly come in one size, exact reuse of a freed slot is common
+  for (qsizetype i = 0; i < m_freeRects.size(); i++) {
+    if (m_freeRects.at(i).size() == size) {
+      return m_freeRects.takeAt(i);
+    }
+  }
+
+  for (auto& shelf : m_shelves) {
+    if (padded.height() <= shelf.height &&
+        shelf.nextX + padded.width() <= m_image.width()) {
+      const QRect rect(QPoint(shelf.nextX, shelf.y), size);
+      shelf.nextX += padded.width();
+      return rect;
+    }
+  }
+
+  const int nextY =
+      m_shelves.isEmpty() ? 0 : m_shelves.last().y + m_shelves.last().height;
+  if (nextY + padded.height() > m_image.height() ||
+      padded.width() > m_image.width()) {
+    return {};
+  }
+
+  m_shelves.append({nextY, padded.height(), padded.width()});
+  return {QPoint(0, nextY), size};
+}
+
+void TextureAtlas::write(const QRect& rect, const QImage& image) {
+  QPainter painter(&m_image);
+  painter.setCompositionMode(QPainter::CompositionMode_Source);
+  painter.drawImage(rect.topLeft(), image);
+  painter.end();
+
+  m_generation++;
+  m_history.append({m_generation, rect});
+
+  if (m_history.size() > kMaxHistory) {
+    m_fullSince = m_history.first().first;
+    m_history.removeFirst();
+  }
+}
+
+void TextureAtlas::repack() {
+  m_image.fill(Qt::transparent);
+  m_shelves.clear();
+  m_freeRects.clear();
+  m_history.clear();
+
+  for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+    it->rect = allocate(m_sources.value(it.key()).size());
+    if (it->rect.isNull()) {
+      continue;
+    }
+
+    QPainter painter(&m_image);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(it->rect.topLeft(), m_sources.value(it.key()));
+  }
+
+  // Everything moved, every consumer re-uploads the whole atlas
+  m_generation++;
+  m_layoutGeneration++;
+  m_fullSince = m_generation;
+}
+
+} // namespace UI
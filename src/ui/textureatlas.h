@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <qhash.h>
+#include <qimage.h>
+#include <qlist.h>
+#include <qrect.h>
+
+namespace UI {
+
+/**
+ * @class TextureAtlas
+ * @brief CPU side of a texture atlas shared by many small images.
+ *
+ * Images are packed into one premultiplied RGBA image on shelves and
+ * deduplicated by key (usually contentKey()), with a reference count per key,
+ * so identical icons from different sources occupy one slot. Every write bumps
+ * generation() and is remembered, which lets each GPU-side consumer
+ * (AtlasTexture) re-upload only the regions that changed since it last synced.
+ *
+ * Not thread-safe. Meant to be written on the GUI thread and read by render
+ * threads during the scene graph sync, while the GUI thread is blocked.
+ */
+class TextureAtlas {
+public:
+  struct Upload {
+    QPoint topLeft;
+    QImage image;
+  };
+
+  explicit TextureAtlas(const QSize& size, int padding = 1);
+
+  /**
+   * @brief Adds a reference to @p key, copying @p image in if it is new.
+   * @return The image's rectangle inside the atlas, or a null rect if it does
+   * not fit even after repacking.
+   */
+  QRect acquire(uint64_t key, const QImage& image);
+  void release(uint64_t key);
+
+  [[nodiscard]] QRect find(uint64_t key) const;
+  [[nodiscard]] bool contains(uint64_t key) const {
+    return m_entries.contains(key);
+  }
+
+  [[nodiscard]] QSize size() const { return m_image.size(); }
+  [[nodiscard]] const QImage& image() const { return m_image; }
+  [[nodiscard]] uint64_t generation() const { return m_generation; }
+  /// Bumped whenever a repack moved existing entries
+  [[nodiscard]] uint64_t layoutGeneration() const { return m_layoutGeneration; }
+
+  /**
+   * @brief Copies of every region written after generation @p since.
+   *
+   * Falls back to the whole atlas when @p since is older than the remembered
+   * history (or after a repack moved everything).
+   */
+  [[nodiscard]] QList<Upload> changesSince(uint64_t since) const;
+
+  /// Hash of the pixel data and dimensions, for deduplication
+  [[nodiscard]] static uint64_t contentKey(const QImage& image);
+
+private:
+  struct Entry {
+    QRect rect;
+    int refs = 0;
+  };
+
+  struct Shelf {
+    int y = 0;
+    int height = 0;
+    int nextX = 0;
+  };
+
+  [[nodiscard]] QRect allocate(const QSize& size);
+  void write(const QRect& rect, const QImage& image);
+  void repack();
+
+  QImage m_image;
+  int m_padding;
+
+  QHash<uint64_t, Entry> m_entries;
+  QHash<uint64_t, QImage> m_sources; ///< Kept for repacking
+  QList<Shelf> m_shelves;
+  QList<QRect> m_freeRects;
+
+  uint64_t m_generation = 0;
+  uint64_t m_layoutGeneration = 0;
+  uint64_t m_fullSince = 0; ///< Consumers older than this need everything
+  QList<QPair<uint64_t, QRect>> m_history;
+};
+
+} // namespace UI
@@ -1,11 +1,12 @@
 #include "appview.h"
 #include <memory>
+#include <qquickgraphicsconfiguration.h>
 
 ApplicationView::Builder::Builder()
     : m_name{"nonamed"}, m_layer{LayerShellQt::Window::LayerBottom},
       m_anchor{LayerShellQt::Window::AnchorTop}, m_exclusiveZone{0}, m_width{0},
-      m_height{0}, m_posX{0}, m_posY{0}, m_created{false}, m_sample{4},
-      m_autoShow{false} {}
+      m_height{0}, m_posX{0}, m_posY{0}, m_sample{4}, m_autoShow{false},
+      m_lowMemory{false}, m_created{false} {}
 
 ApplicationView::Builder&
 ApplicationView::Builder::withName(const QString& name) {
@@ -24,13 +25,21 @@ ApplicationView::Builder::withLayer(const LayerShellQt::Window::Layer& layer) {
 }
 
 ApplicationView::Builder& ApplicationView::Builder::withAnchor(
-    const LayerShellQt::Window::Anchor& anchor) {
+    const LayerShellQt::Window::Anchors& anchor) {
   Q_ASSERT(!m_created);
 
   m_anchor = anchor;
   return *this;
 }
 
+ApplicationView::Builder&
+ApplicationView::Builder::withMargins(const QMargins& margins) {
+  Q_ASSERT(!m_created);
+
+  m_margins = margins;
+  return *this;
+}
+
 ApplicationView::Builder&
 ApplicationView::Builder::withExclusiveZone(const int32_t& zone) {
   Q_ASSERT(!m_created);
@@ -87,6 +96,24 @@ ApplicationView::Builder::withShowByDefault(const bool show) {
   return *this;
 }
 
+ApplicationView::Builder&
+ApplicationView::Builder::withLowMemory(const bool lowMemory) {
+  Q_ASSERT(!m_created);
+
+  m_lowMemory = lowMemory;
+  return *this;
+}
+
+ApplicationView::Builder&
+ApplicationView::Builder::withRegion(const QString& component,
+                                     const Qt::Alignment& alignment,
+                                     const int32_t& margin) {
+  Q_ASSERT(!m_created);
+
+  m_regions.append({component, alignment, margin});
+  return *this;
+}
+
 ApplicationViewPtr ApplicationView::Builder::create() {
   Q_ASSERT(!m_created);
 
@@ -94,19 +121,36 @@ ApplicationViewPtr ApplicationView::Builder::create() {
 
   ApplicationViewPtr exclusiveView(new ApplicationView);
 
+  exclusiveView->m_name = m_name;
+
   // Set auto show state
   exclusiveView->m_autoShow = m_autoShow;
 
   // Set format for supersampling
   QSurfaceFormat format = exclusiveView->m_view.format();
   format.setSamples(m_sample);
+
+  // Low memory: the bar is opaque and flat, so skip the alpha channel and the
+  // depth buffer Qt Quick allocates for 2D batching, and keep a double-buffered
+  // swapchain
+  QQuickGraphicsConfiguration graphicsConfig =
+      exclusiveView->m_view.graphicsConfiguration();
+  if (m_lowMemory) {
+    format.setAlphaBufferSize(0);
+    format.setDepthBufferSize(0);
+    format.setSwapBehavior(QSurfaceFormat::DoubleBuffer);
+    graphicsConfig.setDepthBufferFor2D(false);
+  }
+
   exclusiveView->m_view.setFormat(format);
+  exclusiveView->m_view.setGraphicsConfiguration(graphicsConfig);
 
   // Set detail LayerShell
   exclusiveView->m_window = LayerShellQt::Window::get(&exclusiveView->m_view);
 
   exclusiveView->m_window->setLayer(m_layer);
   exclusiveView->m_window->setAnchors(m_anchor);
+  exclusiveView->m_window->setMargins(m_margins);
 
   if (0 != m_exclusiveZone) {
     exclusiveView->m_window->setExclusiveZone(m_exclusiveZone);
@@ -118,11 +162,100 @@ ApplicationViewPtr ApplicationView::Builder::create() {
   // Set geometry for qquickview
   exclusiveView->m_view.setGeometry(m_posX, m_posY, m_width, m_height);
 
+  // Child windows for regions, sharing the parent's QML engine so context
+  // properties set on the view are visible to them too
+  QQuickView* parentView = &exclusiveView->m_view;
+  for (const auto& region : m_regions) {
+    auto* regionView = new QQuickView(parentView->engine(), parentView);
+    regionView->setFormat(format);
+    regionView->setGraphicsConfiguration(graphicsConfig);
+    regionView->setResizeMode(QQuickView::SizeViewToRootObject);
+    regionView->setColor(parentView->color());
+
+    QObject::connect(parentView, &QQuickWindow::colorChanged, regionView,
+                     &QQuickWindow::setColor);
+
+    exclusiveView->m_regionViews.append(regionView);
+  }
+  exclusiveView->m_regions = m_regions;
+
   return exclusiveView;
 }
 
 // #################################################################
 
+ApplicationView::~ApplicationView() {
+  // Child windows would only go with m_view, after its engine is gone
+  qDeleteAll(m_regionViews);
+  m_regionViews.clear();
+}
+
+void ApplicationView::loadFromModule(const QString& uri,
+                                     const QString& typeName) {
+  m_view.loadFromModule(uri, typeName);
+
+  for (qsizetype i = 0; i < m_regionViews.size(); i++) {
+    QQuickView* regionView = m_regionViews.at(i);
+    const Region region = m_regions.at(i);
+
+    regionView->loadFromModule(uri, region.component);
+
+    auto reposition = [this, regionView, region]() {
+      placeRegion(regionView, region);
+    };
+
+    QObject::connect(regionView, &QWindow::widthChanged, regionView,
+                     reposition);
+    QObject::connect(regionView, &QWindow::heightChanged, regionView,
+                     reposition);
+    QObject::connect(&m_view, &QWindow::widthChanged, regionView, reposition);
+    QObject::connect(&m_view, &QWindow::heightChanged, regionView,
+                     reposition);
+
+    placeRegion(regionView, region);
+  }
+}
+
+void ApplicationView::show() {
+  m_view.show();
+
+  for (auto* regionView : std::as_const(m_regionViews)) {
+    regionView->show();
+  }
+}
+
+void ApplicationView::placeRegion(QQuickView* regionView,
+                                  const Region& region) {
+  const int parentWidth = m_view.width();
+  const int parentHeight = m_view.height();
+  const int width = regionView->width();
+  const int height = regionView->height();
+
+  int posX = region.margin;
+  if (region.alignment.testFlag(Qt::AlignRight)) {
+    posX = parentWidth - width - region.margin;
+  } else if (region.alignment.testFlag(Qt::AlignHCenter)) {
+    posX = (parentWidth - width) / 2;
+  }
+
+  int posY = (parentHeight - height) / 2;
+  if (region.alignment.testFlag(Qt::AlignTop)) {
+    posY = 0;
+  } else if (region.alignment.testFlag(Qt::AlignBottom)) {
+    posY = parentHeight - height;
+  }
+
+  regionView->setPosition(posX, posY);
+}
+
+void ApplicationView::resize(const int32_t width, const int32_t height) {
+  if (m_window->exclusionZone() > 0) {
+    m_window->setExclusiveZone(height);
+  }
+
+  m_view.resize(width, height);
+}
+
 QQuickView& ApplicationView::asView() {
   Q_ASSERT(m_window != nullptr);
 
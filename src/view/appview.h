@@ -2,11 +2,26 @@
 
 #include <LayerShellQt/window.h>
 #include <memory>
+#include <qlist.h>
+#include <qmargins.h>
+#include <qnamespace.h>
 #include <qquickview.h>
 #include <qtclasshelpermacros.h>
 
 class ApplicationView {
 public:
+  /**
+   * A QML component hosted in its own child window. On Wayland every child
+   * window is a desynchronized subsurface with its own swapchain, so a change
+   * inside a region only re-renders and damages the region's pixels instead
+   * of the whole bar.
+   */
+  struct Region {
+    QString component;
+    Qt::Alignment alignment;
+    int32_t margin;
+  };
+
   class Builder {
     Q_DISABLE_COPY(Builder)
 
@@ -15,7 +30,9 @@ public:
 
     Builder& withName(const QString& name);
     Builder& withLayer(const LayerShellQt::Window::Layer& layer);
-    Builder& withAnchor(const LayerShellQt::Window::Anchor& anchor);
+    Builder& withAnchor(const LayerShellQt::Window::Anchors& anchor);
+    /// Distance to the anchored edges
+    Builder& withMargins(const QMargins& margins);
     Builder& withExclusiveZone(const int32_t& zone);
     Builder& withWidth(const int32_t& width);
     Builder& withHeight(const int32_t& height);
@@ -23,13 +40,17 @@ public:
     Builder& withPositionY(const int32_t& posY);
     Builder& withSample(const int32_t& sample);
     Builder& withShowByDefault(bool show);
+    Builder& withLowMemory(bool lowMemory);
+    Builder& withRegion(const QString& component,
+                        const Qt::Alignment& alignment, const int32_t& margin);
 
     std::shared_ptr<ApplicationView> create();
 
   private:
     QString m_name;
     LayerShellQt::Window::Layer m_layer;
-    LayerShellQt::Window::Anchor m_anchor;
+    LayerShellQt::Window::Anchors m_anchor;
+    QMargins m_margins;
     int32_t m_exclusiveZone;
     int32_t m_width;
     int32_t m_height;
@@ -38,20 +59,45 @@ public:
     int32_t m_sample;
 
     bool m_autoShow;
+    bool m_lowMemory;
+
+    QList<Region> m_regions;
 
     bool m_created;
   };
 
+  /// Deletes the region views while the engine they share is still alive
+  ~ApplicationView();
+
+  /**
+   * Loads @p typeName into the view, then every region component from the
+   * same module into its child window.
+   */
+  void loadFromModule(const QString& uri, const QString& typeName);
+  void show();
+  /// Resizes the surface, the exclusive zone follows the height
+  void resize(int32_t width, int32_t height);
+
   QQuickView& asView();
+  [[nodiscard]] const QList<QQuickView*>& regionViews() const {
+    return m_regionViews;
+  }
+  [[nodiscard]] const QList<Region>& regions() const { return m_regions; }
   [[nodiscard]] const QString& name() const { return m_name; }
   [[nodiscard]] bool autoShow() const { return m_autoShow; }
 
 private:
   ApplicationView() = default;
 
+  void placeRegion(QQuickView* regionView, const Region& region);
+
   QQuickView m_view;
   LayerShellQt::Window* m_window = nullptr;
 
+  // Child windows of m_view using its engine, deleted before m_view
+  QList<QQuickView*> m_regionViews;
+  QList<Region> m_regions;
+
   QString m_name;
   bool m_autoShow;
   friend class Builder;
@@ -0,0 +1,22 @@
+import QtQuick
+import Simbar
+
+Item {
+    id: root
+    implicitWidth: title.implicitWidth
+    implicitHeight: SimbarConfig.qmlDefaultBoxSize
+
+    // Elision happens (and is cached per width) in the model
+    Binding {
+        target: titleModel
+        property: "elideWidth"
+        value: SimbarConfig.qmlTitleMaxWidth
+    }
+
+    BaseText {
+        id: title
+        anchors.centerIn: parent
+        font.pixelSize: SimbarConfig.qmlDefaultFontSize
+        text: titleModel.elidedTitle
+    }
+}
@@ -0,0 +1,32 @@
+import QtQuick
+import Simbar
+
+Row {
+    id: root
+    spacing: 6
+
+    Repeater {
+        model: workspaceModel
+
+        FlexRectangle {
+            id: workspace
+            required property string name
+            required property bool focused
+            required property bool urgent
+
+            width: Math.max(SimbarConfig.qmlDefaultBoxSize, label.implicitWidth + 2 * SimbarConfig.qmlDefaultPadding)
+            height: SimbarConfig.qmlDefaultBoxSize
+            radius: [8, 8, 8, 8]
+            paletteRole: workspace.urgent ? ColorRole.Red : workspace.focused ? ColorRole.Mauve : ColorRole.Surface0
+
+            BaseText {
+                id: label
+                anchors.centerIn: parent
+                font.pixelSize: SimbarConfig.qmlDefaultFontSize
+                font.bold: true
+                paletteRole: workspace.focused || workspace.urgent ? ColorRole.Base : ColorRole.Text
+                text: workspace.name
+            }
+        }
+    }
+}
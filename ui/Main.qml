@@ -6,15 +6,37 @@ Item {
     width: SimbarConfig.qmlWidth
     height: SimbarConfig.qmlHeight
 
-    Rectangle {
+    FlexRectangle {
         anchors.fill: parent
-        color: SimbarConfig.themeCrust
+        radius: [0]
+        paletteRole: ColorRole.Crust
+        // With split regions the window clear color is the background
+        visible: !SimbarConfig.splitRegions
     }
 
-    RightRegion {
+    // With split regions every region lives in its own subsurface
+    Loader {
+        id: left_widgets
+        active: !SimbarConfig.splitRegions
+        anchors.verticalCenter: parent.verticalCenter
+        anchors.left: parent.left
+        anchors.leftMargin: SimbarConfig.qmlDefaultPadding
+        sourceComponent: LeftRegion {}
+    }
+
+    Loader {
+        id: center_widgets
+        active: !SimbarConfig.splitRegions
+        anchors.centerIn: parent
+        sourceComponent: CenterRegion {}
+    }
+
+    Loader {
         id: right_widgets
+        active: !SimbarConfig.splitRegions
         anchors.verticalCenter: parent.verticalCenter
         anchors.right: parent.right
         anchors.rightMargin: SimbarConfig.qmlDefaultPadding
+        sourceComponent: RightRegion {}
     }
 }
@@ -0,0 +1,92 @@
+import QtQuick
+import Simbar
+
+// Root of the pooled notification popup. The engine sizes the surface to
+// the toasts and hides it while notifyModel is empty, so one window and one
+// delegate per visible toast serve every notification.
+Column {
+    id: root
+    width: SimbarConfig.qmlNotifyWidth
+    spacing: SimbarConfig.qmlDefaultPadding
+
+    Repeater {
+        model: notifyModel
+
+        FlexRectangle {
+            id: toast
+            required property int notificationId
+            required property string appName
+            required property string summary
+            required property string body
+            required property var actions
+            required property bool critical
+            required property int count
+            required property string imageSource
+
+            width: root.width
+            height: SimbarConfig.qmlNotifyHeight
+            radius: [8, 8, 8, 8]
+            paletteRole: ColorRole.Base
+
+            FlexRectangle {
+                id: accent
+                width: 4
+                height: parent.height
+                radius: [8, 0, 0, 8]
+                paletteRole: toast.critical ? ColorRole.Red : ColorRole.Blue
+            }
+
+            Image {
+                id: image
+                x: accent.width + SimbarConfig.qmlDefaultPadding
+                width: toast.imageSource !== "" ? SimbarConfig.qmlNotifyHeight - 2 * SimbarConfig.qmlDefaultPadding : 0
+                height: width
+                anchors.verticalCenter: parent.verticalCenter
+                source: toast.imageSource
+                fillMode: Image.PreserveAspectFit
+                cache: false
+            }
+
+            Column {
+                anchors.left: image.right
+                anchors.leftMargin: SimbarConfig.qmlDefaultPadding
+                anchors.right: parent.right
+                anchors.rightMargin: SimbarConfig.qmlDefaultPadding
+                anchors.verticalCenter: parent.verticalCenter
+                spacing: 2
+
+                BaseText {
+                    width: parent.width
+                    font.pixelSize: SimbarConfig.qmlDefaultFontSize
+                    font.bold: true
+                    elide: Text.ElideRight
+                    text: toast.count > 1 ? toast.summary + " (" + toast.count + ")" : toast.summary
+                }
+
+                BaseText {
+                    width: parent.width
+                    font.pixelSize: SimbarConfig.qmlDefaultFontSize - 2
+                    paletteRole: ColorRole.Subtext0
+                    elide: Text.ElideRight
+                    maximumLineCount: 2
+                    wrapMode: Text.Wrap
+                    textFormat: Text.PlainText
+                    text: toast.body
+                    visible: text !== ""
+                }
+            }
+
+            MouseArea {
+                anchors.fill: parent
+                acceptedButtons: Qt.LeftButton | Qt.RightButton
+                onClicked: mouse => {
+                    if (mouse.button === Qt.LeftButton && toast.actions.indexOf("default") % 2 === 0) {
+                        notifyModel.invokeAction(toast.notificationId, "default");
+                    } else {
+                        notifyModel.dismiss(toast.notificationId);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -1,22 +1,37 @@
 import QtQuick
 import Simbar
 
-Row {
+SlotRow {
     id: root
     spacing: 10
+    alignment: Qt.AlignRight
+
+    TrayView {
+        id: tray
+        host: trayHost
+        iconSize: SimbarConfig.qmlTrayIconSize
+        spacing: 6
+        visible: implicitWidth > 0
+    }
+
+    MediaWidget {
+        id: media
+        objectName: "media"
+    }
 
     TextBaseWidget {
         id: bluetooth
+        objectName: "bluetooth"
         iconText: "󰂲"
-        iconBoxColor: SimbarConfig.themeRed
-        contentTextColor: iconBoxColor
+        iconBoxRole: ColorRole.Red
     }
 
     TextBaseWidget {
         id: wifi
+        objectName: "wifi"
         iconText: "󰖩"
         clickable: true
-        iconBoxColor: contentText === "" ? SimbarConfig.themeRed : SimbarConfig.themeGreen
+        iconBoxRole: contentText === "" ? ColorRole.Red : ColorRole.Green
         onClicked: {
             wifi.updateText(contentText !== "" ? "" : "OpenWrt_Home");
         }
@@ -26,14 +41,54 @@ Row {
         }
     }
 
+    TextBaseWidget {
+        id: backlight
+        objectName: "backlight"
+        visible: backlightModel.present
+        iconText: "󰃠"
+        iconBoxRole: ColorRole.Yellow
+
+        Connections {
+            target: backlightModel
+            function onPercentChanged() {
+                backlight.instantUpdateText(backlightModel.percent + "%");
+            }
+        }
+
+        Component.onCompleted: {
+            backlight.instantUpdateText(backlightModel.percent + "%");
+        }
+    }
+
+    TextBaseWidget {
+        id: battery
+        objectName: "battery"
+        visible: batteryModel.present
+        readonly property var levelIcons: ["󰂎", "󰁺", "󰁻", "󰁼", "󰁽", "󰁾", "󰁿", "󰂀", "󰂁", "󰂂", "󰁹"]
+        iconText: batteryModel.charging ? "󰂄" : levelIcons[Math.round(batteryModel.percent / 10)]
+        iconBoxRole: batteryModel.onAc ? ColorRole.Green : batteryModel.percent <= 15 ? ColorRole.Red : ColorRole.Peach
+
+        Connections {
+            target: batteryModel
+            function onPercentChanged() {
+                battery.instantUpdateText(batteryModel.percent + "%");
+            }
+        }
+
+        Component.onCompleted: {
+            battery.instantUpdateText(batteryModel.percent + "%");
+        }
+    }
+
     TextBaseWidget {
         id: dateTime
+        objectName: "dateTime"
         iconText: "󰸗"
-        iconBoxColor: SimbarConfig.themeMauve
+        iconBoxRole: ColorRole.Mauve
         contentPaddingRight: 10
 
         Timer {
-            interval: 2000
+            interval: 2000 * RenderPolicy.pollScale
             running: true
             repeat: true
             onTriggered: {
@@ -5,13 +5,27 @@ BaseText {
     id: root
 
     property int duration: 300
+    // Scaled down or to nothing while RenderPolicy saves power
+    readonly property int effectiveDuration: Math.round(root.duration * RenderPolicy.scrambleScale)
     property var contentCached: [] // cache all state of text
 
+    // Width layouts should reserve for this text. Pinned to the wider of the
+    // current and target text while scrambling, so the intermediate strings
+    // never change it and never trigger a relayout.
+    property real layoutWidth: implicitWidth
+
+    TextMetrics {
+        id: targetMetrics
+        font: root.font
+    }
+
     QtObject {
         id: self
         property int updateInterval: 50
         property int cachedIndex: 0
-        readonly property int maxStep: 10
+        // Fewer steps under the policy's frame rate cap, so no step is
+        // shorter than one capped frame
+        readonly property int maxStep: RenderPolicy.animationFps > 0 ? Math.max(1, Math.min(10, Math.floor(root.effectiveDuration * RenderPolicy.animationFps / 1000))) : 10
 
         function createTextState(currentText, targetText) {
             root.contentCached = [currentText]
@@ -24,7 +38,7 @@ BaseText {
             var diffStep = Math.ceil(diffSize / Math.min(diffSize, maxStep))
 
             self.updateInterval = Math.floor(
-                        root.duration / (diffSize / diffStep))
+                        root.effectiveDuration / (diffSize / diffStep))
 
             var i = 0
 
@@ -68,17 +82,21 @@ BaseText {
             self.cachedIndex = 0
             self.updateInterval = 50
             running = false
+            root.layoutWidth = Qt.binding(() => root.implicitWidth)
         }
     }
 
     function updateText(newText) {
         textUpdateTimer.stop()
 
-        if (newText === root.text) {
+        if (newText === root.text || root.effectiveDuration <= 0) {
+            root.text = newText
+            root.layoutWidth = Qt.binding(() => root.implicitWidth)
             return
         }
 
-        var step = Math.floor(root.duration / self.updateInterval)
+        targetMetrics.text = newText
+        root.layoutWidth = Math.max(root.implicitWidth, Math.ceil(targetMetrics.advanceWidth))
 
         self.createTextState(root.text, newText)
 
@@ -86,6 +104,8 @@ BaseText {
     }
 
     function instantUpdateText(newText) {
+        textUpdateTimer.stop()
         root.text = newText
+        root.layoutWidth = Qt.binding(() => root.implicitWidth)
     }
 }
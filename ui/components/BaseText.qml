@@ -4,5 +4,23 @@ import Simbar
 Text {
     id: root
     font.family: SimbarConfig.qmlDefaultFontFamily
-    color: SimbarConfig.themeText
+
+    // Palette entry the text is drawn in, cross-fades on theme switches.
+    // -1 to draw in plainColor instead
+    property int paletteRole: ColorRole.Text
+    property color plainColor: "white"
+
+    // Outside a theme fade the text is drawn in the config color like any
+    // other Text, batched and without a render target of its own. Only while
+    // the palette fades is it rendered into a layer that PaletteTint fills
+    // with the role's color in the shader. The software renderer has no
+    // custom materials and always takes the color from the config.
+    readonly property bool paletteTinted: root.paletteRole >= 0 && ThemePalette.fading && GraphicsInfo.api !== GraphicsInfo.Software
+
+    color: root.paletteRole < 0 ? root.plainColor : root.paletteTinted ? "white" : SimbarConfig.themeColors[root.paletteRole]
+
+    layer.enabled: root.paletteTinted
+    layer.effect: PaletteTint {
+        paletteRole: root.paletteRole
+    }
 }
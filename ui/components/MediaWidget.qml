@@ -0,0 +1,107 @@
+import QtQuick
+import Simbar
+
+// Now playing from mediaModel. The progress bar is one NumberAnimation from
+// the last reported position to the end of the track, run by the window's
+// animation clock. It is restarted only when the player reports a position
+// (seek, pause, rate or track change), never polled. While RenderPolicy caps
+// the frame rate a timer steps the bar at that rate instead.
+TextBaseWidget {
+    id: root
+
+    property double progress: 0
+
+    visible: mediaModel.present && mediaModel.title !== ""
+    clickable: true
+    iconText: mediaModel.playing ? "󰏤" : "󰐊"
+    iconBoxRole: ColorRole.Lavender
+    reservedContentWidth: 160
+    onClicked: mediaModel.playPause()
+
+    Image {
+        width: root.iconBoxWidth
+        height: root.widgetHeight
+        anchors.verticalCenter: parent.verticalCenter
+        source: mediaModel.artSource
+        // Covers the play state icon while there is art
+        visible: status === Image.Ready
+        fillMode: Image.PreserveAspectCrop
+        cache: false
+    }
+
+    // Scaled rather than resized, an animation frame only updates a
+    // transform instead of regenerating the geometry
+    FlexRectangle {
+        x: root.iconBoxWidth
+        width: root.width - root.iconBoxWidth
+        height: 2
+        transform: Scale {
+            xScale: root.progress
+        }
+        anchors.bottom: parent.bottom
+        radius: [0, 0, 0, 0]
+        paletteRole: ColorRole.Lavender
+        visible: mediaModel.length > 0
+    }
+
+    NumberAnimation {
+        id: progressAnimation
+        target: root
+        property: "progress"
+        to: 1
+    }
+
+    function trackText() {
+        return mediaModel.artist !== "" ? mediaModel.artist + " - " + mediaModel.title : mediaModel.title;
+    }
+
+    Timer {
+        id: progressStep
+        interval: RenderPolicy.animationFps > 0 ? Math.ceil(1000 / RenderPolicy.animationFps) : 1000
+        repeat: true
+        onTriggered: {
+            root.progress = mediaModel.position() / mediaModel.length;
+        }
+    }
+
+    Connections {
+        target: RenderPolicy
+        function onPolicyChanged() {
+            root.restartProgress();
+        }
+    }
+
+    function restartProgress() {
+        progressAnimation.stop();
+        progressStep.stop();
+        const length = mediaModel.length;
+        const position = mediaModel.position();
+        root.progress = length > 0 ? position / length : 0;
+        if (!mediaModel.playing || length <= 0 || mediaModel.rate <= 0) {
+            return;
+        }
+        if (RenderPolicy.animationFps > 0) {
+            progressStep.start();
+        } else {
+            progressAnimation.from = root.progress;
+            progressAnimation.duration = (length - position) / mediaModel.rate;
+            progressAnimation.start();
+        }
+    }
+
+    Connections {
+        target: mediaModel
+        function onPositionAnchored() {
+            root.restartProgress();
+        }
+        function onTrackChanged() {
+            root.updateText(root.trackText());
+            root.restartProgress();
+        }
+    }
+
+    Component.onCompleted: {
+        root.instantUpdateText(root.trackText());
+        root.restartProgress();
+    }
+}
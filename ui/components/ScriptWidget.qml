@@ -0,0 +1,27 @@
+import QtQuick
+import Simbar
+
+// A TextBaseWidget fed by a long-running script, for example:
+//
+//     ScriptWidget {
+//         iconText: "󰍛"
+//         command: ["sh", "-c", "while :; do free -h | awk '/Mem/{print $3}'; sleep 5; done"]
+//     }
+//
+// The script is started once and restarted with backoff if it dies. Print a
+// line of text, or a JSON object with "text", "color" and "visible".
+TextBaseWidget {
+    id: root
+
+    property alias command: source.command
+    readonly property bool running: source.running
+
+    iconBoxRole: source.hasColor ? -1 : ColorRole.Blue
+    iconBoxColor: source.color
+    visible: source.visible
+
+    ScriptModel {
+        id: source
+        onTextChanged: root.updateText(text)
+    }
+}
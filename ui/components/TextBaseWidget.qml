@@ -1,40 +1,59 @@
 pragma ComponentBehavior
 
 import QtQuick
-import QtQuick.Layouts
 import Simbar
 
-RowLayout {
+// Plain Item with explicit geometry instead of a RowLayout: a content change
+// only updates contentBox and this item's implicitWidth, the enclosing SlotRow
+// then decides what else has to move.
+Item {
     id: root
     property double widgetHeight: SimbarConfig.qmlDefaultBoxSize
 
+    // Palette entries the boxes, the icon and the text are drawn in. They
+    // cross-fade on theme switches; a role of -1 draws in the matching color
+    // property instead, which is otherwise unused.
     property double iconBoxWidth: SimbarConfig.qmlDefaultBoxSize
-    property color iconBoxColor: SimbarConfig.themeBlue
+    property int iconBoxRole: ColorRole.Blue
+    property color iconBoxColor: "white"
     property string iconText: ""
-    property color iconTextColor: SimbarConfig.themeBase
+    property int iconTextRole: ColorRole.Base
+    property color iconTextColor: "white"
 
     property double contentPaddingLeft: SimbarConfig.qmlDefaultPadding
     property double contentPaddingRight: SimbarConfig.qmlDefaultPadding
-    property color contentBoxColor: SimbarConfig.themeBase
+    property int contentBoxRole: ColorRole.Base
+    property color contentBoxColor: "white"
     readonly property string contentText: content.text
+    property int contentTextRole: iconBoxRole
     property color contentTextColor: iconBoxColor
 
+    // Width the content box never shrinks below, reserve the widest expected
+    // text here to keep content changes from resizing the widget at all
+    property double reservedContentWidth: 0
+    readonly property double contentMinimumWidth: Math.max(root.reservedContentWidth, root.contentPaddingLeft + content.layoutWidth + root.contentPaddingRight)
+
     property bool clickable: false
     signal clicked
 
-    spacing: 0
+    implicitWidth: iconBox.width + (contentBox.visible ? root.contentMinimumWidth : 0)
+    implicitHeight: root.widgetHeight
 
     FlexRectangle {
         id: iconBox
-        Layout.preferredWidth: root.iconBoxWidth
-        Layout.preferredHeight: root.widgetHeight
+        width: root.iconBoxWidth
+        height: root.widgetHeight
+        anchors.verticalCenter: parent.verticalCenter
         radius: contentBox.visible ? [8, 0, 0, 8] : [8, 8, 8, 8]
+        paletteRole: root.iconBoxRole
         color: root.iconBoxColor
 
-        BaseText {
+        IconGlyph {
             id: icon
             anchors.centerIn: parent
-            font.pixelSize: SimbarConfig.qmlDefaultIconSize
+            family: SimbarConfig.qmlDefaultFontFamily
+            pixelSize: SimbarConfig.qmlDefaultIconSize
+            paletteRole: root.iconTextRole
             color: root.iconTextColor
             text: root.iconText
         }
@@ -50,10 +69,12 @@ RowLayout {
 
     FlexRectangle {
         id: contentBox
-        Layout.fillWidth: true
-        Layout.minimumWidth: root.contentPaddingLeft + content.implicitWidth + root.contentPaddingRight
-        Layout.preferredHeight: root.widgetHeight
+        x: iconBox.width
+        width: Math.max(root.width - iconBox.width, root.contentMinimumWidth)
+        height: root.widgetHeight
+        anchors.verticalCenter: parent.verticalCenter
         radius: [0, 8, 8, 0]
+        paletteRole: root.contentBoxRole
         color: root.contentBoxColor
         visible: root.contentText !== ""
 
@@ -65,7 +86,8 @@ RowLayout {
 
             font.pixelSize: SimbarConfig.qmlDefaultFontSize
             font.bold: true
-            color: root.contentTextColor
+            paletteRole: root.contentTextRole
+            plainColor: root.contentTextColor
 
             duration: 200
         }